@@ -0,0 +1,192 @@
+//-------------------------------------------------------------------
+//  MetaInfo Framework (MIF)
+//  https://github.com/tdv/mif
+//  Created:     10.2026
+//  Copyright (C) 2016-2024 tdv
+//-------------------------------------------------------------------
+
+// STD
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+// BOOST
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/string.hpp>
+
+// MIF
+#include <mif/common/types.h>
+#include <mif/remote/serialization/boost.h>
+
+// Compares the boost binary serializer of the remote calls with the plain boost archive:
+// both have to give the same bytes, then the time of a serialize+deserialize round trip
+// of a call with five parameters is measured for both.
+
+namespace
+{
+
+    namespace Tag = Mif::Remote::Serialization::Detail::Tag;
+
+    using Serializer = Mif::Remote::Serialization::Boost::Serializer<boost::archive::binary_oarchive>;
+    using Deserializer = Mif::Remote::Serialization::Boost::Deserializer<boost::archive::binary_iarchive>;
+
+    std::string const Uuid = "4a1e7c3c-9f6b-4b8e-8a51-0c53c5a1d2f7";
+    std::string const Instance = "12";
+    std::string const Interface = "ICounter";
+    std::string const Method = "Five";
+    std::int64_t const Deadline = 1234567;
+
+    using Params = std::tuple<int, std::string, double, long long, std::string>;
+
+    Params MakeParams(int index)
+    {
+        return Params{index, "some string parameter", 2.5, 4LL, "e"};
+    }
+
+    // The message written by the archive with the same fields as the serializer writes.
+    Mif::Common::Buffer SaveByArchive(Params const &params)
+    {
+        std::ostringstream stream;
+
+        {
+            boost::archive::binary_oarchive archive{stream};
+
+            std::string type = Tag::Request::Value;
+            std::uint32_t createService = 0;
+            std::string createInterface;
+            bool hasException = false;
+
+            archive << boost::serialization::make_nvp(Tag::Uuid::Value, Uuid);
+            archive << boost::serialization::make_nvp(Tag::Type::Value, type);
+            archive << boost::serialization::make_nvp(Tag::Instsnce::Value, Instance);
+            archive << boost::serialization::make_nvp(Tag::Interface::Value, Interface);
+            archive << boost::serialization::make_nvp(Tag::Method::Value, Method);
+            archive << boost::serialization::make_nvp(Tag::Deadline::Value, Deadline);
+            archive << boost::serialization::make_nvp(Tag::CreateService::Value, createService);
+            archive << boost::serialization::make_nvp(Tag::CreateInterface::Value, createInterface);
+            archive << boost::serialization::make_nvp("has_exception", hasException);
+
+            // The serializer saves the parameters from the last one.
+            archive << boost::serialization::make_nvp("param4", std::get<4>(params));
+            archive << boost::serialization::make_nvp("param3", std::get<3>(params));
+            archive << boost::serialization::make_nvp("param2", std::get<2>(params));
+            archive << boost::serialization::make_nvp("param1", std::get<1>(params));
+            archive << boost::serialization::make_nvp("param0", std::get<0>(params));
+        }
+
+        auto const data = stream.str();
+        return {std::begin(data), std::end(data)};
+    }
+
+    Params LoadByArchive(Mif::Common::Buffer const &buffer)
+    {
+        std::istringstream stream{std::string{std::begin(buffer), std::end(buffer)}};
+        boost::archive::binary_iarchive archive{stream};
+
+        std::string uuid;
+        std::string type;
+        std::string instance;
+        std::string interface;
+        std::string method;
+        std::int64_t deadline = 0;
+        std::uint32_t createService = 0;
+        std::string createInterface;
+        bool hasException = false;
+
+        archive >> boost::serialization::make_nvp(Tag::Uuid::Value, uuid);
+        archive >> boost::serialization::make_nvp(Tag::Type::Value, type);
+        archive >> boost::serialization::make_nvp(Tag::Instsnce::Value, instance);
+        archive >> boost::serialization::make_nvp(Tag::Interface::Value, interface);
+        archive >> boost::serialization::make_nvp(Tag::Method::Value, method);
+        archive >> boost::serialization::make_nvp(Tag::Deadline::Value, deadline);
+        archive >> boost::serialization::make_nvp(Tag::CreateService::Value, createService);
+        archive >> boost::serialization::make_nvp(Tag::CreateInterface::Value, createInterface);
+        archive >> boost::serialization::make_nvp("has_exception", hasException);
+
+        Params params;
+        archive >> boost::serialization::make_nvp("param4", std::get<4>(params));
+        archive >> boost::serialization::make_nvp("param3", std::get<3>(params));
+        archive >> boost::serialization::make_nvp("param2", std::get<2>(params));
+        archive >> boost::serialization::make_nvp("param1", std::get<1>(params));
+        archive >> boost::serialization::make_nvp("param0", std::get<0>(params));
+        return params;
+    }
+
+    Mif::Common::Buffer SaveBySerializer(Params const &params)
+    {
+        Serializer serializer{true, Uuid, Instance, Interface, Method,
+                std::get<0>(params), std::get<1>(params), std::get<2>(params),
+                std::get<3>(params), std::get<4>(params)};
+        serializer.SetDeadline(Deadline);
+        return serializer.GetBuffer();
+    }
+
+    Params LoadBySerializer(Mif::Common::Buffer buffer)
+    {
+        Deserializer deserializer{std::move(buffer)};
+        return deserializer.GetParams<int, std::string, double, long long, std::string>();
+    }
+
+    template <typename TSave, typename TLoad>
+    double Measure(TSave save, TLoad load, int count)
+    {
+        long long sum = 0;
+        auto const start = std::chrono::steady_clock::now();
+        for (int i = 0 ; i < count ; ++i)
+            sum += std::get<0>(load(save(MakeParams(i))));
+        auto const time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count();
+        if (sum != static_cast<long long>(count) * (count - 1) / 2)
+            throw std::runtime_error{"Bad round trip."};
+        return static_cast<double>(time) / count;
+    }
+
+}   // namespace
+
+int main()
+{
+    try
+    {
+        auto const params = MakeParams(42);
+
+        auto const byArchive = SaveByArchive(params);
+        auto const bySerializer = SaveBySerializer(params);
+
+        if (byArchive != bySerializer)
+        {
+            std::cerr << "The serializer and the boost archive give different data." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        if (LoadBySerializer(byArchive) != params || LoadByArchive(bySerializer) != params)
+        {
+            std::cerr << "The data is not read back by the other side." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::cout << "The serializer and the boost archive give the same "
+                  << bySerializer.size() << " bytes." << std::endl;
+
+        int const count = 200000;
+        auto const archiveTime = Measure(&SaveByArchive, &LoadByArchive, count);
+        auto const serializerTime = Measure(&SaveBySerializer, &LoadBySerializer, count);
+
+        std::cout << "Round trip of a call with 5 parameters (" << count << " calls):" << std::endl
+                  << "  boost archive: " << archiveTime << " ns/call" << std::endl
+                  << "  serializer:    " << serializerTime << " ns/call" << std::endl;
+    }
+    catch (std::exception const &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,127 @@
+//-------------------------------------------------------------------
+//  MetaInfo Framework (MIF)
+//  https://github.com/tdv/mif
+//  Created:     10.2026
+//  Copyright (C) 2016-2024 tdv
+//-------------------------------------------------------------------
+
+#ifndef __MIF_COMMON_BASE64_H__
+#define __MIF_COMMON_BASE64_H__
+
+// STD
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+
+namespace Mif
+{
+    namespace Common
+    {
+        namespace Base64
+        {
+            namespace Detail
+            {
+
+                inline char const* GetAlphabet()
+                {
+                    return "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+                }
+
+                // 0xFF for the chars out of the alphabet.
+                inline std::uint8_t const* GetDecodeTable()
+                {
+                    struct Table
+                    {
+                        std::uint8_t data[256];
+
+                        Table()
+                        {
+                            for (auto &i : data)
+                                i = 0xFF;
+                            auto const *alphabet = GetAlphabet();
+                            for (std::uint8_t i = 0 ; i < 64 ; ++i)
+                                data[static_cast<unsigned char>(alphabet[i])] = i;
+                        }
+                    };
+
+                    static Table const table;
+                    return table.data;
+                }
+
+            }   // namespace Detail
+
+            inline constexpr std::size_t GetEncodedSize(std::size_t size)
+            {
+                return (size + 2) / 3 * 4;
+            }
+
+            // Appends the encoded bytes to the container of chars (std::string, Common::Buffer).
+            template <typename TIterator, typename TContainer>
+            inline void Encode(TIterator first, TIterator last, TContainer &container)
+            {
+                auto const size = static_cast<std::size_t>(std::distance(first, last));
+                auto const offset = container.size();
+                container.resize(offset + GetEncodedSize(size));
+
+                auto const *alphabet = Detail::GetAlphabet();
+                auto *out = &container[0] + offset;
+
+                for (auto rest = size ; rest >= 3 ; rest -= 3)
+                {
+                    std::uint32_t value = static_cast<std::uint8_t>(*first++) << 16;
+                    value |= static_cast<std::uint8_t>(*first++) << 8;
+                    value |= static_cast<std::uint8_t>(*first++);
+                    *out++ = alphabet[(value >> 18) & 0x3F];
+                    *out++ = alphabet[(value >> 12) & 0x3F];
+                    *out++ = alphabet[(value >> 6) & 0x3F];
+                    *out++ = alphabet[value & 0x3F];
+                }
+
+                if (auto const tail = size % 3)
+                {
+                    std::uint32_t value = static_cast<std::uint8_t>(*first++) << 16;
+                    if (tail == 2)
+                        value |= static_cast<std::uint8_t>(*first++) << 8;
+                    *out++ = alphabet[(value >> 18) & 0x3F];
+                    *out++ = alphabet[(value >> 12) & 0x3F];
+                    *out++ = tail == 2 ? alphabet[(value >> 6) & 0x3F] : '=';
+                    *out++ = '=';
+                }
+            }
+
+            // Writes the decoded bytes to the output iterator. The padding is optional.
+            template <typename TValue, typename TOutputIterator>
+            inline void Decode(char const *data, std::size_t size, TOutputIterator out)
+            {
+                while (size && data[size - 1] == '=')
+                    --size;
+
+                if (size % 4 == 1)
+                    throw std::invalid_argument{"[Mif::Common::Base64::Decode] Bad size of data."};
+
+                auto const *table = Detail::GetDecodeTable();
+                std::uint32_t value = 0;
+                std::size_t bits = 0;
+
+                for (auto const *end = data + size ; data != end ; ++data)
+                {
+                    auto const digit = table[static_cast<unsigned char>(*data)];
+                    if (digit == 0xFF)
+                        throw std::invalid_argument{"[Mif::Common::Base64::Decode] Bad char in data."};
+
+                    value = (value << 6) | digit;
+                    bits += 6;
+                    if (bits >= 8)
+                    {
+                        bits -= 8;
+                        *out++ = static_cast<TValue>(static_cast<char>((value >> bits) & 0xFF));
+                    }
+                }
+            }
+
+        }   // namespace Base64
+    }   // namespace Common
+}   // namespace Mif
+
+#endif  // !__MIF_COMMON_BASE64_H__
@@ -0,0 +1,180 @@
+//-------------------------------------------------------------------
+//  MetaInfo Framework (MIF)
+//  https://github.com/tdv/mif
+//  Created:     10.2026
+//  Copyright (C) 2016-2024 tdv
+//-------------------------------------------------------------------
+
+#ifndef __MIF_COMMON_NUMBER_H__
+#define __MIF_COMMON_NUMBER_H__
+
+// STD
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <locale>
+#include <streambuf>
+
+namespace Mif
+{
+    namespace Common
+    {
+        namespace Number
+        {
+            namespace Detail
+            {
+
+                inline bool IsDigit(char ch)
+                {
+                    return ch >= '0' && ch <= '9';
+                }
+
+                // Reads the double from the range in the classic locale without copying it.
+                // The stream is reused by the thread.
+                class RangeParser final
+                {
+                public:
+                    RangeParser()
+                        : m_stream{&m_buffer}
+                    {
+                        m_stream.imbue(std::locale::classic());
+                    }
+
+                    double Parse(char const *begin, char const *end)
+                    {
+                        m_buffer.Reset(begin, end);
+                        m_stream.clear();
+
+                        double value = 0;
+                        m_stream >> value;
+
+                        // The stream gives the max value on overflow.
+                        if (m_stream.fail() && value == std::numeric_limits<double>::max())
+                            return std::numeric_limits<double>::infinity();
+                        if (m_stream.fail() && value == -std::numeric_limits<double>::max())
+                            return -std::numeric_limits<double>::infinity();
+
+                        return value;
+                    }
+
+                private:
+                    class Buffer final
+                        : public std::streambuf
+                    {
+                    public:
+                        void Reset(char const *begin, char const *end)
+                        {
+                            // The buffer is only read.
+                            auto *data = const_cast<char *>(begin);
+                            setg(data, data, data + (end - begin));
+                        }
+                    };
+
+                    Buffer m_buffer;
+                    std::istream m_stream;
+                };
+
+            }   // namespace Detail
+
+            // Parses the number in the json form: [-+]digits[.digits][(e|E)[-+]digits] in the classic
+            // locale. Returns the position after the number or begin if there is no number.
+            // The numbers up to 19 significant digits with the small exponents are exact as is,
+            // the others are read by the stream.
+            inline char const* ParseDouble(char const *begin, char const *end, double &value)
+            {
+                static double const powers[] = {
+                        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+                    };
+
+                auto const *pos = begin;
+
+                bool isNegative = false;
+                if (pos != end && (*pos == '-' || *pos == '+'))
+                    isNegative = *pos++ == '-';
+
+                std::uint64_t mantissa = 0;
+                int digits = 0;
+                int exponent = 0;
+                bool isExact = true;
+
+                auto const takeDigit = [&] (char ch)
+                    {
+                        if (digits >= 19)
+                        {
+                            isExact = false;
+                            return false;
+                        }
+                        mantissa = mantissa * 10 + static_cast<std::uint64_t>(ch - '0');
+                        if (mantissa)
+                            ++digits;
+                        return true;
+                    };
+
+                auto const *integer = pos;
+                for ( ; pos != end && Detail::IsDigit(*pos) ; ++pos)
+                {
+                    if (!takeDigit(*pos))
+                        ++exponent;
+                }
+                if (pos == integer)
+                    return begin;
+
+                if (pos != end && *pos == '.')
+                {
+                    auto const *fraction = ++pos;
+                    for ( ; pos != end && Detail::IsDigit(*pos) ; ++pos)
+                    {
+                        if (takeDigit(*pos))
+                            --exponent;
+                    }
+                    if (pos == fraction)
+                        return begin;
+                }
+
+                if (pos != end && (*pos == 'e' || *pos == 'E'))
+                {
+                    auto const *mark = pos++;
+                    bool isNegativeExponent = false;
+                    if (pos != end && (*pos == '-' || *pos == '+'))
+                        isNegativeExponent = *pos++ == '-';
+
+                    auto const *digitsBegin = pos;
+                    int value = 0;
+                    for ( ; pos != end && Detail::IsDigit(*pos) ; ++pos)
+                    {
+                        if (value < 100000)
+                            value = value * 10 + (*pos - '0');
+                    }
+                    if (pos == digitsBegin)
+                        pos = mark;
+                    else
+                        exponent += isNegativeExponent ? -value : value;
+                }
+
+                if (!mantissa)
+                {
+                    value = isNegative ? -0.0 : 0.0;
+                    return pos;
+                }
+
+                if (isExact && mantissa <= (std::uint64_t{1} << 53) && exponent >= -22 && exponent <= 22)
+                {
+                    auto const result = exponent < 0 ?
+                            static_cast<double>(mantissa) / powers[-exponent] :
+                            static_cast<double>(mantissa) * powers[exponent];
+                    value = isNegative ? -result : result;
+                    return pos;
+                }
+
+                static thread_local Detail::RangeParser parser;
+                value = parser.Parse(begin, pos);
+                return pos;
+            }
+
+        }   // namespace Number
+    }   // namespace Common
+}   // namespace Mif
+
+#endif  // !__MIF_COMMON_NUMBER_H__
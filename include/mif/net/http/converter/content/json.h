@@ -32,7 +32,7 @@ namespace Mif
                         {
                             if (buffer.empty())
                                 throw std::invalid_argument{"[Mif::Net::Http::Converter::Content::Json] No content."};
-                            return Serialization::Json::Deserialize<T>(buffer);
+                            return Serialization::Json::Read<T>(buffer);
                         }
                     };
 
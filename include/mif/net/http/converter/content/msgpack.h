@@ -0,0 +1,45 @@
+//-------------------------------------------------------------------
+//  MetaInfo Framework (MIF)
+//  https://github.com/tdv/mif
+//  Created:     10.2026
+//  Copyright (C) 2016-2024 tdv
+//-------------------------------------------------------------------
+
+#ifndef __MIF_NET_HTTP_CONVERTER_CONTENT_MSGPACK_H__
+#define __MIF_NET_HTTP_CONVERTER_CONTENT_MSGPACK_H__
+
+// STD
+#include <stdexcept>
+
+// MIF
+#include "mif/serialization/msgpack.h"
+
+namespace Mif
+{
+    namespace Net
+    {
+        namespace Http
+        {
+            namespace Converter
+            {
+                namespace Content
+                {
+
+                    struct MsgPack final
+                    {
+                        template <typename T>
+                        static T Convert(Common::Buffer const &buffer)
+                        {
+                            if (buffer.empty())
+                                throw std::invalid_argument{"[Mif::Net::Http::Converter::Content::MsgPack] No content."};
+                            return Serialization::MsgPack::Deserialize<T>(buffer);
+                        }
+                    };
+
+                }   // namespace Content
+            }   // namespace Converter
+        }   // namespace Http
+    }   // namespace Net
+}   // namespace Mif
+
+#endif  // !__MIF_NET_HTTP_CONVERTER_CONTENT_MSGPACK_H__
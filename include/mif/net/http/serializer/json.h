@@ -30,7 +30,7 @@ namespace Mif
                     template <typename T>
                     static Common::Buffer Serialize(T const &data)
                     {
-                        return Serialization::Json::Serialize(data);
+                        return Serialization::Json::Write(data);
                     }
                 };
 
@@ -0,0 +1,43 @@
+//-------------------------------------------------------------------
+//  MetaInfo Framework (MIF)
+//  https://github.com/tdv/mif
+//  Created:     10.2026
+//  Copyright (C) 2016-2024 tdv
+//-------------------------------------------------------------------
+
+#ifndef __MIF_NET_HTTP_SERIALIZER_MSGPACK_H__
+#define __MIF_NET_HTTP_SERIALIZER_MSGPACK_H__
+
+// MIF
+#include "mif/serialization/msgpack.h"
+
+namespace Mif
+{
+    namespace Net
+    {
+        namespace Http
+        {
+            namespace Serializer
+            {
+
+                struct MsgPack final
+                {
+                    static constexpr char const* GetContentType()
+                    {
+                        return "application/msgpack";
+                    }
+
+                    template <typename T>
+                    static Common::Buffer Serialize(T const &data)
+                    {
+                        return Serialization::MsgPack::Serialize(data);
+                    }
+                };
+
+            }   // namespace Serializer
+        }   // namespace Http
+    }   // namespace Net
+}   // namespace Mif
+
+
+#endif  // !__MIF_NET_HTTP_SERIALIZER_MSGPACK_H__
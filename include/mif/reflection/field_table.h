@@ -0,0 +1,225 @@
+//-------------------------------------------------------------------
+//  MetaInfo Framework (MIF)
+//  https://github.com/tdv/mif
+//  Created:     10.2026
+//  Copyright (C) 2016-2024 tdv
+//-------------------------------------------------------------------
+
+#ifndef __MIF_REFLECTION_FIELD_TABLE_H__
+#define __MIF_REFLECTION_FIELD_TABLE_H__
+
+// STD
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+// MIF
+#include "mif/common/index_sequence.h"
+#include "mif/reflection/reflection.h"
+
+namespace Mif
+{
+    namespace Reflection
+    {
+
+        // The runtime descriptor of the fields of a reflected class. It is made once per type and gives
+        // the fields by name in O(1) through a hash table. The fields of the base classes are not in
+        // the table, they have their own ones.
+        template <typename T>
+        class FieldTable final
+        {
+        public:
+            static_assert(IsReflectable<T>() && std::is_class<T>::value,
+                    "[Mif::Reflection::FieldTable] Type must be reflectable struct.");
+
+            struct Field
+            {
+                char const *name;
+                std::size_t size;
+                std::size_t index;
+                std::type_info const *type;
+                void* (*access)(T &);
+                void const* (*constAccess)(T const &);
+            };
+
+            static FieldTable const& Get()
+            {
+                static FieldTable const table;
+                return table;
+            }
+
+            std::size_t GetCount() const
+            {
+                return m_fields.size();
+            }
+
+            Field const& GetField(std::size_t index) const
+            {
+                if (index >= m_fields.size())
+                    throw std::out_of_range{"[Mif::Reflection::FieldTable::GetField] Bad field index."};
+                return m_fields[index];
+            }
+
+            // Returns nullptr if the type has no field with the name.
+            Field const* Find(char const *name, std::size_t size) const
+            {
+                if (m_slots.empty())
+                    return nullptr;
+
+                auto const mask = m_slots.size() - 1;
+                for (auto slot = Hash(name, size) & mask ; m_slots[slot] ; slot = (slot + 1) & mask)
+                {
+                    auto const &field = m_fields[m_slots[slot] - 1];
+                    if (field.size == size && !std::memcmp(field.name, name, size))
+                        return &field;
+                }
+
+                return nullptr;
+            }
+
+            Field const* Find(std::string const &name) const
+            {
+                return Find(name.data(), name.size());
+            }
+
+            // Returns nullptr if the type has no field with the name or the field has other type.
+            template <typename TValue>
+            TValue* GetValue(T &object, std::string const &name) const
+            {
+                auto const *field = Find(name);
+                if (!field || *field->type != typeid(TValue))
+                    return nullptr;
+                return static_cast<TValue *>(field->access(object));
+            }
+
+            template <typename TValue>
+            TValue const* GetValue(T const &object, std::string const &name) const
+            {
+                auto const *field = Find(name);
+                if (!field || *field->type != typeid(TValue))
+                    return nullptr;
+                return static_cast<TValue const *>(field->constAccess(object));
+            }
+
+            // Calls visitor(name, value) with the typed value of the field at the index.
+            template <typename TObject, typename TVisitor>
+            static typename std::enable_if<std::is_same<typename std::decay<TObject>::type, T>::value, void>::type
+            Visit(TObject &object, std::size_t index, TVisitor &&visitor)
+            {
+                if (index >= Count)
+                    throw std::out_of_range{"[Mif::Reflection::FieldTable::Visit] Bad field index."};
+                Dispatch(object, index, visitor, static_cast<Common::MakeIndexSequence<Count> const *>(nullptr));
+            }
+
+            // Returns false if the type has no field with the name.
+            template <typename TObject, typename TVisitor>
+            typename std::enable_if<std::is_same<typename std::decay<TObject>::type, T>::value, bool>::type
+            Visit(TObject &object, char const *name, std::size_t size, TVisitor &&visitor) const
+            {
+                auto const *field = Find(name, size);
+                if (!field)
+                    return false;
+                Dispatch(object, field->index, visitor, static_cast<Common::MakeIndexSequence<Count> const *>(nullptr));
+                return true;
+            }
+
+        private:
+            using Fields = typename Reflect<T>::Fields;
+
+            static constexpr std::size_t Count = Fields::Count;
+
+            std::vector<Field> m_fields;
+            // The field index + 1, 0 is for the empty slot.
+            std::vector<std::size_t> m_slots;
+
+            FieldTable()
+            {
+                Fill(static_cast<Common::MakeIndexSequence<Count> const *>(nullptr));
+
+                if (m_fields.empty())
+                    return;
+
+                std::size_t size = 1;
+                while (size < m_fields.size() * 2)
+                    size <<= 1;
+
+                m_slots.resize(size, 0);
+
+                auto const mask = size - 1;
+                for (auto const &i : m_fields)
+                {
+                    auto slot = Hash(i.name, i.size) & mask;
+                    while (m_slots[slot])
+                        slot = (slot + 1) & mask;
+                    m_slots[slot] = i.index + 1;
+                }
+            }
+
+            template <std::size_t ... Indexes>
+            void Fill(Common::IndexSequence<Indexes ... > const *)
+            {
+                m_fields = {MakeField<Indexes>() ... };
+            }
+
+            template <std::size_t Index>
+            static Field MakeField()
+            {
+                using Item = typename Fields::template Field<Index>;
+                return {Item::Name::Value, std::strlen(Item::Name::Value), Index,
+                        &typeid(typename Item::Type), &Access<Index>, &ConstAccess<Index>};
+            }
+
+            template <std::size_t Index>
+            static void* Access(T &object)
+            {
+                return &(object.*Fields::template Field<Index>::Access());
+            }
+
+            template <std::size_t Index>
+            static void const* ConstAccess(T const &object)
+            {
+                return &(object.*Fields::template Field<Index>::Access());
+            }
+
+            template <std::size_t Index, typename TObject, typename TVisitor>
+            static void Invoke(TObject &object, TVisitor &visitor)
+            {
+                using Item = typename Fields::template Field<Index>;
+                visitor(Item::Name::Value, object.*Item::Access());
+            }
+
+            template <typename TObject, typename TVisitor, std::size_t ... Indexes>
+            static void Dispatch(TObject &object, std::size_t index, TVisitor &visitor,
+                    Common::IndexSequence<Indexes ... > const *)
+            {
+                using Invoker = void (*)(TObject &, TVisitor &);
+                static Invoker const invokers[] = {&Invoke<Indexes, TObject, TVisitor> ... };
+                invokers[index](object, visitor);
+            }
+
+            template <typename TObject, typename TVisitor>
+            static void Dispatch(TObject &, std::size_t, TVisitor &, Common::IndexSequence<> const *)
+            {
+            }
+
+            // FNV-1a
+            static std::size_t Hash(char const *data, std::size_t size)
+            {
+                std::uint32_t hash = 2166136261u;
+                for (auto const *end = data + size ; data != end ; ++data)
+                {
+                    hash ^= static_cast<unsigned char>(*data);
+                    hash *= 16777619u;
+                }
+                return hash;
+            }
+        };
+
+    }   // namespace Reflection
+}   // namespace Mif
+
+#endif  // !__MIF_REFLECTION_FIELD_TABLE_H__
@@ -0,0 +1,472 @@
+//-------------------------------------------------------------------
+//  MetaInfo Framework (MIF)
+//  https://github.com/tdv/mif
+//  Created:     10.2026
+//  Copyright (C) 2016-2024 tdv
+//-------------------------------------------------------------------
+
+#ifndef __MIF_REFLECTION_HASH_H__
+#define __MIF_REFLECTION_HASH_H__
+
+// STD
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// MIF
+#include "mif/common/unused.h"
+#include "mif/reflection/reflection.h"
+#include "mif/serialization/traits.h"
+
+namespace Mif
+{
+    namespace Reflection
+    {
+        namespace Detail
+        {
+            namespace Compare
+            {
+
+                template <typename T>
+                inline constexpr bool IsStruct()
+                {
+                    return IsReflectable<T>() && !std::is_enum<T>::value;
+                }
+
+                template <typename T>
+                inline std::true_type IsUnordered(T const *, typename T::hasher const * = nullptr);
+
+                inline std::false_type IsUnordered(...);
+
+                // The unordered containers have the same items in different order, so they are compared
+                // and hashed regardless of the order.
+                template <typename T>
+                inline constexpr bool IsUnordered()
+                {
+                    return Serialization::Traits::IsIterable<T>() &&
+                            decltype(IsUnordered(static_cast<T const *>(nullptr)))::value;
+                }
+
+                template <typename T>
+                inline constexpr bool IsOrdered()
+                {
+                    return Serialization::Traits::IsIterable<T>() && !IsUnordered<T>();
+                }
+
+                template <typename T>
+                inline constexpr bool IsNullable()
+                {
+                    return Serialization::Traits::IsSmartPointer<T>() || Serialization::Traits::IsOptional<T>();
+                }
+
+                //--------------------------------------------------------------------------------------------------------------------------
+
+                // The 64x64 -> 128 bit multiplication folded to 64 bit as in wyhash.
+                inline std::uint64_t Mix(std::uint64_t left, std::uint64_t right)
+                {
+#ifdef __SIZEOF_INT128__
+                    auto const res = static_cast<unsigned __int128>(left) * right;
+                    return static_cast<std::uint64_t>(res) ^ static_cast<std::uint64_t>(res >> 64);
+#else
+                    auto const ll = left & 0xFFFFFFFFu;
+                    auto const lh = left >> 32;
+                    auto const rl = right & 0xFFFFFFFFu;
+                    auto const rh = right >> 32;
+                    auto const low = ll * rl;
+                    auto const mid1 = lh * rl;
+                    auto const mid2 = ll * rh;
+                    auto const high = lh * rh;
+                    auto const carry = ((low >> 32) + (mid1 & 0xFFFFFFFFu) + (mid2 & 0xFFFFFFFFu)) >> 32;
+                    return (low + (mid1 << 32) + (mid2 << 32)) ^ (high + (mid1 >> 32) + (mid2 >> 32) + carry);
+#endif
+                }
+
+                constexpr std::uint64_t Seed = 0xa0761d6478bd642full;
+                constexpr std::uint64_t Prime1 = 0xe7037ed1a0b428dbull;
+                constexpr std::uint64_t Prime2 = 0x8ebc6af09c88c6e3ull;
+
+                inline std::uint64_t Combine(std::uint64_t seed, std::uint64_t value)
+                {
+                    return Mix(seed ^ Prime1, value ^ Prime2);
+                }
+
+                inline std::uint64_t Read64(unsigned char const *data)
+                {
+                    std::uint64_t value = 0;
+                    std::memcpy(&value, data, sizeof(value));
+                    return value;
+                }
+
+                inline std::uint64_t HashBytes(std::uint64_t seed, void const *data, std::size_t size)
+                {
+                    auto const *pos = static_cast<unsigned char const *>(data);
+                    auto rest = size;
+
+                    for ( ; rest > 16 ; rest -= 16, pos += 16)
+                        seed = Mix(Read64(pos) ^ Prime1, Read64(pos + 8) ^ seed);
+
+                    unsigned char tail[16] = {};
+                    std::memcpy(tail, pos, rest);
+                    seed = Mix(Read64(tail) ^ Prime1, Read64(tail + 8) ^ seed);
+
+                    return Combine(seed, size);
+                }
+
+                //--------------------------------------------------------------------------------------------------------------------------
+
+                template <typename T>
+                typename std::enable_if<Serialization::Traits::IsSimple<T>() || std::is_enum<T>::value, bool>::type
+                IsEqual(T const &left, T const &right);
+
+                template <typename T>
+                typename std::enable_if<IsStruct<T>(), bool>::type
+                IsEqual(T const &left, T const &right);
+
+                template <typename T>
+                typename std::enable_if<IsNullable<T>(), bool>::type
+                IsEqual(T const &left, T const &right);
+
+                template <typename T>
+                typename std::enable_if<IsOrdered<T>(), bool>::type
+                IsEqual(T const &left, T const &right);
+
+                template <typename T>
+                typename std::enable_if<IsUnordered<T>() && Serialization::Traits::IsMap<T>(), bool>::type
+                IsEqual(T const &left, T const &right);
+
+                template <typename T>
+                typename std::enable_if<IsUnordered<T>() && !Serialization::Traits::IsMap<T>(), bool>::type
+                IsEqual(T const &left, T const &right);
+
+                template <typename TFirst, typename TSecond>
+                bool IsEqual(std::pair<TFirst, TSecond> const &left, std::pair<TFirst, TSecond> const &right);
+
+                template <typename ... T>
+                bool IsEqual(std::tuple<T ... > const &left, std::tuple<T ... > const &right);
+
+                template <typename T>
+                typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value, std::uint64_t>::type
+                HashValue(std::uint64_t seed, T const &value);
+
+                template <typename T>
+                typename std::enable_if<std::is_floating_point<T>::value, std::uint64_t>::type
+                HashValue(std::uint64_t seed, T const &value);
+
+                inline std::uint64_t HashValue(std::uint64_t seed, std::string const &value);
+
+                template <typename T>
+                typename std::enable_if<IsStruct<T>(), std::uint64_t>::type
+                HashValue(std::uint64_t seed, T const &value);
+
+                template <typename T>
+                typename std::enable_if<IsNullable<T>(), std::uint64_t>::type
+                HashValue(std::uint64_t seed, T const &value);
+
+                template <typename T>
+                typename std::enable_if<IsOrdered<T>(), std::uint64_t>::type
+                HashValue(std::uint64_t seed, T const &value);
+
+                template <typename T>
+                typename std::enable_if<IsUnordered<T>(), std::uint64_t>::type
+                HashValue(std::uint64_t seed, T const &value);
+
+                template <typename TFirst, typename TSecond>
+                std::uint64_t HashValue(std::uint64_t seed, std::pair<TFirst, TSecond> const &value);
+
+                template <typename ... T>
+                std::uint64_t HashValue(std::uint64_t seed, std::tuple<T ... > const &value);
+
+                //--------------------------------------------------------------------------------------------------------------------------
+
+                template <typename TBases, std::size_t I, typename T>
+                inline typename std::enable_if<I == std::tuple_size<TBases>::value, bool>::type
+                IsEqualBases(T const &left, T const &right)
+                {
+                    Common::Unused(left, right);
+                    return true;
+                }
+
+                template <typename TBases, std::size_t I, typename T>
+                inline typename std::enable_if<I != std::tuple_size<TBases>::value, bool>::type
+                IsEqualBases(T const &left, T const &right)
+                {
+                    using Base = typename std::tuple_element<I, TBases>::type;
+                    return IsEqual(static_cast<Base const &>(left), static_cast<Base const &>(right)) &&
+                            IsEqualBases<TBases, I + 1>(left, right);
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I == N, bool>::type
+                IsEqualFields(T const &left, T const &right)
+                {
+                    Common::Unused(left, right);
+                    return true;
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I != N, bool>::type
+                IsEqualFields(T const &left, T const &right)
+                {
+                    using Field = typename Reflect<T>::Fields::template Field<I>;
+                    return IsEqual(left.*Field::Access(), right.*Field::Access()) &&
+                            IsEqualFields<I + 1, N>(left, right);
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I == N, bool>::type
+                IsEqualItems(T const &left, T const &right)
+                {
+                    Common::Unused(left, right);
+                    return true;
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I != N, bool>::type
+                IsEqualItems(T const &left, T const &right)
+                {
+                    return IsEqual(std::get<I>(left), std::get<I>(right)) &&
+                            IsEqualItems<I + 1, N>(left, right);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<Serialization::Traits::IsSimple<T>() || std::is_enum<T>::value, bool>::type
+                IsEqual(T const &left, T const &right)
+                {
+                    return left == right;
+                }
+
+                template <typename T>
+                inline typename std::enable_if<IsStruct<T>(), bool>::type
+                IsEqual(T const &left, T const &right)
+                {
+                    using Meta = Reflect<T>;
+                    return IsEqualBases<typename Meta::Base, 0>(left, right) &&
+                            IsEqualFields<0, Meta::Fields::Count>(left, right);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<IsNullable<T>(), bool>::type
+                IsEqual(T const &left, T const &right)
+                {
+                    if (!left || !right)
+                        return !left == !right;
+                    return IsEqual(*left, *right);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<IsOrdered<T>(), bool>::type
+                IsEqual(T const &left, T const &right)
+                {
+                    auto i = std::begin(left);
+                    auto j = std::begin(right);
+                    for ( ; i != std::end(left) && j != std::end(right) ; ++i, ++j)
+                    {
+                        if (!IsEqual(*i, *j))
+                            return false;
+                    }
+                    return i == std::end(left) && j == std::end(right);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<IsUnordered<T>() && Serialization::Traits::IsMap<T>(), bool>::type
+                IsEqual(T const &left, T const &right)
+                {
+                    if (left.size() != right.size())
+                        return false;
+                    for (auto const &i : left)
+                    {
+                        auto const iter = right.find(i.first);
+                        if (iter == std::end(right) || !IsEqual(i.second, iter->second))
+                            return false;
+                    }
+                    return true;
+                }
+
+                // The multisets have to have the same number of the equal items.
+                template <typename T>
+                inline typename std::enable_if<IsUnordered<T>() && !Serialization::Traits::IsMap<T>(), bool>::type
+                IsEqual(T const &left, T const &right)
+                {
+                    if (left.size() != right.size())
+                        return false;
+                    for (auto i = std::begin(left) ; i != std::end(left) ; )
+                    {
+                        auto const items = left.equal_range(*i);
+                        auto const other = right.equal_range(*i);
+                        if (std::distance(items.first, items.second) != std::distance(other.first, other.second))
+                            return false;
+                        i = items.second;
+                    }
+                    return true;
+                }
+
+                template <typename TFirst, typename TSecond>
+                inline bool IsEqual(std::pair<TFirst, TSecond> const &left, std::pair<TFirst, TSecond> const &right)
+                {
+                    return IsEqual(left.first, right.first) && IsEqual(left.second, right.second);
+                }
+
+                template <typename ... T>
+                inline bool IsEqual(std::tuple<T ... > const &left, std::tuple<T ... > const &right)
+                {
+                    return IsEqualItems<0, sizeof ... (T)>(left, right);
+                }
+
+                //--------------------------------------------------------------------------------------------------------------------------
+
+                template <typename TBases, std::size_t I, typename T>
+                inline typename std::enable_if<I == std::tuple_size<TBases>::value, std::uint64_t>::type
+                HashBases(std::uint64_t seed, T const &value)
+                {
+                    Common::Unused(value);
+                    return seed;
+                }
+
+                template <typename TBases, std::size_t I, typename T>
+                inline typename std::enable_if<I != std::tuple_size<TBases>::value, std::uint64_t>::type
+                HashBases(std::uint64_t seed, T const &value)
+                {
+                    using Base = typename std::tuple_element<I, TBases>::type;
+                    return HashBases<TBases, I + 1>(HashValue(seed, static_cast<Base const &>(value)), value);
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I == N, std::uint64_t>::type
+                HashFields(std::uint64_t seed, T const &value)
+                {
+                    Common::Unused(value);
+                    return seed;
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I != N, std::uint64_t>::type
+                HashFields(std::uint64_t seed, T const &value)
+                {
+                    using Field = typename Reflect<T>::Fields::template Field<I>;
+                    return HashFields<I + 1, N>(HashValue(seed, value.*Field::Access()), value);
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I == N, std::uint64_t>::type
+                HashItems(std::uint64_t seed, T const &value)
+                {
+                    Common::Unused(value);
+                    return seed;
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I != N, std::uint64_t>::type
+                HashItems(std::uint64_t seed, T const &value)
+                {
+                    return HashItems<I + 1, N>(HashValue(seed, std::get<I>(value)), value);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value, std::uint64_t>::type
+                HashValue(std::uint64_t seed, T const &value)
+                {
+                    return Combine(seed, static_cast<std::uint64_t>(value));
+                }
+
+                // 0.0 and -0.0 are equal, so they have the same hash.
+                template <typename T>
+                inline typename std::enable_if<std::is_floating_point<T>::value, std::uint64_t>::type
+                HashValue(std::uint64_t seed, T const &value)
+                {
+                    auto const number = value == 0 ? 0.0 : static_cast<double>(value);
+                    std::uint64_t bits = 0;
+                    std::memcpy(&bits, &number, sizeof(bits));
+                    return Combine(seed, bits);
+                }
+
+                inline std::uint64_t HashValue(std::uint64_t seed, std::string const &value)
+                {
+                    return HashBytes(seed, value.data(), value.size());
+                }
+
+                template <typename T>
+                inline typename std::enable_if<IsStruct<T>(), std::uint64_t>::type
+                HashValue(std::uint64_t seed, T const &value)
+                {
+                    using Meta = Reflect<T>;
+                    return HashFields<0, Meta::Fields::Count>(HashBases<typename Meta::Base, 0>(seed, value), value);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<IsNullable<T>(), std::uint64_t>::type
+                HashValue(std::uint64_t seed, T const &value)
+                {
+                    return value ? HashValue(Combine(seed, 1), *value) : Combine(seed, 0);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<IsOrdered<T>(), std::uint64_t>::type
+                HashValue(std::uint64_t seed, T const &value)
+                {
+                    std::uint64_t count = 0;
+                    for (auto const &i : value)
+                    {
+                        seed = HashValue(seed, i);
+                        ++count;
+                    }
+                    return Combine(seed, count);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<IsUnordered<T>(), std::uint64_t>::type
+                HashValue(std::uint64_t seed, T const &value)
+                {
+                    std::uint64_t sum = 0;
+                    for (auto const &i : value)
+                        sum += HashValue(Seed, i);
+                    return Combine(Combine(seed, sum), value.size());
+                }
+
+                template <typename TFirst, typename TSecond>
+                inline std::uint64_t HashValue(std::uint64_t seed, std::pair<TFirst, TSecond> const &value)
+                {
+                    return HashValue(HashValue(seed, value.first), value.second);
+                }
+
+                template <typename ... T>
+                inline std::uint64_t HashValue(std::uint64_t seed, std::tuple<T ... > const &value)
+                {
+                    return HashItems<0, sizeof ... (T)>(seed, value);
+                }
+
+            }   // namespace Compare
+        }   // namespace Detail
+
+        // The hash of a reflected type made from the fields of the type and its bases. The nested
+        // reflected types, containers, smart pointers and optionals are hashed by their content.
+        // It can be used with Equal in order to put the reflected types into the unordered containers.
+        template <typename T>
+        struct Hash final
+        {
+            static_assert(Detail::Compare::IsStruct<T>(), "[Mif::Reflection::Hash] Type must be reflectable struct.");
+
+            std::size_t operator () (T const &value) const
+            {
+                return static_cast<std::size_t>(Detail::Compare::HashValue(Detail::Compare::Seed, value));
+            }
+        };
+
+        template <typename T>
+        struct Equal final
+        {
+            static_assert(Detail::Compare::IsStruct<T>(), "[Mif::Reflection::Equal] Type must be reflectable struct.");
+
+            bool operator () (T const &left, T const &right) const
+            {
+                return Detail::Compare::IsEqual(left, right);
+            }
+        };
+
+    }   // namespace Reflection
+}   // namespace Mif
+
+#endif  // !__MIF_REFLECTION_HASH_H__
@@ -9,10 +9,14 @@
 #define __MIF_REFLECTION_REFLECTION_H__
 
 // STD
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <iterator>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 // MIF
 #include "mif/common/detail/hierarchy.h"
@@ -62,8 +66,15 @@ namespace Mif
                 using RegItemType = Registry::Registry<T>;
                 using MetaType = typename RegItemType::Type;
 
+                // The fields are looked up on use only, the struct without fields has no GetFieldInfo.
+                template <std::size_t Index, typename TMeta>
+                struct FieldInfoType
+                {
+                    using Type = decltype(TMeta::GetFieldInfo(Common::Detail::Hierarchy<Index>{}));
+                };
+
                 template <std::size_t Index>
-                using FieldInfo = decltype(MetaType::GetFieldInfo(Common::Detail::Hierarchy<Index>{}));
+                using FieldInfo = typename FieldInfoType<Index, MetaType>::Type;
 
             public:
                 static constexpr std::size_t Count = MetaType::FieldsCount - 1;
@@ -86,42 +97,114 @@ namespace Mif
                 using Fields = FieldsList<T>;
             };
 
-            template <typename T, typename TItems, std::size_t Index>
-            inline typename std::enable_if<Index == 0, std::string>::type
-            EnumValueToString(T const &value)
+            // The lookup tables are made once per enum from the list of its items. The names are found
+            // by binary search, the values are taken from the array by index if they are almost contiguous.
+            template <typename T>
+            class EnumTable final
             {
-                Common::Unused(value);
-                throw std::invalid_argument{"[Mif::Reflection::Detail::EnumValueToString] Failed to get name for enum value \"" +
-                        std::to_string(static_cast<typename std::underlying_type<T>::type>(value)) + "\""};
-            }
+            public:
+                using ValueType = typename std::underlying_type<T>::type;
 
-            template <typename T, typename TItems, std::size_t Index>
-            inline typename std::enable_if<Index != 0, std::string>::type
-            EnumValueToString(T const &value)
-            {
-                using Item = typename TItems::template Field<Index - 1>;
-                if (Item::Access() == value)
-                    return Item::Name::Value;
-                return EnumValueToString<T, TItems, Index - 1>(value);
-            }
+                static EnumTable const& Get()
+                {
+                    static EnumTable const table;
+                    return table;
+                }
 
-            template <typename T, typename TItems, std::size_t Index>
-            inline typename std::enable_if<Index == 0, T>::type
-            StringToEnumValue(std::string const &str)
-            {
-                Common::Unused(str);
-                throw std::invalid_argument{"[Mif::Reflection::Detail::StringToEnumValue] Failed to get value from string \"" + str + "\"."};
-            }
+                // Returns nullptr for the values which are not in the enum.
+                char const* ToString(T value) const
+                {
+                    auto const key = static_cast<ValueType>(value);
 
-            template <typename T, typename TItems, std::size_t Index>
-            inline typename std::enable_if<Index != 0, T>::type
-            StringToEnumValue(std::string const &str)
-            {
-                using Item = typename TItems::template Field<Index - 1>;
-                if (str == Item::Name::Value)
-                    return Item::Access();
-                return StringToEnumValue<T, TItems, Index - 1>(str);
-            }
+                    if (!m_names.empty())
+                    {
+                        auto const index = static_cast<std::uint64_t>(key) - static_cast<std::uint64_t>(m_min);
+                        return index < m_names.size() ? m_names[static_cast<std::size_t>(index)] : nullptr;
+                    }
+
+                    auto const iter = std::upper_bound(std::begin(m_byValue), std::end(m_byValue),
+                            Item{nullptr, 0, key}, &EnumTable::ValueLess);
+                    if (iter == std::begin(m_byValue) || std::prev(iter)->value != key)
+                        return nullptr;
+                    return std::prev(iter)->name;
+                }
+
+                bool FromString(char const *data, std::size_t size, T &value) const
+                {
+                    Item const item{data, size, ValueType{}};
+                    auto const iter = std::lower_bound(std::begin(m_byName), std::end(m_byName),
+                            item, &EnumTable::NameLess);
+                    if (iter == std::end(m_byName) || NameLess(item, *iter))
+                        return false;
+                    value = static_cast<T>(iter->value);
+                    return true;
+                }
+
+            private:
+                using Items = typename Class<T>::Fields;
+
+                struct Item
+                {
+                    char const *name;
+                    std::size_t size;
+                    ValueType value;
+                };
+
+                std::vector<Item> m_byName;
+                std::vector<Item> m_byValue;
+                ValueType m_min{};
+                std::vector<char const *> m_names;
+
+                EnumTable()
+                {
+                    Fill<0, Items::Count>();
+
+                    // The last item wins for the same values like it was with the linear search.
+                    m_byValue = m_byName;
+                    std::stable_sort(std::begin(m_byValue), std::end(m_byValue), &EnumTable::ValueLess);
+                    std::sort(std::begin(m_byName), std::end(m_byName), &EnumTable::NameLess);
+
+                    if (m_byValue.empty())
+                        return;
+
+                    m_min = m_byValue.front().value;
+                    auto const range = static_cast<std::uint64_t>(m_byValue.back().value) - static_cast<std::uint64_t>(m_min);
+                    if (range >= 2 * m_byValue.size())
+                        return;
+
+                    m_names.resize(static_cast<std::size_t>(range) + 1, nullptr);
+                    for (auto const &i : m_byValue)
+                        m_names[static_cast<std::size_t>(static_cast<std::uint64_t>(i.value) - static_cast<std::uint64_t>(m_min))] = i.name;
+                }
+
+                template <std::size_t I, std::size_t N>
+                typename std::enable_if<I != N, void>::type
+                Fill()
+                {
+                    using Field = typename Items::template Field<I>;
+                    m_byName.push_back(Item{Field::Name::Value, std::strlen(Field::Name::Value),
+                            static_cast<ValueType>(Field::Access())});
+                    Fill<I + 1, N>();
+                }
+
+                template <std::size_t I, std::size_t N>
+                typename std::enable_if<I == N, void>::type
+                Fill()
+                {
+                }
+
+                static bool NameLess(Item const &left, Item const &right)
+                {
+                    if (left.size != right.size)
+                        return left.size < right.size;
+                    return std::memcmp(left.name, right.name, left.size) < 0;
+                }
+
+                static bool ValueLess(Item const &left, Item const &right)
+                {
+                    return left.value < right.value;
+                }
+            };
 
         }   // namespace Detail
 
@@ -142,8 +225,27 @@ namespace Mif
             >::type
         ToString(T const &value)
         {
-            using Items = typename Reflect<T>::Fields;
-            return Detail::EnumValueToString<T, Items, Items::Count>(value);
+            if (auto const *name = Detail::EnumTable<T>::Get().ToString(value))
+                return name;
+            throw std::invalid_argument{"[Mif::Reflection::ToString] Failed to get name for enum value \"" +
+                    std::to_string(static_cast<typename std::underlying_type<T>::type>(value)) + "\""};
+        }
+
+        template <typename T>
+        inline typename std::enable_if
+            <
+                std::is_enum<T>::value && IsReflectable<T>(),
+                T
+            >::type
+        FromString(char const *data, std::size_t size)
+        {
+            T value{};
+            if (!Detail::EnumTable<T>::Get().FromString(data, size, value))
+            {
+                throw std::invalid_argument{"[Mif::Reflection::FromString] Failed to get value from string \"" +
+                        std::string{data, size} + "\"."};
+            }
+            return value;
         }
 
         template <typename T>
@@ -154,8 +256,7 @@ namespace Mif
             >::type
         FromString(std::string const &value)
         {
-            using Items = typename Reflect<T>::Fields;
-            return Detail::StringToEnumValue<T, Items, Items::Count>(value);
+            return FromString<T>(value.data(), value.size());
         }
 
     }   // namespace Reflection
@@ -0,0 +1,463 @@
+//-------------------------------------------------------------------
+//  MetaInfo Framework (MIF)
+//  https://github.com/tdv/mif
+//  Created:     10.2026
+//  Copyright (C) 2016-2024 tdv
+//-------------------------------------------------------------------
+
+#ifndef __MIF_REFLECTION_SOA_VECTOR_H__
+#define __MIF_REFLECTION_SOA_VECTOR_H__
+
+// STD
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// MIF
+#include "mif/common/index_sequence.h"
+#include "mif/common/unused.h"
+#include "mif/reflection/reflection.h"
+
+namespace Mif
+{
+    namespace Reflection
+    {
+        namespace Detail
+        {
+
+            // The field Index of TOwner. TPath is the tuple of the reflected bases from the outermost
+            // one down to TOwner, it is empty for the fields of the struct itself.
+            template <typename TPath, typename TOwner, std::size_t Index>
+            struct SoAField
+            {
+                using Path = TPath;
+                using Owner = TOwner;
+                using Info = typename Reflect<TOwner>::Fields::template Field<Index>;
+                using Type = typename Info::Type;
+
+                static Type& Get(TOwner &row)
+                {
+                    return row.*Info::Access();
+                }
+
+                static Type const& Get(TOwner const &row)
+                {
+                    return row.*Info::Access();
+                }
+            };
+
+            template <typename ... T>
+            struct SoAConcat;
+
+            template <>
+            struct SoAConcat<>
+            {
+                using Type = std::tuple<>;
+            };
+
+            template <typename ... T>
+            struct SoAConcat<std::tuple<T ... >>
+            {
+                using Type = std::tuple<T ... >;
+            };
+
+            template <typename ... T, typename ... TNext, typename ... TRest>
+            struct SoAConcat<std::tuple<T ... >, std::tuple<TNext ... >, TRest ... >
+                : public SoAConcat<std::tuple<T ... , TNext ... >, TRest ... >
+            {
+            };
+
+            // The fields of the bases go first in the order of the bases, then the fields of T.
+            template
+            <
+                typename T,
+                typename TPath,
+                typename TBases = typename Reflect<T>::Base,
+                typename TSequence = Common::MakeIndexSequence<Reflect<T>::Fields::Count>
+            >
+            struct SoAFields;
+
+            template <typename T, typename ... TPath, typename ... TBases, std::size_t ... Indexes>
+            struct SoAFields<T, std::tuple<TPath ... >, std::tuple<TBases ... >, Common::IndexSequence<Indexes ... >>
+            {
+                using Type = typename SoAConcat
+                    <
+                        typename SoAFields<TBases, std::tuple<TPath ... , TBases>>::Type ... ,
+                        std::tuple<SoAField<std::tuple<TPath ... >, T, Indexes> ... >
+                    >::Type;
+            };
+
+            template <typename TFields>
+            struct SoAColumns;
+
+            template <typename ... TFields>
+            struct SoAColumns<std::tuple<TFields ... >>
+            {
+                using Type = std::tuple<std::vector<typename TFields::Type> ... >;
+            };
+
+        }   // namespace Detail
+
+        // The container keeps each field of a reflected struct in its own contiguous array, so
+        // the loops over a few fields of many records touch only the memory of these fields.
+        // The fields of the reflected bases have their own columns too, they go before the
+        // fields of the struct (see Field<I>::Path).
+        // The rows are available through the proxies, the columns through the spans over the
+        // arrays. The bool fields are kept in std::vector<bool> and have no span.
+        // GetColumns gives the tuple of the columns, so any serializer writes it as a columnar
+        // block, and the container is made back from the read tuple.
+        template <typename T>
+        class SoAVector final
+        {
+        public:
+            static_assert(IsReflectable<T>() && std::is_class<T>::value,
+                    "[Mif::Reflection::SoAVector] Type must be reflectable struct.");
+
+            // The tuple of Detail::SoAField, one per column.
+            using Fields = typename Detail::SoAFields<T, std::tuple<>>::Type;
+
+            static constexpr std::size_t FieldsCount = std::tuple_size<Fields>::value;
+
+            template <std::size_t I>
+            using Field = typename std::tuple_element<I, Fields>::type;
+
+            template <std::size_t I>
+            using FieldType = typename Field<I>::Type;
+
+            using Columns = typename Detail::SoAColumns<Fields>::Type;
+
+            template <typename TItem>
+            class Span final
+            {
+            public:
+                Span(TItem *data, std::size_t size)
+                    : m_data{data}
+                    , m_size{size}
+                {
+                }
+
+                TItem* Data() const
+                {
+                    return m_data;
+                }
+
+                std::size_t Size() const
+                {
+                    return m_size;
+                }
+
+                TItem& operator [] (std::size_t index) const
+                {
+                    return m_data[index];
+                }
+
+                TItem* begin() const
+                {
+                    return m_data;
+                }
+
+                TItem* end() const
+                {
+                    return m_data + m_size;
+                }
+
+            private:
+                TItem *m_data;
+                std::size_t m_size;
+            };
+
+            template <typename TOwner>
+            class RowProxy final
+            {
+            public:
+                RowProxy(TOwner &owner, std::size_t index)
+                    : m_owner{owner}
+                    , m_index{index}
+                {
+                }
+
+                std::size_t GetIndex() const
+                {
+                    return m_index;
+                }
+
+                template <std::size_t I>
+                auto Get() const -> decltype(std::get<I>(std::declval<TOwner &>().m_columns)[0])
+                {
+                    return std::get<I>(m_owner.m_columns)[m_index];
+                }
+
+                operator T () const
+                {
+                    return m_owner.GetRow(m_index);
+                }
+
+                template <typename TValue>
+                typename std::enable_if<std::is_same<typename std::decay<TValue>::type, T>::value && !std::is_const<TOwner>::value, RowProxy const &>::type
+                operator = (TValue &&value) const
+                {
+                    m_owner.SetRow(m_index, std::forward<TValue>(value));
+                    return *this;
+                }
+
+            private:
+                TOwner &m_owner;
+                std::size_t m_index;
+            };
+
+            using Row = RowProxy<SoAVector>;
+            using ConstRow = RowProxy<SoAVector const>;
+
+            SoAVector() = default;
+
+            explicit SoAVector(std::vector<T> const &rows)
+            {
+                Assign(rows);
+            }
+
+            explicit SoAVector(std::vector<T> &&rows)
+            {
+                Assign(std::move(rows));
+            }
+
+            // All the columns have to be of the same size.
+            explicit SoAVector(Columns columns)
+                : m_columns(std::move(columns))
+            {
+                m_size = GetColumnsSize(static_cast<Common::MakeIndexSequence<FieldsCount> const *>(nullptr));
+                if (!CheckSizes(static_cast<Common::MakeIndexSequence<FieldsCount> const *>(nullptr)))
+                    throw std::invalid_argument{"[Mif::Reflection::SoAVector] The columns have different sizes."};
+            }
+
+            std::size_t Size() const
+            {
+                return m_size;
+            }
+
+            bool Empty() const
+            {
+                return !m_size;
+            }
+
+            void Reserve(std::size_t size)
+            {
+                Reserve(size, static_cast<Common::MakeIndexSequence<FieldsCount> const *>(nullptr));
+            }
+
+            void Resize(std::size_t size)
+            {
+                Resize(size, static_cast<Common::MakeIndexSequence<FieldsCount> const *>(nullptr));
+                m_size = size;
+            }
+
+            void Clear()
+            {
+                Resize(0);
+            }
+
+            void PushBack(T const &row)
+            {
+                Append(row, static_cast<Common::MakeIndexSequence<FieldsCount> const *>(nullptr));
+                ++m_size;
+            }
+
+            void PushBack(T &&row)
+            {
+                Append(std::move(row), static_cast<Common::MakeIndexSequence<FieldsCount> const *>(nullptr));
+                ++m_size;
+            }
+
+            Row operator [] (std::size_t index)
+            {
+                return {*this, index};
+            }
+
+            ConstRow operator [] (std::size_t index) const
+            {
+                return {*this, index};
+            }
+
+            Row At(std::size_t index)
+            {
+                CheckIndex(index);
+                return {*this, index};
+            }
+
+            ConstRow At(std::size_t index) const
+            {
+                CheckIndex(index);
+                return {*this, index};
+            }
+
+            T GetRow(std::size_t index) const
+            {
+                T row{};
+                Copy(index, row, static_cast<Common::MakeIndexSequence<FieldsCount> const *>(nullptr));
+                return row;
+            }
+
+            template <typename TValue>
+            typename std::enable_if<std::is_same<typename std::decay<TValue>::type, T>::value, void>::type
+            SetRow(std::size_t index, TValue &&row)
+            {
+                Put(index, std::forward<TValue>(row), static_cast<Common::MakeIndexSequence<FieldsCount> const *>(nullptr));
+            }
+
+            template <std::size_t I>
+            Span<FieldType<I>> GetColumn()
+            {
+                static_assert(!std::is_same<FieldType<I>, bool>::value,
+                        "[Mif::Reflection::SoAVector::GetColumn] The bool column has no span.");
+                auto &column = std::get<I>(m_columns);
+                return {column.data(), column.size()};
+            }
+
+            template <std::size_t I>
+            Span<FieldType<I> const> GetColumn() const
+            {
+                static_assert(!std::is_same<FieldType<I>, bool>::value,
+                        "[Mif::Reflection::SoAVector::GetColumn] The bool column has no span.");
+                auto const &column = std::get<I>(m_columns);
+                return {column.data(), column.size()};
+            }
+
+            Columns const& GetColumns() const
+            {
+                return m_columns;
+            }
+
+            std::vector<T> ToVector() const
+            {
+                std::vector<T> rows;
+                rows.reserve(m_size);
+                for (std::size_t i = 0 ; i < m_size ; ++i)
+                    rows.push_back(GetRow(i));
+                return rows;
+            }
+
+        private:
+            template <typename>
+            friend class RowProxy;
+
+            Columns m_columns;
+            std::size_t m_size = 0;
+
+            void Assign(std::vector<T> const &rows)
+            {
+                Reserve(rows.size());
+                for (auto const &i : rows)
+                    PushBack(i);
+            }
+
+            void Assign(std::vector<T> &&rows)
+            {
+                Reserve(rows.size());
+                for (auto &i : rows)
+                    PushBack(std::move(i));
+            }
+
+            void CheckIndex(std::size_t index) const
+            {
+                if (index >= m_size)
+                    throw std::out_of_range{"[Mif::Reflection::SoAVector::At] Bad row index."};
+            }
+
+            template <std::size_t ... Indexes>
+            void Reserve(std::size_t size, Common::IndexSequence<Indexes ... > const *)
+            {
+                Common::Unused(size);
+                Common::Unused((std::get<Indexes>(m_columns).reserve(size), 0) ... );
+            }
+
+            template <std::size_t ... Indexes>
+            void Resize(std::size_t size, Common::IndexSequence<Indexes ... > const *)
+            {
+                Common::Unused(size);
+                Common::Unused((std::get<Indexes>(m_columns).resize(size), 0) ... );
+            }
+
+            // Drops the items which are beyond the size from the columns.
+            template <std::size_t ... Indexes>
+            void Shrink(Common::IndexSequence<Indexes ... > const *)
+            {
+                Common::Unused((std::get<Indexes>(m_columns).size() > m_size ? (std::get<Indexes>(m_columns).pop_back(), 0) : 0) ... );
+            }
+
+            // The first item is for the structures without fields, they have no columns.
+            template <std::size_t ... Indexes>
+            std::size_t GetColumnsSize(Common::IndexSequence<Indexes ... > const *) const
+            {
+                std::size_t const sizes[] = {0, std::get<Indexes>(m_columns).size() ... };
+                return sizes[sizeof ... (Indexes) ? 1 : 0];
+            }
+
+            template <std::size_t ... Indexes>
+            bool CheckSizes(Common::IndexSequence<Indexes ... > const *) const
+            {
+                std::size_t const sizes[] = {m_size, std::get<Indexes>(m_columns).size() ... };
+                for (auto const size : sizes)
+                {
+                    if (size != m_size)
+                        return false;
+                }
+                return true;
+            }
+
+            // The columns which have got the item are shrunk back if any of them throws.
+            template <std::size_t ... Indexes>
+            void Append(T const &row, Common::IndexSequence<Indexes ... > const *seq)
+            {
+                try
+                {
+                    Common::Unused((std::get<Indexes>(m_columns).push_back(Field<Indexes>::Get(row)), 0) ... );
+                }
+                catch (...)
+                {
+                    Shrink(seq);
+                    throw;
+                }
+            }
+
+            template <std::size_t ... Indexes>
+            void Append(T &&row, Common::IndexSequence<Indexes ... > const *seq)
+            {
+                try
+                {
+                    Common::Unused((std::get<Indexes>(m_columns).push_back(std::move(Field<Indexes>::Get(row))), 0) ... );
+                }
+                catch (...)
+                {
+                    Shrink(seq);
+                    throw;
+                }
+            }
+
+            template <std::size_t ... Indexes>
+            void Copy(std::size_t index, T &row, Common::IndexSequence<Indexes ... > const *) const
+            {
+                Common::Unused(index, row);
+                Common::Unused((Field<Indexes>::Get(row) = std::get<Indexes>(m_columns)[index]) ... );
+            }
+
+            template <std::size_t ... Indexes>
+            void Put(std::size_t index, T const &row, Common::IndexSequence<Indexes ... > const *)
+            {
+                Common::Unused(index, row);
+                Common::Unused((std::get<Indexes>(m_columns)[index] = Field<Indexes>::Get(row)) ... );
+            }
+
+            template <std::size_t ... Indexes>
+            void Put(std::size_t index, T &&row, Common::IndexSequence<Indexes ... > const *)
+            {
+                Common::Unused(index, row);
+                Common::Unused((std::get<Indexes>(m_columns)[index] = std::move(Field<Indexes>::Get(row))) ... );
+            }
+        };
+
+    }   // namespace Reflection
+}   // namespace Mif
+
+#endif  // !__MIF_REFLECTION_SOA_VECTOR_H__
@@ -0,0 +1,73 @@
+//-------------------------------------------------------------------
+//  MetaInfo Framework (MIF)
+//  https://github.com/tdv/mif
+//  Created:     10.2026
+//  Copyright (C) 2016-2024 tdv
+//-------------------------------------------------------------------
+
+#ifndef __MIF_REMOTE_DEADLINE_H__
+#define __MIF_REMOTE_DEADLINE_H__
+
+// STD
+#include <chrono>
+
+// MIF
+#include "mif/remote/detail/deadline.h"
+#include "mif/remote/detail/iproxy_control.h"
+#include "mif/service/iservice.h"
+
+namespace Mif
+{
+    namespace Remote
+    {
+
+        // Limits all remote calls made by the current thread within the scope.
+        // The nested scopes can only shorten the deadline. The deadline is sent
+        // with the request, the remote side rejects the requests which have expired
+        // before being processed and passes the deadline to the nested remote calls.
+        // Peers are expected to have synchronized clocks.
+        class Deadline final
+        {
+        public:
+            explicit Deadline(std::chrono::microseconds const &timeout)
+                : m_scope{Detail::GetCurrentTime() + timeout.count()}
+            {
+            }
+
+            Deadline(Deadline const &) = delete;
+            Deadline& operator = (Deadline const &) = delete;
+            Deadline(Deadline &&) = delete;
+            Deadline& operator = (Deadline &&) = delete;
+
+            // Can be used by a long-running method of the service in order to stop in time.
+            static bool IsExpired()
+            {
+                return Detail::IsExpiredDeadline(Detail::GetThreadDeadline());
+            }
+
+        private:
+            Detail::DeadlineScope m_scope;
+        };
+
+        // Timeout of every call made through the proxy. Zero means the client-wide timeout only.
+        template <typename T>
+        inline void SetCallTimeout(Service::TIntrusivePtr<T> const &service,
+                std::chrono::microseconds const &timeout)
+        {
+            auto &control = Detail::GetProxyControl(service, "[Mif::Remote::SetCallTimeout]");
+            control.SetCallTimeout(timeout);
+        }
+
+        // Stops waiting for the results of all calls made through the proxy
+        // at the moment. The waiting calls throw an exception.
+        template <typename T>
+        inline void CancelCalls(Service::TIntrusivePtr<T> const &service)
+        {
+            auto &control = Detail::GetProxyControl(service, "[Mif::Remote::CancelCalls]");
+            control.CancelCalls();
+        }
+
+    }   // namespace Remote
+}   // namespace Mif
+
+#endif  // !__MIF_REMOTE_DEADLINE_H__
@@ -0,0 +1,177 @@
+//-------------------------------------------------------------------
+//  MetaInfo Framework (MIF)
+//  https://github.com/tdv/mif
+//  Created:     10.2026
+//  Copyright (C) 2016-2024 tdv
+//-------------------------------------------------------------------
+
+#ifndef __MIF_REMOTE_DETAIL_DEADLINE_H__
+#define __MIF_REMOTE_DETAIL_DEADLINE_H__
+
+// STD
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+
+namespace Mif
+{
+    namespace Remote
+    {
+        namespace Detail
+        {
+
+            // All deadlines are absolute time points in microseconds since epoch (system clock)
+            // in order to be passed between the processes. Zero means no deadline.
+            inline std::int64_t GetCurrentTime()
+            {
+                return std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count();
+            }
+
+            inline std::int64_t& GetThreadDeadline()
+            {
+                static thread_local std::int64_t deadline = 0;
+                return deadline;
+            }
+
+            inline std::int64_t GetNearestDeadline(std::int64_t first, std::int64_t second)
+            {
+                if (!first)
+                    return second;
+                if (!second)
+                    return first;
+                return first < second ? first : second;
+            }
+
+            inline bool IsExpiredDeadline(std::int64_t deadline)
+            {
+                return deadline && GetCurrentTime() >= deadline;
+            }
+
+            class DeadlineScope final
+            {
+            public:
+                DeadlineScope(std::int64_t deadline, bool inherit = true)
+                    : m_prev{GetThreadDeadline()}
+                {
+                    GetThreadDeadline() = inherit ? GetNearestDeadline(m_prev, deadline) : deadline;
+                }
+
+                ~DeadlineScope()
+                {
+                    GetThreadDeadline() = m_prev;
+                }
+
+                DeadlineScope(DeadlineScope const &) = delete;
+                DeadlineScope& operator = (DeadlineScope const &) = delete;
+                DeadlineScope(DeadlineScope &&) = delete;
+                DeadlineScope& operator = (DeadlineScope &&) = delete;
+
+            private:
+                std::int64_t const m_prev;
+            };
+
+            // Cancels the calls made before Cancel. The waiting calls subscribe in order to be
+            // woken up by Cancel instead of checking it periodically.
+            class Cancellation final
+            {
+            public:
+                using Handler = std::function<void ()>;
+
+                class Subscription final
+                {
+                public:
+                    Subscription(Cancellation *cancellation, Handler handler)
+                        : m_cancellation{cancellation}
+                        , m_id{cancellation ? cancellation->Subscribe(std::move(handler)) : 0}
+                    {
+                    }
+
+                    ~Subscription()
+                    {
+                        if (m_cancellation)
+                            m_cancellation->Unsubscribe(m_id);
+                    }
+
+                    Subscription(Subscription const &) = delete;
+                    Subscription& operator = (Subscription const &) = delete;
+                    Subscription(Subscription &&) = delete;
+                    Subscription& operator = (Subscription &&) = delete;
+
+                private:
+                    Cancellation *m_cancellation;
+                    std::uint64_t const m_id;
+                };
+
+                Cancellation() = default;
+
+                Cancellation(Cancellation const &) = delete;
+                Cancellation& operator = (Cancellation const &) = delete;
+                Cancellation(Cancellation &&) = delete;
+                Cancellation& operator = (Cancellation &&) = delete;
+
+                std::uint64_t GetGeneration() const
+                {
+                    return m_generation;
+                }
+
+                bool IsCancelled(std::uint64_t generation) const
+                {
+                    return m_generation != generation;
+                }
+
+                // The handlers are called under the lock, so a handler is not called after
+                // its subscription is destroyed.
+                void Cancel()
+                {
+                    LockGuard lock{m_lock};
+                    ++m_generation;
+                    for (auto const &i : m_handlers)
+                        i.second();
+                }
+
+            private:
+                using LockType = std::mutex;
+                using LockGuard = std::lock_guard<LockType>;
+
+                std::atomic<std::uint64_t> m_generation{0};
+
+                LockType m_lock;
+                std::uint64_t m_nextId = 0;
+                std::map<std::uint64_t, Handler> m_handlers;
+
+                std::uint64_t Subscribe(Handler handler)
+                {
+                    LockGuard lock{m_lock};
+                    auto const id = ++m_nextId;
+                    m_handlers.insert(std::make_pair(id, std::move(handler)));
+                    return id;
+                }
+
+                void Unsubscribe(std::uint64_t id)
+                {
+                    LockGuard lock{m_lock};
+                    m_handlers.erase(id);
+                }
+            };
+
+            struct CallContext final
+            {
+                std::int64_t deadline = 0;
+                Cancellation *cancellation = nullptr;
+                std::uint64_t generation = 0;
+
+                bool IsCancelled() const
+                {
+                    return cancellation && cancellation->IsCancelled(generation);
+                }
+            };
+
+        }   // namespace Detail
+    }   // namespace Remote
+}   // namespace Mif
+
+#endif  // !__MIF_REMOTE_DETAIL_DEADLINE_H__
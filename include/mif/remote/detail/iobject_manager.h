@@ -10,6 +10,7 @@
 
 // STD
 #include <string>
+#include <vector>
 
 // MIF
 #include "mif/service/iservice.h"
@@ -26,7 +27,10 @@ namespace Mif
             {
                 virtual ~IObjectManager() = default;
                 virtual std::string CreateObject(Service::ServiceId serviceId, std::string const &interfaceId) = 0;
+                virtual void CreateObjectWithId(Service::ServiceId serviceId, std::string const &interfaceId,
+                        std::string const &instanceId) = 0;
                 virtual void DestroyObject(std::string const &instanceId) = 0;
+                virtual void DestroyObjects(std::vector<std::string> const &instanceIds) = 0;
                 virtual std::string QueryInterface(std::string const &instanceId, std::string const &interfaceId,
                         std::string const &serviceId) = 0;
                 virtual std::string CloneReference(std::string const &instanceId, std::string const &interfaceId) = 0;
@@ -0,0 +1,53 @@
+//-------------------------------------------------------------------
+//  MetaInfo Framework (MIF)
+//  https://github.com/tdv/mif
+//  Created:     10.2026
+//  Copyright (C) 2016-2024 tdv
+//-------------------------------------------------------------------
+
+#ifndef __MIF_REMOTE_DETAIL_IPROXY_CONTROL_H__
+#define __MIF_REMOTE_DETAIL_IPROXY_CONTROL_H__
+
+// STD
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
+// MIF
+#include "mif/remote/detail/result_cache.h"
+#include "mif/service/iservice.h"
+
+namespace Mif
+{
+    namespace Remote
+    {
+        namespace Detail
+        {
+
+            struct IProxyControl
+            {
+                virtual ~IProxyControl() = default;
+                virtual void SetResultCache(ResultCachePtr cache) = 0;
+                virtual ResultCachePtr GetResultCache() const = 0;
+                virtual void SetCallTimeout(std::chrono::microseconds const &timeout) = 0;
+                virtual void CancelCalls() = 0;
+            };
+
+            template <typename T>
+            inline IProxyControl& GetProxyControl(Service::TIntrusivePtr<T> const &service, char const *caller)
+            {
+                if (!service)
+                    throw std::invalid_argument{std::string{caller} + " Empty service pointer."};
+
+                auto *control = dynamic_cast<IProxyControl *>(service.get());
+                if (!control)
+                    throw std::invalid_argument{std::string{caller} + " The service is not a remote object proxy."};
+
+                return *control;
+            }
+
+        }   // namespace Detail
+    }   // namespace Remote
+}   // namespace Mif
+
+#endif  // !__MIF_REMOTE_DETAIL_IPROXY_CONTROL_H__
@@ -25,7 +25,9 @@ namespace Mif
 
                 MIF_REMOTE_PS_BEGIN(IObjectManager)
                     MIF_REMOTE_METHOD(CreateObject)
+                    MIF_REMOTE_METHOD(CreateObjectWithId)
                     MIF_REMOTE_METHOD(DestroyObject)
+                    MIF_REMOTE_METHOD(DestroyObjects)
                     MIF_REMOTE_METHOD(QueryInterface)
                     MIF_REMOTE_METHOD(CloneReference)
                 MIF_REMOTE_PS_END()
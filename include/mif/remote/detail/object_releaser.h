@@ -0,0 +1,274 @@
+//-------------------------------------------------------------------
+//  MetaInfo Framework (MIF)
+//  https://github.com/tdv/mif
+//  Created:     10.2026
+//  Copyright (C) 2016-2024 tdv
+//-------------------------------------------------------------------
+
+#ifndef __MIF_REMOTE_DETAIL_OBJECT_RELEASER_H__
+#define __MIF_REMOTE_DETAIL_OBJECT_RELEASER_H__
+
+// STD
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// MIF
+#include "mif/common/log.h"
+#include "mif/remote/detail/iobject_manager.h"
+#include "mif/service/iservice.h"
+
+namespace Mif
+{
+    namespace Remote
+    {
+        namespace Detail
+        {
+
+            // Decorator of the remote object manager. DestroyObject doesn't wait for
+            // the remote side, the instance ids are accumulated and sent in one
+            // DestroyObjects call. The batches of all the connections are sent by one
+            // worker thread shared by the process, which is started with the first
+            // release. The ids released while a batch is in flight go to the next batch.
+            // Stop, which the owner of the connection calls when the connection is
+            // closed, waits for the batch in flight. The ids left after Stop are dropped.
+            class ObjectReleaser
+                : public Service::Inherit<IObjectManager>
+            {
+            public:
+                ObjectReleaser(IObjectManagerPtr manager)
+                    : m_queue{std::make_shared<Queue>()}
+                {
+                    if (!manager)
+                        throw std::invalid_argument{"[Mif::Remote::Detail::ObjectReleaser] Empty object manager."};
+                    m_queue->manager = std::move(manager);
+                }
+
+                ~ObjectReleaser()
+                {
+                    Stop();
+                }
+
+                void Stop()
+                {
+                    std::unique_lock<LockType> lock{m_queue->lock};
+                    m_queue->stopped = true;
+                    m_queue->ids.clear();
+
+                    // The connection can be closed by the batch being sent. The worker
+                    // holds only the queue and skips it after the batch.
+                    if (m_queue->sender == std::this_thread::get_id())
+                        return;
+
+                    m_queue->condVar.wait(lock, [this] { return m_queue->sender == std::thread::id{}; });
+                }
+
+            private:
+                using LockType = std::mutex;
+                using LockGuard = std::lock_guard<LockType>;
+
+                using InstanceIds = std::vector<std::string>;
+
+                struct Queue final
+                {
+                    IObjectManagerPtr manager;
+                    LockType lock;
+                    std::condition_variable condVar;
+                    InstanceIds ids;
+                    bool stopped = false;
+                    bool scheduled = false;
+                    std::thread::id sender;
+                };
+
+                using QueuePtr = std::shared_ptr<Queue>;
+
+                class Worker final
+                {
+                public:
+                    ~Worker()
+                    {
+                        {
+                            LockGuard lock{m_lock};
+                            m_stopped = true;
+                            m_queues.clear();
+                        }
+
+                        m_condVar.notify_all();
+
+                        if (!m_thread.joinable())
+                            return;
+
+                        try
+                        {
+                            m_thread.join();
+                        }
+                        catch (std::exception const &e)
+                        {
+                            MIF_LOG(Warning) << "[Mif::Remote::Detail::ObjectReleaser::Worker::~Worker] "
+                                << "Failed to join the worker. Error: " << e.what();
+                        }
+                    }
+
+                    static Worker& Get()
+                    {
+                        static Worker worker;
+                        return worker;
+                    }
+
+                    // Throws if the thread can't be started.
+                    void Post(QueuePtr queue)
+                    {
+                        {
+                            LockGuard lock{m_lock};
+                            if (m_stopped)
+                                throw std::runtime_error{"[Mif::Remote::Detail::ObjectReleaser::Worker::Post] The worker is stopped."};
+                            if (!m_thread.joinable())
+                                m_thread = std::thread{&Worker::Run, this};
+                            m_queues.push_back(std::move(queue));
+                        }
+
+                        m_condVar.notify_one();
+                    }
+
+                private:
+                    LockType m_lock;
+                    std::condition_variable m_condVar;
+                    std::deque<QueuePtr> m_queues;
+                    bool m_stopped = false;
+                    std::thread m_thread;
+
+                    Worker() = default;
+
+                    void Run()
+                    {
+                        for (;;)
+                        {
+                            QueuePtr queue;
+
+                            {
+                                std::unique_lock<LockType> lock{m_lock};
+                                m_condVar.wait(lock, [this] { return m_stopped || !m_queues.empty(); });
+                                if (m_stopped)
+                                    return;
+                                queue = std::move(m_queues.front());
+                                m_queues.pop_front();
+                            }
+
+                            InstanceIds ids;
+
+                            {
+                                LockGuard lock{queue->lock};
+                                queue->scheduled = false;
+                                if (queue->stopped)
+                                    continue;
+                                ids.swap(queue->ids);
+                                queue->sender = std::this_thread::get_id();
+                            }
+
+                            Send(*queue, ids);
+
+                            {
+                                LockGuard lock{queue->lock};
+                                queue->sender = std::thread::id{};
+                            }
+
+                            queue->condVar.notify_all();
+                        }
+                    }
+                };
+
+                QueuePtr m_queue;
+
+                static void Send(Queue &queue, InstanceIds const &ids)
+                {
+                    try
+                    {
+                        queue.manager->DestroyObjects(ids);
+                    }
+                    catch (std::exception const &e)
+                    {
+                        MIF_LOG(Warning) << "[Mif::Remote::Detail::ObjectReleaser::Send] "
+                            << "Failed to destroy " << ids.size() << " object(s). Error: " << e.what();
+                    }
+                }
+
+                // IObjectManager
+                virtual std::string CreateObject(Service::ServiceId serviceId, std::string const &interfaceId) override final
+                {
+                    return m_queue->manager->CreateObject(serviceId, interfaceId);
+                }
+
+                virtual void CreateObjectWithId(Service::ServiceId serviceId, std::string const &interfaceId,
+                        std::string const &instanceId) override final
+                {
+                    m_queue->manager->CreateObjectWithId(serviceId, interfaceId, instanceId);
+                }
+
+                virtual void DestroyObject(std::string const &instanceId) override final
+                {
+                    {
+                        LockGuard lock{m_queue->lock};
+                        if (m_queue->stopped)
+                            return;
+
+                        m_queue->ids.push_back(instanceId);
+
+                        if (m_queue->scheduled)
+                            return;
+
+                        m_queue->scheduled = true;
+                    }
+
+                    try
+                    {
+                        Worker::Get().Post(m_queue);
+                        return;
+                    }
+                    catch (std::exception const &e)
+                    {
+                        MIF_LOG(Warning) << "[Mif::Remote::Detail::ObjectReleaser::DestroyObject] "
+                            << "Failed to post the release to the worker. The objects are released synchronously. "
+                            << "Error: " << e.what();
+                    }
+
+                    InstanceIds ids;
+
+                    {
+                        LockGuard lock{m_queue->lock};
+                        m_queue->scheduled = false;
+                        ids.swap(m_queue->ids);
+                    }
+
+                    if (!ids.empty())
+                        Send(*m_queue, ids);
+                }
+
+                virtual void DestroyObjects(std::vector<std::string> const &instanceIds) override final
+                {
+                    m_queue->manager->DestroyObjects(instanceIds);
+                }
+
+                virtual std::string QueryInterface(std::string const &instanceId, std::string const &interfaceId,
+                        std::string const &serviceId) override final
+                {
+                    return m_queue->manager->QueryInterface(instanceId, interfaceId, serviceId);
+                }
+
+                virtual std::string CloneReference(std::string const &instanceId, std::string const &interfaceId) override final
+                {
+                    return m_queue->manager->CloneReference(instanceId, interfaceId);
+                }
+            };
+
+        }   // namespace Detail
+    }   // namespace Remote
+}   // namespace Mif
+
+#endif  // !__MIF_REMOTE_DETAIL_OBJECT_RELEASER_H__
@@ -10,9 +10,14 @@
 
 // STD
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <list>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <tuple>
@@ -28,8 +33,10 @@
 #include "mif/common/types.h"
 #include "mif/common/uuid_generator.h"
 #include "mif/common/unused.h"
+#include "mif/remote/detail/deadline.h"
 #include "mif/remote/detail/iobject_manager.h"
 #include "mif/remote/detail/registry.h"
+#include "mif/remote/detail/result_cache.h"
 #include "mif/remote/detail/type_traits.h"
 #include "mif/service/iservice.h"
 #include "mif/service/make.h"
@@ -97,12 +104,15 @@ namespace Mif
             };
 
             using StubCreator = std::function<std::string (Service::IServicePtr, std::string const &)>;
+            using StubReleaser = std::function<void (std::string const &)>;
 
+            // Releases the local stubs created for the interface parameters of a call
+            // when the call is completed. The remote side holds its own references.
             class ObjectCleaner final
             {
             public:
-                ObjectCleaner(Service::TIntrusivePtr<IObjectManager> manager)
-                    : m_manager{std::move(manager)}
+                ObjectCleaner(StubReleaser const &releaser)
+                    : m_releaser(releaser)
                 {
                 }
 
@@ -113,7 +123,7 @@ namespace Mif
 
                 ~ObjectCleaner()
                 {
-                    if (!m_manager)
+                    if (!m_releaser)
                         return;
 
                     std::for_each(std::begin(m_ids), std::end(m_ids),
@@ -121,12 +131,12 @@ namespace Mif
                             {
                                 try
                                 {
-                                    m_manager->DestroyObject(id);
+                                    m_releaser(id);
                                 }
                                 catch (std::exception const &e)
                                 {
                                     MIF_LOG(Warning) << "[Mif::Remote::Detail::ObjectCleaner::~ObjectCleaner] "
-                                                     << "Failed to call Destroy object for instance whith id \""
+                                                     << "Failed to release stub for instance whith id \""
                                                      << id << "\" Error: " << e.what();
                                 }
                             }
@@ -135,13 +145,11 @@ namespace Mif
 
                 void AppendId(std::string const &id)
                 {
-                    // TODO: uncomment it
-                    //m_ids.push_back(id);
-                    Common::Unused(id);
+                    m_ids.push_back(id);
                 }
 
             private:
-                Service::TIntrusivePtr<IObjectManager> m_manager;
+                StubReleaser const &m_releaser;
                 std::list<std::string> m_ids;
             };
 
@@ -153,23 +161,44 @@ namespace Mif
                 using Deserializer = typename TSerializer::Deserializer;
                 using DeserializerPtr = std::unique_ptr<Deserializer>;
 
-                using Sender = std::function<DeserializerPtr (std::string const &, Serializer &)>;
+                using Sender = std::function<DeserializerPtr (std::string const &, Serializer &, CallContext const &)>;
 
                 Proxy(IObjectManagerPtr manager, Service::ServiceId serviceId, std::string const &interfaceId,
-                        Sender && sender, StubCreator && stubCreator)
+                        Sender && sender, StubCreator && stubCreator, StubReleaser && stubReleaser)
                     : m_manager{manager}
                     , m_instance{m_manager->CreateObject(serviceId, interfaceId)}
                     , m_sender{std::move(sender)}
                     , m_stubCreator{std::move(stubCreator)}
+                    , m_stubReleaser{std::move(stubReleaser)}
                 {
                 }
 
                 Proxy(IObjectManagerPtr manager, std::string const &instance,
-                        Sender && sender, StubCreator && stubCreator)
+                        Sender && sender, StubCreator && stubCreator, StubReleaser && stubReleaser)
                     : m_manager{manager}
                     , m_instance{instance}
                     , m_sender{std::move(sender)}
-                    , m_stubCreator{stubCreator}
+                    , m_stubCreator{std::move(stubCreator)}
+                    , m_stubReleaser{std::move(stubReleaser)}
+                {
+                }
+
+                // The remote object is created with the given instance id by the first request
+                // made through the proxy, so there is no round trip for the creation. An empty
+                // interface id means the interface is not known yet (a proxy of IService given
+                // by a factory): the first cast makes the proxy of the needed interface which
+                // takes over the instance id, the next casts are forwarded to it.
+                Proxy(IObjectManagerPtr manager, Service::ServiceId serviceId, std::string const &interfaceId,
+                        std::string const &instance, Sender && sender, StubCreator && stubCreator,
+                        StubReleaser && stubReleaser)
+                    : m_manager{manager}
+                    , m_instance{instance}
+                    , m_sender{std::move(sender)}
+                    , m_stubCreator{std::move(stubCreator)}
+                    , m_stubReleaser{std::move(stubReleaser)}
+                    , m_serviceId{serviceId}
+                    , m_interfaceId{interfaceId}
+                    , m_deferred{true}
                 {
                 }
 
@@ -182,7 +211,8 @@ namespace Mif
 
                 virtual ~Proxy()
                 {
-                    if (m_manager)
+                    // The remote object doesn't exist if no request to create it was made.
+                    if (m_manager && (!m_deferred || m_creationRequested))
                     {
                         try
                         {
@@ -197,16 +227,270 @@ namespace Mif
                     }
                 }
 
-                template <typename TResult, typename ... TParams>
+                template <typename TResult, bool IsConst, typename ... TParams>
                 TResult RemoteCall(std::string const &interface, std::string const &method, TParams && ... params)
+                {
+                    // A non-const method may change the state of the remote object. The cache
+                    // is cleared once more after the call, so the results of the const calls
+                    // made concurrently with it are not kept.
+                    CacheInvalidator invalidator{IsConst ? ResultCachePtr{} : GetResultCache()};
+
+                    using IsCacheable = std::integral_constant
+                        <
+                            bool,
+                            IsConst && Traits::IsCacheableCall<TResult, TParams ... >()
+                        >;
+
+                    return CallMethod<TResult>(static_cast<IsCacheable const *>(nullptr),
+                            interface, method, std::forward<TParams>(params) ... );
+                }
+
+                bool QueryRemoteInterface(void **service, std::type_info const &typeInfo,
+                        std::string const &serviceId, Service::IService **holder)
+                {
+                    // The set of the remote object interfaces doesn't change, so the result
+                    // is resolved once and the proxy is shared by all next queries.
+                    QueryKey key{std::type_index{typeInfo}, serviceId};
+
+                    Service::IServicePtr target;
+
+                    {
+                        LockGuard lock{m_queryLock};
+                        auto iter = m_queries.find(key);
+                        if (iter != std::end(m_queries))
+                            return GetQueryResult(iter->second, service, holder);
+
+                        if (m_deferred && m_interfaceId.empty())
+                        {
+                            if (!m_target)
+                                return CreateTarget(std::move(key), typeInfo, service, holder);
+                            target = m_target;
+                        }
+                    }
+
+                    if (target)
+                    {
+                        auto *proxy = dynamic_cast<Service::Detail::IProxyBase_Mif_Remote_ *>(target.get());
+                        return proxy && proxy->_Mif_Remote_QueryRemoteInterface(service, typeInfo, serviceId, holder);
+                    }
+
+                    CreateDeferred();
+
+                    QueryResult result;
+                    Service::IService *newHolder = nullptr;
+                    if (Registry::Visitor::Accept<CreateProxyVisitor>(m_manager, m_instance,
+                            static_cast<Sender const &>(m_sender), static_cast<StubCreator const &>(m_stubCreator),
+                            static_cast<StubReleaser const &>(m_stubReleaser),
+                            &result.service, std::type_index{typeInfo}, serviceId, &newHolder))
+                    {
+                        // Takes the reference added for the caller.
+                        result.holder = Service::IServicePtr{newHolder, false};
+                    }
+
+                    {
+                        LockGuard lock{m_queryLock};
+                        auto const &cached = m_queries.insert(std::make_pair(std::move(key), std::move(result))).first->second;
+                        return GetQueryResult(cached, service, holder);
+                    }
+                }
+
+                void SetResultCache(ResultCachePtr cache)
+                {
+                    std::atomic_store(&m_resultCache, std::move(cache));
+                }
+
+                ResultCachePtr GetResultCache() const
+                {
+                    return std::atomic_load(&m_resultCache);
+                }
+
+                void SetCallTimeout(std::chrono::microseconds const &timeout)
+                {
+                    m_callTimeout = timeout.count();
+                }
+
+                void CancelCalls()
+                {
+                    m_cancellation.Cancel();
+                }
+
+            private:
+                using LockType = std::mutex;
+                using LockGuard = std::lock_guard<LockType>;
+
+                // Clears the cache before and after the call, whether it throws or not.
+                class CacheInvalidator final
+                {
+                public:
+                    CacheInvalidator(ResultCachePtr cache)
+                        : m_cache{std::move(cache)}
+                    {
+                        if (m_cache)
+                            m_cache->Clear();
+                    }
+
+                    CacheInvalidator(CacheInvalidator const &) = delete;
+                    CacheInvalidator& operator = (CacheInvalidator const &) = delete;
+
+                    ~CacheInvalidator()
+                    {
+                        if (m_cache)
+                            m_cache->Clear();
+                    }
+
+                private:
+                    ResultCachePtr m_cache;
+                };
+
+                using QueryKey = std::pair<std::type_index, std::string/*service id*/>;
+
+                struct QueryResult
+                {
+                    void *service = nullptr;
+                    Service::IServicePtr holder;
+                };
+
+                using QueryResults = std::map<QueryKey, QueryResult>;
+
+                Common::UuidGenerator m_generator;
+                IObjectManagerPtr m_manager;
+                std::string m_instance;
+                Sender m_sender;
+                StubCreator m_stubCreator;
+                StubReleaser m_stubReleaser;
+                ResultCachePtr m_resultCache;
+                std::atomic<std::int64_t> m_callTimeout{0};
+                Cancellation m_cancellation;
+                LockType m_queryLock;
+                QueryResults m_queries;
+                Service::ServiceId m_serviceId = 0;
+                std::string m_interfaceId;
+                std::atomic<bool> m_deferred{false};
+                std::atomic<bool> m_creationRequested{false};
+                Service::IServicePtr m_target;
+
+                bool CreateTarget(QueryKey key, std::type_info const &typeInfo, void **service,
+                        Service::IService **holder)
+                {
+                    if (!key.second.empty())
+                    {
+                        throw ProxyStubException{"[Mif::Remote::Proxy::QueryRemoteInterface] "
+                            "Failed to query service \"" + key.second + "\" from a lazily created object. "
+                            "It must be cast to its interface first."};
+                    }
+
+                    QueryResult result;
+                    Service::IService *newHolder = nullptr;
+                    if (Registry::Visitor::Accept<CreateDeferredProxyVisitor>(m_manager, m_serviceId, m_instance,
+                            static_cast<Sender const &>(m_sender), static_cast<StubCreator const &>(m_stubCreator),
+                            static_cast<StubReleaser const &>(m_stubReleaser),
+                            &result.service, std::type_index{typeInfo}, &newHolder))
+                    {
+                        result.holder = Service::IServicePtr{newHolder, false};
+                        m_target = result.holder;
+                    }
+
+                    auto const &cached = m_queries.insert(std::make_pair(std::move(key), std::move(result))).first->second;
+                    return GetQueryResult(cached, service, holder);
+                }
+
+                void CreateDeferred()
+                {
+                    if (!m_deferred)
+                        return;
+
+                    if (m_interfaceId.empty())
+                    {
+                        throw ProxyStubException{"[Mif::Remote::Proxy::CreateDeferred] "
+                            "The interface of the lazily created object is not known."};
+                    }
+
+                    m_creationRequested = true;
+                    m_manager->CreateObjectWithId(m_serviceId, m_interfaceId, m_instance);
+                    m_deferred = false;
+                }
+
+                static bool GetQueryResult(QueryResult const &result, void **service, Service::IService **holder)
+                {
+                    if (!result.holder)
+                        return false;
+
+                    *service = result.service;
+                    (*holder = result.holder.get())->AddRef();
+
+                    return true;
+                }
+
+                CallContext MakeCallContext()
+                {
+                    CallContext context;
+
+                    auto const timeout = m_callTimeout.load();
+                    context.deadline = GetNearestDeadline(GetThreadDeadline(),
+                            timeout ? GetCurrentTime() + timeout : 0);
+
+                    context.cancellation = &m_cancellation;
+                    context.generation = m_cancellation.GetGeneration();
+
+                    return context;
+                }
+
+                template <typename TResult, typename ... TParams>
+                TResult CallMethod(std::false_type const *, std::string const &interface,
+                        std::string const &method, TParams && ... params)
+                {
+                    return Invoke<TResult>(interface, method, std::forward<TParams>(params) ... );
+                }
+
+                template <typename TResult, typename ... TParams>
+                TResult CallMethod(std::true_type const *, std::string const &interface,
+                        std::string const &method, TParams && ... params)
+                {
+                    auto cache = GetResultCache();
+                    if (!cache)
+                        return Invoke<TResult>(interface, method, std::forward<TParams>(params) ... );
+
+                    std::string key;
+
+                    {
+                        Serializer serializer(true, std::string{}, m_instance, interface, method, params ... );
+                        auto const buffer = serializer.GetBuffer();
+                        key.assign(std::begin(buffer), std::end(buffer));
+                    }
+
+                    if (auto const result = cache->template Find<TResult>(key))
+                        return *result;
+
+                    auto const generation = cache->GetGeneration();
+                    auto result = Invoke<TResult>(interface, method, std::forward<TParams>(params) ... );
+                    cache->Put(key, result, generation);
+
+                    return result;
+                }
+
+                template <typename TResult, typename ... TParams>
+                TResult Invoke(std::string const &interface, std::string const &method, TParams && ... params)
                 {
                     try
                     {
+                        auto const context = MakeCallContext();
+                        if (IsExpiredDeadline(context.deadline))
+                            throw ProxyStubException{"[Mif::Remote::Proxy::RemoteCall] Deadline expired before sending the request."};
+
                         auto const requestId = m_generator.Generate();
-                        ObjectCleaner cleaner{m_manager};
+                        ObjectCleaner cleaner{m_stubReleaser};
                         Serializer serializer(true, requestId, m_instance, interface, method,
                                 PrepareParam(std::forward<TParams>(params), cleaner) ... );
-                        auto deserializer = m_sender(requestId, serializer);
+                        serializer.SetDeadline(context.deadline);
+                        // Every request carries the creation until one of them is completed.
+                        // The remote side creates the object once.
+                        auto const deferred = m_deferred.load();
+                        if (deferred)
+                        {
+                            serializer.SetCreation(m_serviceId, m_interfaceId);
+                            m_creationRequested = true;
+                        }
+                        auto deserializer = m_sender(requestId, serializer, context);
                         if (!deserializer->IsResponse())
                             throw ProxyStubException{"[Mif::Remote::Proxy::RemoteCall] Bad response type \"" + deserializer->GetType() + "\""};
                         auto const &instance = deserializer->GetInstance();
@@ -232,6 +516,9 @@ namespace Mif
                         if (deserializer->HasException())
                             std::rethrow_exception(deserializer->GetException());
 
+                        if (deferred)
+                            m_deferred = false;
+
                         return ExtractResult<TResult>(*deserializer);
                     }
                     catch (std::exception const &e)
@@ -242,21 +529,6 @@ namespace Mif
                     }
                 }
 
-                bool QueryRemoteInterface(void **service, std::type_info const &typeInfo,
-                        std::string const &serviceId, Service::IService **holder)
-                {
-                    return Registry::Visitor::Accept<CreateProxyVisitor>(m_manager, m_instance,
-                            static_cast<Sender const &>(m_sender), static_cast<StubCreator const &>(m_stubCreator),
-                            service, std::type_index{typeInfo}, serviceId, holder);
-                }
-
-            private:
-                Common::UuidGenerator m_generator;
-                IObjectManagerPtr m_manager;
-                std::string m_instance;
-                Sender m_sender;
-                StubCreator m_stubCreator;
-
                 template <typename TResult>
                 typename std::enable_if
                     <
@@ -284,9 +556,10 @@ namespace Mif
 
                     Sender sender{m_sender};
                     StubCreator stubCreator{m_stubCreator};
+                    StubReleaser stubReleaser{m_stubReleaser};
 
                     return Service::Make<ProxyType, InterfaceType>(m_manager, instanceId,
-                            std::move(sender), std::move(stubCreator));
+                            std::move(sender), std::move(stubCreator), std::move(stubReleaser));
                 }
 
                 template <typename TResult>
@@ -314,7 +587,7 @@ namespace Mif
                     template <typename T>
                     static Result Visit(IObjectManagerPtr manager, std::string const &instance,
                             Sender const &sender, StubCreator const &stubCreator,
-                            void **service, std::type_index const &typeId,
+                            StubReleaser const &stubReleaser, void **service, std::type_index const &typeId,
                             std::string const &serviceId, Service::IService **holder)
                      {
                          using InterfaceType = typename T::InterfaceType;
@@ -326,8 +599,9 @@ namespace Mif
                                  return false;
                              Sender newSender{sender};
                              StubCreator newStubCreator{stubCreator};
+                             StubReleaser newStubReleaser{stubReleaser};
                              auto proxy = Service::Make<ProxyType, InterfaceType>(manager, instanceId,
-                                     std::move(newSender), std::move(newStubCreator));
+                                     std::move(newSender), std::move(newStubCreator), std::move(newStubReleaser));
                              *service = proxy.get();
                              (*holder = proxy->template Cast<Service::IService>().get())->AddRef();
                              return true;
@@ -337,6 +611,34 @@ namespace Mif
                      }
                 };
 
+                struct CreateDeferredProxyVisitor
+                {
+                    using Serializer = TSerializer;
+                    using Result = bool;
+
+                    template <typename T>
+                    static Result Visit(IObjectManagerPtr manager, Service::ServiceId serviceId,
+                            std::string const &instance, Sender const &sender, StubCreator const &stubCreator,
+                            StubReleaser const &stubReleaser, void **service, std::type_index const &typeId,
+                            Service::IService **holder)
+                    {
+                        using InterfaceType = typename T::InterfaceType;
+                        using ProxyType = typename T::Proxy;
+                        if (std::type_index{typeid(InterfaceType)} != typeId)
+                            return false;
+
+                        Sender newSender{sender};
+                        StubCreator newStubCreator{stubCreator};
+                        StubReleaser newStubReleaser{stubReleaser};
+                        auto proxy = Service::Make<ProxyType, InterfaceType>(manager, serviceId,
+                                std::string{T::InterfaceId}, instance, std::move(newSender),
+                                std::move(newStubCreator), std::move(newStubReleaser));
+                        *service = proxy.get();
+                        (*holder = proxy->template Cast<Service::IService>().get())->AddRef();
+                        return true;
+                    }
+                };
+
                 // Specialization for all types that are not inherited from IService and not IService
                 template <typename T>
                 typename std::enable_if<Traits::IsNotInterface<T>(), T>::type &&
@@ -418,11 +720,12 @@ namespace Mif
 
                 Stub(Service::IServicePtr instance, std::string const &instanceId,
                         Service::TIntrusivePtr<IObjectManager> manager,
-                        StubCreator && stubCreator, Sender && sender)
+                        StubCreator && stubCreator, StubReleaser && stubReleaser, Sender && sender)
                     : m_instance{instance}
                     , m_instanceId{instanceId}
                     , m_manager{manager}
                     , m_stubCreator(std::move(stubCreator))
+                    , m_stubReleaser(std::move(stubReleaser))
                     , m_sender{std::move(sender)}
                 {
                 }
@@ -467,6 +770,7 @@ namespace Mif
                 std::string m_instanceId;
                 Service::TIntrusivePtr<IObjectManager> m_manager;
                 StubCreator m_stubCreator;
+                StubReleaser m_stubReleaser;
                 Sender m_sender;
                 using Services = std::list<Service::IServicePtr>;
 
@@ -569,12 +873,15 @@ namespace Mif
                     if (param.empty())
                         return {};
                     StubCreator stubCreator{m_stubCreator};
+                    StubReleaser stubReleaser{m_stubReleaser};
                     Sender sender{m_sender};
                     using InterfaceType = typename Traits::ExtractType<T>::element_type;
                     using PSType = typename Registry::Registry<InterfaceType>::template Type<TSerializer>;
                     auto const instanceId = m_manager->CloneReference(param, PSType::InterfaceId);
                     using ProxyType = typename PSType::Proxy;
-                    auto instance = Service::Make<ProxyType>(instanceId, std::move(sender), std::move(stubCreator));
+                    // The proxy owns the cloned reference and releases it when it is destroyed.
+                    auto instance = Service::Make<ProxyType>(m_manager, instanceId, std::move(sender),
+                            std::move(stubCreator), std::move(stubReleaser));
                     services.push_back(instance);
                     return instance->template Cast<InterfaceType>();
                 }
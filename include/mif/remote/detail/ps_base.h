@@ -9,12 +9,14 @@
 #define __MIF_REMOTE_DETAIL_PS_BASE_H__
 
 // STD
+#include <chrono>
 #include <string>
 #include <tuple>
 #include <typeinfo>
 #include <utility>
 
 // MIF
+#include "mif/remote/detail/iproxy_control.h"
 #include "mif/remote/detail/ps.h"
 #include "mif/remote/detail/registry.h"
 #include "mif/service/inherited_list.h"
@@ -50,6 +52,7 @@ namespace Mif
             class BaseProxies<TSerializer, TInterface, std::tuple<>>
                 : public Service::Inherit<TInterface>
                 , public Service::Detail::IProxyBase_Mif_Remote_
+                , public IProxyControl
             {
             protected:
                 template <typename ... TParams>
@@ -60,10 +63,10 @@ namespace Mif
 
                 virtual ~BaseProxies() = default;
 
-                template <typename TResult, typename ... TParams>
+                template <typename TResult, bool IsConst, typename ... TParams>
                 TResult _Mif_Remote_Call_Method(std::string const &interfaceId, std::string const &method, TParams && ... params) const
                 {
-                    return m_proxy.template RemoteCall<TResult>(interfaceId, method, std::forward<TParams>(params) ... );
+                    return m_proxy.template RemoteCall<TResult, IsConst>(interfaceId, method, std::forward<TParams>(params) ... );
                 }
 
             private:
@@ -76,6 +79,27 @@ namespace Mif
                 {
                     return m_proxy.QueryRemoteInterface(service, typeInfo, serviceId, holder);
                 }
+
+                // IProxyControl
+                virtual void SetResultCache(ResultCachePtr cache) override final
+                {
+                    m_proxy.SetResultCache(std::move(cache));
+                }
+
+                virtual ResultCachePtr GetResultCache() const override final
+                {
+                    return m_proxy.GetResultCache();
+                }
+
+                virtual void SetCallTimeout(std::chrono::microseconds const &timeout) override final
+                {
+                    m_proxy.SetCallTimeout(timeout);
+                }
+
+                virtual void CancelCalls() override final
+                {
+                    m_proxy.CancelCalls();
+                }
             };
 
             template <typename TSerializer, typename T>
@@ -0,0 +1,151 @@
+//-------------------------------------------------------------------
+//  MetaInfo Framework (MIF)
+//  https://github.com/tdv/mif
+//  Created:     10.2026
+//  Copyright (C) 2016-2024 tdv
+//-------------------------------------------------------------------
+
+#ifndef __MIF_REMOTE_DETAIL_RESULT_CACHE_H__
+#define __MIF_REMOTE_DETAIL_RESULT_CACHE_H__
+
+// STD
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace Mif
+{
+    namespace Remote
+    {
+        namespace Detail
+        {
+
+            // Cache of the const remote method results. The key is the serialized call
+            // (instance, interface, method and parameters), the value is the type-erased result.
+            class ResultCache final
+            {
+            public:
+                ResultCache(std::chrono::microseconds const &ttl, std::size_t maxItems)
+                    : m_ttl{ttl}
+                    , m_maxItems{maxItems}
+                {
+                    if (!m_maxItems)
+                        throw std::invalid_argument{"[Mif::Remote::Detail::ResultCache] Parameter \"maxItems\" must be greater than zero."};
+                }
+
+                ResultCache(ResultCache const &) = delete;
+                ResultCache& operator = (ResultCache const &) = delete;
+                ResultCache(ResultCache &&) = delete;
+                ResultCache& operator = (ResultCache &&) = delete;
+
+                template <typename T>
+                std::shared_ptr<T const> Find(std::string const &key)
+                {
+                    LockGuard lock{m_lock};
+
+                    auto iter = m_items.find(key);
+                    if (iter == std::end(m_items))
+                        return {};
+
+                    if (iter->second.expires < Clock::now())
+                    {
+                        m_order.erase(iter->second.order);
+                        m_items.erase(iter);
+                        return {};
+                    }
+
+                    m_order.splice(std::end(m_order), m_order, iter->second.order);
+
+                    return std::static_pointer_cast<T const>(iter->second.value);
+                }
+
+                template <typename T>
+                void Put(std::string const &key, T const &value, std::uint64_t generation)
+                {
+                    std::shared_ptr<void const> data = std::make_shared<T const>(value);
+
+                    LockGuard lock{m_lock};
+
+                    // The cache was invalidated while the result was on the way.
+                    if (generation != m_generation)
+                        return;
+
+                    auto const expires = Clock::now() + m_ttl;
+
+                    auto iter = m_items.find(key);
+                    if (iter != std::end(m_items))
+                    {
+                        iter->second.expires = expires;
+                        iter->second.value = std::move(data);
+                        m_order.splice(std::end(m_order), m_order, iter->second.order);
+                        return;
+                    }
+
+                    while (m_items.size() >= m_maxItems)
+                    {
+                        m_items.erase(m_order.front());
+                        m_order.pop_front();
+                    }
+
+                    auto order = m_order.insert(std::end(m_order), key);
+                    m_items.insert(std::make_pair(key, Item{expires, std::move(data), order}));
+                }
+
+                std::uint64_t GetGeneration() const
+                {
+                    LockGuard lock{m_lock};
+                    return m_generation;
+                }
+
+                void Clear()
+                {
+                    Items items;
+                    Order order;
+
+                    {
+                        LockGuard lock{m_lock};
+                        ++m_generation;
+                        m_items.swap(items);
+                        m_order.swap(order);
+                    }
+                }
+
+            private:
+                using Clock = std::chrono::steady_clock;
+
+                using LockType = std::mutex;
+                using LockGuard = std::lock_guard<LockType>;
+
+                using Order = std::list<std::string>;
+
+                struct Item
+                {
+                    Clock::time_point expires;
+                    std::shared_ptr<void const> value;
+                    Order::iterator order;
+                };
+
+                using Items = std::unordered_map<std::string, Item>;
+
+                std::chrono::microseconds const m_ttl;
+                std::size_t const m_maxItems;
+
+                mutable LockType m_lock;
+                std::uint64_t m_generation = 0;
+                Items m_items;
+                Order m_order;
+            };
+
+            using ResultCachePtr = std::shared_ptr<ResultCache>;
+
+        }   // namespace Detail
+    }   // namespace Remote
+}   // namespace Mif
+
+#endif  // !__MIF_REMOTE_DETAIL_RESULT_CACHE_H__
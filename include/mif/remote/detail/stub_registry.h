@@ -0,0 +1,181 @@
+//-------------------------------------------------------------------
+//  MetaInfo Framework (MIF)
+//  https://github.com/tdv/mif
+//  Created:     10.2026
+//  Copyright (C) 2016-2024 tdv
+//-------------------------------------------------------------------
+
+#ifndef __MIF_REMOTE_DETAIL_STUB_REGISTRY_H__
+#define __MIF_REMOTE_DETAIL_STUB_REGISTRY_H__
+
+// STD
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Mif
+{
+    namespace Remote
+    {
+        namespace Detail
+        {
+
+            // Stubs of a connection. The instance ids are decimal numbers unique within
+            // the connection. The table is split into shards by id, so the concurrent
+            // requests to different objects don't wait for each other. The upper half of
+            // the id range is given to the peer: it chooses the ids of the objects created
+            // lazily on its requests.
+            template <typename TStubPtr>
+            class StubRegistry final
+            {
+            public:
+                StubRegistry() = default;
+
+                StubRegistry(StubRegistry const &) = delete;
+                StubRegistry& operator = (StubRegistry const &) = delete;
+                StubRegistry(StubRegistry &&) = delete;
+                StubRegistry& operator = (StubRegistry &&) = delete;
+
+                std::string GenerateId()
+                {
+                    return std::to_string(++m_lastId);
+                }
+
+                // Id of a remote object which is created by the peer on the first request.
+                std::string GeneratePeerId()
+                {
+                    return std::to_string(PeerIdBase + ++m_lastPeerId);
+                }
+
+                static bool IsPeerId(std::string const &instanceId)
+                {
+                    InstanceId id = 0;
+                    return ParseId(instanceId, id) && id > PeerIdBase;
+                }
+
+                bool Insert(std::string const &instanceId, TStubPtr stub)
+                {
+                    InstanceId id = 0;
+                    if (!ParseId(instanceId, id))
+                        return false;
+
+                    auto &shard = GetShard(id);
+                    LockGuard lock{shard.lock};
+                    return shard.stubs.insert(std::make_pair(id, std::move(stub))).second;
+                }
+
+                TStubPtr Find(std::string const &instanceId) const
+                {
+                    InstanceId id = 0;
+                    if (!ParseId(instanceId, id))
+                        return {};
+
+                    auto const &shard = GetShard(id);
+                    LockGuard lock{shard.lock};
+                    auto iter = shard.stubs.find(id);
+                    return iter != std::end(shard.stubs) ? iter->second : TStubPtr{};
+                }
+
+                TStubPtr Remove(std::string const &instanceId)
+                {
+                    InstanceId id = 0;
+                    if (!ParseId(instanceId, id))
+                        return {};
+
+                    auto &shard = GetShard(id);
+                    LockGuard lock{shard.lock};
+                    auto iter = shard.stubs.find(id);
+                    if (iter == std::end(shard.stubs))
+                        return {};
+                    auto stub = std::move(iter->second);
+                    shard.stubs.erase(iter);
+                    return stub;
+                }
+
+                // Removes all stubs except the given one. The stubs are destroyed out of the locks.
+                void Clear(std::string const &keepInstanceId)
+                {
+                    InstanceId keep = 0;
+                    auto const hasKeep = ParseId(keepInstanceId, keep);
+
+                    std::vector<TStubPtr> stubs;
+
+                    for (auto &shard : m_shards)
+                    {
+                        LockGuard lock{shard.lock};
+                        for (auto i = std::begin(shard.stubs) ; i != std::end(shard.stubs) ; )
+                        {
+                            if (hasKeep && i->first == keep)
+                            {
+                                ++i;
+                                continue;
+                            }
+                            stubs.push_back(std::move(i->second));
+                            i = shard.stubs.erase(i);
+                        }
+                    }
+                }
+
+            private:
+                using InstanceId = std::uint64_t;
+
+                using LockType = std::mutex;
+                using LockGuard = std::lock_guard<LockType>;
+
+                struct Shard
+                {
+                    mutable LockType lock;
+                    std::unordered_map<InstanceId, TStubPtr> stubs;
+                };
+
+                static constexpr std::size_t ShardCount = 16;
+                static constexpr InstanceId PeerIdBase = InstanceId{1} << 63;
+
+                std::atomic<InstanceId> m_lastId{0};
+                std::atomic<InstanceId> m_lastPeerId{0};
+                std::array<Shard, ShardCount> m_shards;
+
+                Shard& GetShard(InstanceId id)
+                {
+                    return m_shards[id % ShardCount];
+                }
+
+                Shard const& GetShard(InstanceId id) const
+                {
+                    return m_shards[id % ShardCount];
+                }
+
+                // Only the canonical form is accepted (no sign, no leading zeros, no overflow),
+                // so each id has one string and a bad one is not mapped to another object.
+                static bool ParseId(std::string const &instanceId, InstanceId &id)
+                {
+                    if (instanceId.empty() || (instanceId.size() > 1 && instanceId[0] == '0'))
+                        return false;
+
+                    InstanceId value = 0;
+                    for (auto c : instanceId)
+                    {
+                        if (c < '0' || c > '9')
+                            return false;
+                        InstanceId const digit = c - '0';
+                        if (value > (std::numeric_limits<InstanceId>::max() - digit) / 10)
+                            return false;
+                        value = value * 10 + digit;
+                    }
+
+                    id = value;
+                    return true;
+                }
+            };
+
+        }   // namespace Detail
+    }   // namespace Remote
+}   // namespace Mif
+
+#endif  // !__MIF_REMOTE_DETAIL_STUB_REGISTRY_H__
@@ -99,6 +99,27 @@ namespace Mif
                             !IsTServicePtr<T>();
                 }
 
+                template <bool ... Values>
+                struct BoolPack;
+
+                template <typename ... T>
+                inline constexpr bool AreNotInterfaces()
+                {
+                    return std::is_same
+                        <
+                            BoolPack<true, IsNotInterface<T>() ... >,
+                            BoolPack<IsNotInterface<T>() ... , true>
+                        >::value;
+                }
+
+                template <typename TResult, typename ... TParams>
+                inline constexpr bool IsCacheableCall()
+                {
+                    return !std::is_same<TResult, void>::value &&
+                            IsNotInterfaceValue<TResult>() &&
+                            AreNotInterfaces<TParams ... >();
+                }
+
             }   // namespace Traits
         }   // namespace Detail
     }   // namespace Remote
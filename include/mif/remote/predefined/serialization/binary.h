@@ -0,0 +1,42 @@
+//-------------------------------------------------------------------
+//  MetaInfo Framework (MIF)
+//  https://github.com/tdv/mif
+//  Created:     10.2026
+//  Copyright (C) 2016-2024 tdv
+//-------------------------------------------------------------------
+
+#ifndef __MIF_REMOTE_PREDEFINED_SERIALIZATION_BINARY_H__
+#define __MIF_REMOTE_PREDEFINED_SERIALIZATION_BINARY_H__
+
+// MIF
+#include "mif/remote/serialization/binary.h"
+#include "mif/remote/serialization/serialization.h"
+
+namespace Mif
+{
+    namespace Remote
+    {
+        namespace Predefined
+        {
+            namespace Serialization
+            {
+
+                using Binary = Remote::Serialization::SerializerTraits
+                        <
+                            Remote::Serialization::Binary::Serializer<::Mif::Serialization::Binary::Layout::Compact>,
+                            Remote::Serialization::Binary::Deserializer
+                        >;
+
+                // Peers with the different versions of the reflected structures understand each other.
+                using TaggedBinary = Remote::Serialization::SerializerTraits
+                        <
+                            Remote::Serialization::Binary::Serializer<::Mif::Serialization::Binary::Layout::Tagged>,
+                            Remote::Serialization::Binary::Deserializer
+                        >;
+
+            }   // namespace Serialization
+        }   // namespace Predefined
+    }   // namespace Remote
+}   // namespace Mif
+
+#endif  // !__MIF_REMOTE_PREDEFINED_SERIALIZATION_BINARY_H__
@@ -0,0 +1,35 @@
+//-------------------------------------------------------------------
+//  MetaInfo Framework (MIF)
+//  https://github.com/tdv/mif
+//  Created:     10.2026
+//  Copyright (C) 2016-2024 tdv
+//-------------------------------------------------------------------
+
+#ifndef __MIF_REMOTE_PREDEFINED_SERIALIZATION_MSGPACK_H__
+#define __MIF_REMOTE_PREDEFINED_SERIALIZATION_MSGPACK_H__
+
+// MIF
+#include "mif/remote/serialization/msgpack.h"
+#include "mif/remote/serialization/serialization.h"
+
+namespace Mif
+{
+    namespace Remote
+    {
+        namespace Predefined
+        {
+            namespace Serialization
+            {
+
+                using MsgPack = Remote::Serialization::SerializerTraits
+                        <
+                            Remote::Serialization::MsgPack::Serializer,
+                            Remote::Serialization::MsgPack::Deserializer
+                        >;
+
+            }   // namespace Serialization
+        }   // namespace Predefined
+    }   // namespace Remote
+}   // namespace Mif
+
+#endif  // !__MIF_REMOTE_PREDEFINED_SERIALIZATION_MSGPACK_H__
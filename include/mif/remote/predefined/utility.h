@@ -75,14 +75,36 @@ namespace Mif
                 return service;
             }
 
+            // Service creator for Remote::Factory. The lazy creation saves a round trip
+            // for every created object, but the remote side has to support it.
+            template <typename TSerialization = Serialization::Boost::Binary>
+            inline Factory::ServiceCreator MakeServiceCreator(ObjectCreation creation)
+            {
+                return [creation] (Net::IClientFactory::ClientPtr client, Service::ServiceId serviceId)
+                    {
+                        if (!client)
+                            throw std::invalid_argument{"[Mif::Remote::Predefined::MakeServiceCreator] Empty client ptr."};
+
+                        using Client = PSClient<TSerialization>;
+                        using ProtocolChain = Protocol::ArchivedFrame<Client>;
+                        using ClientsChain = ProtocolChain;
+
+                        auto proxy = std::static_pointer_cast<ClientsChain>(client);
+                        auto ps = proxy->template GetClientItem<Client>();
+
+                        return ps->template CreateService<Service::IService>(serviceId, creation);
+                    };
+            }
+
             template <typename TSerialization = Serialization::Boost::Binary>
             inline Service::IFactoryPtr CreateTcpClientServiceFactory(std::string const &host, std::string const &port,
-                    std::uint16_t threadCount, std::chrono::microseconds const &timeout)
+                    std::uint16_t threadCount, std::chrono::microseconds const &timeout,
+                    ObjectCreation creation = ObjectCreation::Immediate)
             {
                 auto clientFactory = MakeClientFactory<TSerialization>(threadCount, timeout);
                 auto connection = std::make_shared<Net::Tcp::Connection>(host, port, std::move(clientFactory));
                 return Service::Make<Factory, Service::IFactory>(std::move(connection),
-                        CreateService<Service::IService, TSerialization>);
+                        MakeServiceCreator<TSerialization>(creation));
             }
 
         }   // namespace Predefined
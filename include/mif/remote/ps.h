@@ -92,7 +92,7 @@
                 (typename std::tuple_element<Indexes, typename method_ ## _Info ::ParamTypeList>::type ... params) \
             const_ override final \
         { \
-            return this->template _Mif_Remote_Call_Method<ResultType> \
+            return this->template _Mif_Remote_Call_Method<ResultType, method_ ## _Info ::IsConst> \
                 ( \
                     InterfaceId, \
                     #method_, \
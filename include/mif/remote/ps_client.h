@@ -11,6 +11,7 @@
 // STD
 #include <chrono>
 #include <condition_variable>
+#include <exception>
 #include <functional>
 #include <map>
 #include <memory>
@@ -19,11 +20,17 @@
 #include <string>
 #include <sstream>
 #include <thread>
+#include <type_traits>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 // MIF
 #include "mif/net/client.h"
+#include "mif/remote/detail/deadline.h"
 #include "mif/remote/detail/meta/iobject_manager.h"
+#include "mif/remote/detail/object_releaser.h"
+#include "mif/remote/detail/stub_registry.h"
 #include "mif/remote/meta/iservice.h"
 #include "mif/service/factory.h"
 #include "mif/service/make.h"
@@ -33,6 +40,15 @@ namespace Mif
     namespace Remote
     {
 
+        enum class ObjectCreation
+        {
+            // The remote object is created by a separate request when the proxy is created.
+            Immediate,
+            // The client chooses the instance id and the creation is sent with the first
+            // request made through the proxy.
+            Lazy
+        };
+
         template <typename TSerializer>
         class PSClient final
             : public Net::Client
@@ -49,7 +65,7 @@ namespace Mif
                 using ObjectManagerStub = typename Detail::Meta::IObjectManager_PS<TSerializer>::Stub;
                 m_stubObjectManager = Service::Make<ObjectManager, ObjectManager>(this, std::move(factory));
                 auto stub = std::make_shared<ObjectManagerStub>(m_stubObjectManager, m_psInstanceId);
-                m_stubs.insert(std::make_pair(m_psInstanceId, std::move(stub)));
+                m_stubs.Insert(m_psInstanceId, std::move(stub));
             }
 
             PSClient(PSClient const &) = delete;
@@ -58,9 +74,10 @@ namespace Mif
             PSClient& operator = (PSClient &&) = delete;
 
             template <typename TInterface>
-            Service::TServicePtr<TInterface> CreateService(Service::ServiceId id)
+            Service::TServicePtr<TInterface> CreateService(Service::ServiceId id,
+                    ObjectCreation creation = ObjectCreation::Immediate)
             {
-                return Service::Cast<TInterface>(CreateRemoteService<TInterface>(id));
+                return Service::Cast<TInterface>(CreateRemoteService<TInterface>(id, creation));
             }
 
         private:
@@ -75,7 +92,7 @@ namespace Mif
             using Responses = std::map<std::string/*uuid*/, Response>;
 
             using IStubPtr = std::shared_ptr<Detail::IStub<TSerializer>>;
-            using Stubs = std::map<std::string/*instance id*/, IStubPtr>;
+            using Stubs = Detail::StubRegistry<IStubPtr>;
 
             class ObjectManager
                 : public Service::Inherit<Detail::IObjectManager>
@@ -95,13 +112,42 @@ namespace Mif
                     return creator;
                 }
 
+                Detail::StubReleaser GetStubReleaser()
+                {
+                    auto self = Service::TServicePtr<ObjectManager>{this};
+                    auto releaser = std::bind(&ObjectManager::ReleaseStub, self, std::placeholders::_1);
+                    return releaser;
+                }
+
+                void ClearStubs()
+                {
+                    {
+                        LockGuard lock{m_refsLock};
+                        m_stubRefs.clear();
+                        m_stubKeys.clear();
+                    }
+
+                    m_owner->m_stubs.Clear(m_owner->m_psInstanceId);
+                }
+
             private:
-                Common::UuidGenerator m_uuidGenerator;
+                // The object is held by its stub, so the pointer can't be reused while the stub exists.
+                using StubKey = std::pair<Service::IService const * /*object*/, std::string /*interface id*/>;
+
+                struct StubRef
+                {
+                    std::string instanceId;
+                    std::size_t count;
+                };
 
                 ThisType *m_owner;
 
                 Service::IFactoryPtr m_factory;
 
+                LockType m_refsLock;
+                std::map<StubKey, StubRef> m_stubRefs;
+                std::unordered_map<std::string /*instance id*/, StubKey> m_stubKeys;
+
                 // IObjectManager
                 virtual std::string CreateObject(Service::ServiceId serviceId, std::string const &interfaceId) override final
                 {
@@ -112,38 +158,97 @@ namespace Mif
                     return AppendStub(std::move(instance), interfaceId);
                 }
 
+                virtual void CreateObjectWithId(Service::ServiceId serviceId, std::string const &interfaceId,
+                        std::string const &instanceId) override final
+                {
+                    if (interfaceId.empty())
+                        throw std::invalid_argument{"[Mif::Remote::PSClient::CreateObjectWithId] Parameter \"interfaceId\" must not be empty."};
+                    if (!Stubs::IsPeerId(instanceId))
+                    {
+                        throw std::invalid_argument{"[Mif::Remote::PSClient::CreateObjectWithId] "
+                            "Bad instance id \"" + instanceId + "\". It is not from the range of the peer ids."};
+                    }
+
+                    // The concurrent requests of the peer may carry the same creation.
+                    {
+                        LockGuard lock{m_refsLock};
+                        if (m_stubKeys.find(instanceId) != std::end(m_stubKeys))
+                            return;
+                    }
+
+                    auto instance = m_factory->Create(serviceId);
+                    if (!instance)
+                    {
+                        throw std::runtime_error{"[Mif::Remote::PSClient::CreateObjectWithId] "
+                            "Failed to create object of service " + std::to_string(serviceId) + "."};
+                    }
+
+                    auto stub = Detail::Registry::Visitor::Accept<CreateStubVisitor>(this,
+                            instance, instanceId, interfaceId);
+                    if (!stub)
+                    {
+                        throw std::runtime_error{"[Mif::Remote::PSClient::CreateObjectWithId] "
+                            "Failed to create stub for interface \"" + interfaceId + "\"."};
+                    }
+                    if (!stub->Query(interfaceId, {}))
+                    {
+                        throw std::invalid_argument{"[Mif::Remote::PSClient::CreateObjectWithId] "
+                            "Object of service " + std::to_string(serviceId) + " doesn't support "
+                            "interface \"" + interfaceId + "\"."};
+                    }
+
+                    StubKey key{instance.get(), interfaceId};
+
+                    LockGuard lock{m_refsLock};
+
+                    if (m_stubKeys.find(instanceId) != std::end(m_stubKeys))
+                        return;
+
+                    m_owner->m_stubs.Insert(instanceId, std::move(stub));
+
+                    // A singleton may already have a stub, then the new one is its alias.
+                    if (m_stubRefs.find(key) == std::end(m_stubRefs))
+                        m_stubRefs.insert(std::make_pair(key, StubRef{instanceId, 1}));
+                    m_stubKeys.insert(std::make_pair(instanceId, std::move(key)));
+                }
+
                 virtual void DestroyObject(std::string const &instanceId) override final
                 {
                     if (instanceId.empty())
                         throw std::invalid_argument{"[Mif::Remote::PSClient::DestrowObject] Parameter \"instanceId\" must not be empty."};
 
-                    IStubPtr stubService;
+                    if (!ReleaseStub(instanceId))
                     {
-                        LockGuard lock(m_owner->m_lock);
-                        auto iter = m_owner->m_stubs.find(instanceId);
-                        if (iter == std::end(m_owner->m_stubs))
-                        {
-                            throw std::invalid_argument{"[Mif::Remote::PSClient::DestroyObject] "
-                                "Instance with id \"" + instanceId + "\" not found."};
-                        }
-                        stubService = std::move(iter->second);
-                        m_owner->m_stubs.erase(iter);
+                        throw std::invalid_argument{"[Mif::Remote::PSClient::DestroyObject] "
+                            "Instance with id \"" + instanceId + "\" not found."};
+                    }
+                }
+
+                virtual void DestroyObjects(std::vector<std::string> const &instanceIds) override final
+                {
+                    std::string notFound;
+
+                    for (auto const &instanceId : instanceIds)
+                    {
+                        if (instanceId.empty() || !ReleaseStub(instanceId))
+                            notFound += (notFound.empty() ? "\"" : ", \"") + instanceId + "\"";
+                    }
+
+                    if (!notFound.empty())
+                    {
+                        throw std::invalid_argument{"[Mif::Remote::PSClient::DestroyObjects] "
+                            "Instances with ids " + notFound + " not found."};
                     }
                 }
 
                 virtual std::string QueryInterface(std::string const &instanceId, std::string const &interfaceId,
                         std::string const &serviceId) override final
                 {
-                    IStubPtr stub;
+                    auto stub = m_owner->m_stubs.Find(instanceId);
+                    if (!stub)
                     {
-                        LockGuard lock(m_owner->m_lock);
-                        auto iter = m_owner->m_stubs.find(instanceId);
-                        if (iter == std::end(m_owner->m_stubs))
-                        {
-                            throw std::invalid_argument{"[Mif::Remote::PSClient::QueryInterface] "
-                                "Instance with id \"" + instanceId + "\" not found."};
-                        }
-                        stub = iter->second;
+                        throw std::invalid_argument{"[Mif::Remote::PSClient::QueryInterface] "
+                            "Instance with id \"" + instanceId + "\" not found."};
                     }
 
                     auto instance = stub->Query(interfaceId, serviceId);
@@ -156,19 +261,41 @@ namespace Mif
                 virtual std::string CloneReference(std::string const &instanceId,
                         std::string const &interfaceId) override final
                 {
-                    Service::IServicePtr instance;
+                    auto stub = m_owner->m_stubs.Find(instanceId);
+                    if (!stub)
                     {
-                        LockGuard lock(m_owner->m_lock);
-                        auto iter = m_owner->m_stubs.find(instanceId);
-                        if (iter == std::end(m_owner->m_stubs))
+                        throw std::invalid_argument{"[Mif::Remote::PSClient::CloneReference] "
+                            "Instance with id \"" + instanceId + "\" not found."};
+                    }
+                    auto newInstanceId = AppendStub(stub->GetInstance(), interfaceId);
+                    return newInstanceId;
+                }
+
+                bool ReleaseStub(std::string const &instanceId)
+                {
+                    // The stub is destroyed out of the lock.
+                    IStubPtr stub;
+
+                    {
+                        LockGuard lock{m_refsLock};
+
+                        auto key = m_stubKeys.find(instanceId);
+                        if (key == std::end(m_stubKeys))
+                            return false;
+
+                        auto ref = m_stubRefs.find(key->second);
+                        if (ref != std::end(m_stubRefs) && ref->second.instanceId == instanceId)
                         {
-                            throw std::invalid_argument{"[Mif::Remote::PSClient::CloneReference] "
-                                "Instance with id \"" + instanceId + "\" not found."};
+                            if (--ref->second.count)
+                                return true;
+                            m_stubRefs.erase(ref);
                         }
-                        instance = iter->second->GetInstance();
+
+                        m_stubKeys.erase(key);
+                        stub = m_owner->m_stubs.Remove(instanceId);
                     }
-                    auto newInstanceId = AppendStub(std::move(instance), interfaceId);
-                    return newInstanceId;
+
+                    return true;
                 }
 
                 struct CreateStubVisitor
@@ -184,11 +311,12 @@ namespace Mif
                         {
                             auto self = Service::TServicePtr<ObjectManager>{objectManager};
                             auto stubCreator = objectManager->GetStubCreator();
+                            auto stubReleaser = objectManager->GetStubReleaser();
                             auto sender = std::bind(&ThisType::Send, objectManager->m_owner,
-                                    std::placeholders::_1, std::placeholders::_2);
+                                    std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
                             return std::make_shared<typename T::Stub>(std::move(instance), instanceId,
                                     objectManager->m_owner->GetProxyObjectManager(),
-                                    std::move(stubCreator), std::move(sender));
+                                    std::move(stubCreator), std::move(stubReleaser), std::move(sender));
                         }
                         return {};
                     }
@@ -199,29 +327,52 @@ namespace Mif
                     if (!instance)
                         return {};
 
-                    auto const instanceId = m_uuidGenerator.Generate();
+                    // The same object passed many times (e.g. a callback) shares one stub,
+                    // every reference given to the remote side has to be released.
+                    StubKey key{instance.get(), interfaceId};
 
                     {
-                        LockGuard lock(m_owner->m_lock);
-                        if (m_owner->m_stubs.find(instanceId) != std::end(m_owner->m_stubs))
-                            return instanceId;
+                        LockGuard lock{m_refsLock};
+                        if (auto const *instanceId = AddStubRef(key))
+                            return *instanceId;
                     }
 
+                    // The stub is made out of the lock. The one made concurrently for the same
+                    // object wins, then this one is destroyed out of the lock as well.
+                    auto const instanceId = m_owner->m_stubs.GenerateId();
 
                     auto stub = Detail::Registry::Visitor::Accept<CreateStubVisitor>(this,
                             std::move(instance), instanceId, interfaceId);
+                    if (!stub)
+                    {
+                        throw std::runtime_error{"[Mif::Remote::PSClient::AppendStub] "
+                            "Failed to create stub for interface \"" + interfaceId + "\"."};
+                    }
 
                     {
-                        LockGuard lock(m_owner->m_lock);
+                        LockGuard lock{m_refsLock};
+
+                        if (auto const *existingId = AddStubRef(key))
+                            return *existingId;
 
-                        if (m_owner->m_stubs.find(instanceId) != std::end(m_owner->m_stubs))
-                            return instanceId;
+                        m_owner->m_stubs.Insert(instanceId, std::move(stub));
 
-                        m_owner->m_stubs.insert(std::make_pair(instanceId, std::move(stub)));
+                        m_stubRefs.insert(std::make_pair(key, StubRef{instanceId, 1}));
+                        m_stubKeys.insert(std::make_pair(instanceId, std::move(key)));
                     }
 
                     return instanceId;
-            }
+                }
+
+                // Must be called under m_refsLock.
+                std::string const* AddStubRef(StubKey const &key)
+                {
+                    auto ref = m_stubRefs.find(key);
+                    if (ref == std::end(m_stubRefs))
+                        return nullptr;
+                    ++ref->second.count;
+                    return &ref->second.instanceId;
+                }
 
             };
 
@@ -234,7 +385,7 @@ namespace Mif
             std::condition_variable m_condVar;
 
             LockType m_lock;
-            Detail::IObjectManagerPtr m_proxyObjectManager;
+            Service::TIntrusivePtr<Detail::ObjectReleaser> m_proxyObjectManager;
             Service::TIntrusivePtr<ObjectManager> m_stubObjectManager;
 
             Stubs m_stubs;
@@ -248,19 +399,22 @@ namespace Mif
                 if (!m_proxyObjectManager)
                 {
                     using ObjectManagerProxy = typename Detail::Meta::IObjectManager_PS<TSerializer>::Proxy;
-                    m_proxyObjectManager = Service::Make<ObjectManagerProxy, Detail::IObjectManager>(m_psInstanceId, std::bind(&ThisType::Send,
-                            std::static_pointer_cast<ThisType>(shared_from_this()), std::placeholders::_1, std::placeholders::_2),
+                    auto manager = Service::Make<ObjectManagerProxy, Detail::IObjectManager>(m_psInstanceId, std::bind(&ThisType::Send,
+                            std::static_pointer_cast<ThisType>(shared_from_this()), std::placeholders::_1,
+                            std::placeholders::_2, std::placeholders::_3),
                             [] (Service::IServicePtr, std::string const &interfaceId) -> std::string
                             {
                                 throw Detail::ProxyStubException{"[Mif::Remote::PSClient::GetProxyObjectManager] "
                                     "Failed to create proxy from ObjectManager. Interface id \"" + interfaceId + "\""};
                             }
                         );
+                    m_proxyObjectManager = Service::Make<Detail::ObjectReleaser, Detail::ObjectReleaser>(std::move(manager));
                 }
                 return m_proxyObjectManager;
             }
 
-            DeserializerPtr Send(std::string const &requestId, Serializer &serializer)
+            DeserializerPtr Send(std::string const &requestId, Serializer &serializer,
+                    Detail::CallContext const &context)
             {
                 if (!Post(std::move(serializer.GetBuffer())))
                 {
@@ -273,39 +427,59 @@ namespace Mif
                         "No channel for post data."};
                 }
 
-                for (auto t = GetCurTime() ; (GetCurTime() - t) < m_timeout ; )
-                {
-                    std::this_thread::sleep_for(std::chrono::microseconds(1));
+                auto expires = GetCurTime() + m_timeout;
+                auto const byDeadline = context.deadline && std::chrono::microseconds{context.deadline} < expires;
+                if (byDeadline)
+                    expires = std::chrono::microseconds{context.deadline};
 
-                    {
-                        std::unique_lock<LockType> lock{m_dataLock};
-                        typename Responses::iterator iter = std::end(m_responses);
-                        auto waitResult = m_condVar.wait_for(lock, m_timeout,
-                                [this, &requestId, &iter] ()
-                                {
-                                    iter = m_responses.find(requestId);
-                                    return iter != std::end(m_responses) || IsClosed();
-                                }
-                            );
-                        if (IsClosed())
+                // The lock is taken before the notification in order not to lose it between
+                // the check of the cancellation and the waiting.
+                Detail::Cancellation::Subscription subscription{context.cancellation,
+                        [this] ()
                         {
-                            throw Detail::ProxyStubException{"[Mif::Remote::PSClient::Send] Failed to send data. "
-                                "Connection was closed by remote server."};
+                            {
+                                LockGuard lock{m_dataLock};
+                            }
+                            m_condVar.notify_all();
                         }
-                        if (waitResult)
-                        {
-                            auto deserializer = std::move(iter->second.second);
-                            m_responses.erase(iter);
+                    };
 
-                            CleanOldResponses();
-
-                            return std::move(deserializer);
-                        }
+                {
+                    std::unique_lock<LockType> lock{m_dataLock};
+                    typename Responses::iterator iter = std::end(m_responses);
+                    m_condVar.wait_until(lock, std::chrono::time_point<std::chrono::system_clock,
+                            std::chrono::microseconds>{expires},
+                            [this, &requestId, &context, &iter] ()
+                            {
+                                iter = m_responses.find(requestId);
+                                return iter != std::end(m_responses) || IsClosed() || context.IsCancelled();
+                            }
+                        );
+                    if (IsClosed())
+                    {
+                        throw Detail::ProxyStubException{"[Mif::Remote::PSClient::Send] Failed to send data. "
+                            "Connection was closed by remote server."};
+                    }
+                    if (iter != std::end(m_responses))
+                    {
+                        auto deserializer = std::move(iter->second.second);
+                        m_responses.erase(iter);
 
                         CleanOldResponses();
+
+                        return deserializer;
                     }
 
-                    std::this_thread::sleep_for(std::chrono::microseconds(5));
+                    CleanOldResponses();
+                }
+
+                if (context.IsCancelled())
+                    throw Detail::ProxyStubException{"[Mif::Remote::PSClient::Send] The call was cancelled."};
+
+                if (byDeadline)
+                {
+                    throw Detail::ProxyStubException{"[Mif::Remote::PSClient::Send] Failed to send data. "
+                        "Deadline expired before response from remote server."};
                 }
 
                 throw Detail::ProxyStubException{"[Mif::Remote::PSClient::Send] Failed to send data. "
@@ -350,17 +524,28 @@ namespace Mif
                     }
                     else if (m_responses.find(uuid) == std::end(m_responses))
                     {
-                        IStubPtr stub;
-                        {
-                            LockGuard lock(m_lock);
-                            auto iter = m_stubs.find(instanceId);
-                            if (iter != std::end(m_stubs))
-                                stub = iter->second;
-                        }
-                        if (!stub)
+                        auto stub = m_stubs.Find(instanceId);
+                        auto const creationInterface = deserializer->GetCreationInterface();
+                        if (!stub && creationInterface.empty())
                             throw Detail::ProxyStubException{"[Mif::Remote::PSClient::ProcessData] Instance \"" + instanceId + "\" not found."};
                         Serializer serializer(false, uuid, instanceId, interfaceId, method);
-                        stub->Call(*deserializer, serializer);
+                        auto const deadline = deserializer->GetDeadline();
+                        if (Detail::IsExpiredDeadline(deadline))
+                        {
+                            // The caller does not wait for the result any more.
+                            serializer.PutException(std::make_exception_ptr(Detail::ProxyStubException{
+                                    "[Mif::Remote::PSClient::ProcessData] Deadline expired before the request was processed."
+                                }));
+                        }
+                        else
+                        {
+                            // The nested remote calls made by the stub inherit the caller's deadline.
+                            Detail::DeadlineScope scope{deadline};
+                            if (!stub)
+                                stub = CreateRequestedStub(*deserializer, creationInterface, serializer);
+                            if (stub)
+                                stub->Call(*deserializer, serializer);
+                        }
                         if (!Post(std::move(serializer.GetBuffer())))
                         {
                             if (!CloseMe())
@@ -397,6 +582,44 @@ namespace Mif
             virtual void Close() override final
             {
                 m_condVar.notify_all();
+
+                // Nobody can release the objects after the connection is closed. The proxy of
+                // the remote object manager holds this object, so it is dropped as well.
+                m_stubObjectManager->ClearStubs();
+
+                Service::TIntrusivePtr<Detail::ObjectReleaser> proxyObjectManager;
+
+                {
+                    LockGuard lock{m_lock};
+                    proxyObjectManager.swap(m_proxyObjectManager);
+                }
+
+                // The release in flight is woken above, so Stop does not wait for long.
+                if (proxyObjectManager)
+                    proxyObjectManager->Stop();
+            }
+
+            // The object is created by the first request the peer made to it.
+            IStubPtr CreateRequestedStub(Deserializer const &request, std::string const &interfaceId,
+                    Serializer &response)
+            {
+                try
+                {
+                    Detail::IObjectManager &manager = *m_stubObjectManager;
+                    manager.CreateObjectWithId(request.GetCreationService(), interfaceId, request.GetInstance());
+                    auto stub = m_stubs.Find(request.GetInstance());
+                    if (!stub)
+                    {
+                        throw Detail::ProxyStubException{"[Mif::Remote::PSClient::CreateRequestedStub] "
+                            "Instance \"" + request.GetInstance() + "\" not found after creation."};
+                    }
+                    return stub;
+                }
+                catch (...)
+                {
+                    response.PutException(std::current_exception());
+                }
+                return {};
             }
 
             std::chrono::microseconds GetCurTime() const
@@ -418,19 +641,30 @@ namespace Mif
             }
 
             template <typename TInterface>
-            Service::IServicePtr CreateRemoteService(Service::ServiceId serviceId)
+            Service::IServicePtr CreateRemoteService(Service::ServiceId serviceId, ObjectCreation creation)
             {
                 try
                 {
                     auto self = std::static_pointer_cast<ThisType>(shared_from_this());
-                    auto sender = std::bind(&ThisType::Send, self, std::placeholders::_1, std::placeholders::_2);
+                    auto sender = std::bind(&ThisType::Send, self, std::placeholders::_1,
+                            std::placeholders::_2, std::placeholders::_3);
                     auto stubCreator = m_stubObjectManager->GetStubCreator();
+                    auto stubReleaser = m_stubObjectManager->GetStubReleaser();
 
                     using PSType = typename Detail::Registry::Registry<TInterface>::template Type<TSerializer>;
                     using ProxyType = typename PSType::Proxy;
 
+                    if (creation == ObjectCreation::Lazy)
+                    {
+                        // The interface of the object given by a factory is known after the first cast.
+                        auto const interfaceId = std::is_same<TInterface, Service::IService>::value ?
+                                std::string{} : std::string{PSType::InterfaceId};
+                        return Service::Make<ProxyType>(GetProxyObjectManager(), serviceId, interfaceId,
+                                m_stubs.GeneratePeerId(), std::move(sender), std::move(stubCreator), std::move(stubReleaser));
+                    }
+
                     return Service::Make<ProxyType>(GetProxyObjectManager(), serviceId, std::string{PSType::InterfaceId},
-                            std::move(sender), std::move(stubCreator));
+                            std::move(sender), std::move(stubCreator), std::move(stubReleaser));
                 }
                 catch (std::exception const &e)
                 {
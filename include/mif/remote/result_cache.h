@@ -0,0 +1,53 @@
+//-------------------------------------------------------------------
+//  MetaInfo Framework (MIF)
+//  https://github.com/tdv/mif
+//  Created:     10.2026
+//  Copyright (C) 2016-2024 tdv
+//-------------------------------------------------------------------
+
+#ifndef __MIF_REMOTE_RESULT_CACHE_H__
+#define __MIF_REMOTE_RESULT_CACHE_H__
+
+// STD
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+// MIF
+#include "mif/remote/detail/iproxy_control.h"
+#include "mif/service/iservice.h"
+
+namespace Mif
+{
+    namespace Remote
+    {
+        // Results of the const methods called through the proxy are cached for 'ttl'
+        // and reused for the calls with the same parameters. A call of any non-const
+        // method through the same proxy drops all the cached results.
+        template <typename T>
+        inline void EnableResultCache(Service::TIntrusivePtr<T> const &service,
+                std::chrono::microseconds const &ttl, std::size_t maxItems = 1024)
+        {
+            auto &control = Detail::GetProxyControl(service, "[Mif::Remote::EnableResultCache]");
+            control.SetResultCache(std::make_shared<Detail::ResultCache>(ttl, maxItems));
+        }
+
+        template <typename T>
+        inline void DisableResultCache(Service::TIntrusivePtr<T> const &service)
+        {
+            auto &control = Detail::GetProxyControl(service, "[Mif::Remote::DisableResultCache]");
+            control.SetResultCache({});
+        }
+
+        template <typename T>
+        inline void InvalidateResultCache(Service::TIntrusivePtr<T> const &service)
+        {
+            auto &control = Detail::GetProxyControl(service, "[Mif::Remote::InvalidateResultCache]");
+            if (auto cache = control.GetResultCache())
+                cache->Clear();
+        }
+
+    }   // namespace Remote
+}   // namespace Mif
+
+#endif  // !__MIF_REMOTE_RESULT_CACHE_H__
@@ -0,0 +1,305 @@
+//-------------------------------------------------------------------
+//  MetaInfo Framework (MIF)
+//  https://github.com/tdv/mif
+//  Created:     10.2026
+//  Copyright (C) 2016-2024 tdv
+//-------------------------------------------------------------------
+
+#ifndef __MIF_REMOTE_SERIALIZATION_BINARY_H__
+#define __MIF_REMOTE_SERIALIZATION_BINARY_H__
+
+// STD
+#include <cstdint>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// MIF
+#include "mif/common/types.h"
+#include "mif/remote/serialization/detail/tag.h"
+#include "mif/serialization/binary.h"
+
+namespace Mif
+{
+    namespace Remote
+    {
+        namespace Serialization
+        {
+            namespace Binary
+            {
+                namespace Format
+                {
+
+                    // The first byte of the message. It is changed with any change of the layout.
+                    static constexpr std::uint8_t Version = 1;
+
+                    // Flags of the second byte.
+                    static constexpr std::uint8_t Response = 1;
+                    static constexpr std::uint8_t Tagged = 2;
+
+                }   // namespace Format
+
+                // Message layout: version, flags, uuid, instance, interface, method, deadline,
+                // creation service and interface, exception flag and message, parameters.
+                // The parameters are written in the given layout, the deserializer reads both.
+                template <::Mif::Serialization::Binary::Layout ParamsLayout>
+                class Serializer final
+                {
+                public:
+                    template <typename ... TParams>
+                    Serializer(bool isReques, std::string const &uuid,
+                        std::string const &instanceId, std::string const &interfaceId,
+                        std::string const &methodId, TParams && ... params)
+                        : m_isRequest{isReques}
+                        , m_uuid{uuid}
+                        , m_instanceId{instanceId}
+                        , m_interfaceId{interfaceId}
+                        , m_methodId{methodId}
+                    {
+                        PutParams(std::forward<TParams>(params) ... );
+                    }
+
+                    template <typename ... TParams>
+                    void PutParams(TParams && ... params)
+                    {
+                        m_params.clear();
+                        ::Mif::Serialization::Reserve(m_params, std::forward_as_tuple(params ... ));
+                        ::Mif::Serialization::Binary::Detail::WriteData(m_params, ParamsLayout,
+                                [&params ... ] (::Mif::Serialization::Binary::Detail::Writer &writer)
+                                {
+                                    WriteParams(writer, params ... );
+                                }
+                            );
+                    }
+
+                    void SetDeadline(std::int64_t deadline)
+                    {
+                        m_deadline = deadline;
+                    }
+
+                    void SetCreation(std::uint32_t serviceId, std::string const &interfaceId)
+                    {
+                        m_createService = serviceId;
+                        m_createInterface = interfaceId;
+                    }
+
+                    void PutException(std::exception_ptr ex)
+                    {
+                        m_hasException = true;
+
+                        try
+                        {
+                            std::rethrow_exception(ex);
+                        }
+                        catch (std::exception const &e)
+                        {
+                            m_exception = e.what();
+                        }
+                        catch (...)
+                        {
+                            m_exception = "Unknown exception.";
+                        }
+                    }
+
+                    Common::Buffer GetBuffer()
+                    {
+                        Common::Buffer buffer;
+                        // Two bytes of the format, up to 10 bytes per size or number.
+                        buffer.reserve(2 + 8 * 10 + m_uuid.size() + m_instanceId.size() + m_interfaceId.size() +
+                                m_methodId.size() + m_createInterface.size() + m_exception.size() + m_params.size());
+
+                        using namespace ::Mif::Serialization::Binary::Detail;
+
+                        Writer writer{buffer};
+                        writer.WriteByte(Format::Version);
+                        writer.WriteByte(static_cast<std::uint8_t>((m_isRequest ? 0 : Format::Response) |
+                                (ParamsLayout == ::Mif::Serialization::Binary::Layout::Tagged ? Format::Tagged : 0)));
+                        Write(writer, m_uuid);
+                        Write(writer, m_instanceId);
+                        Write(writer, m_interfaceId);
+                        Write(writer, m_methodId);
+                        Write(writer, m_deadline);
+                        Write(writer, m_createService);
+                        Write(writer, m_createInterface);
+                        Write(writer, m_hasException);
+                        if (m_hasException)
+                            Write(writer, m_exception);
+
+                        buffer.insert(std::end(buffer), std::begin(m_params), std::end(m_params));
+
+                        return buffer;
+                    }
+
+                private:
+                    bool m_isRequest;
+                    std::string m_uuid;
+                    std::string m_instanceId;
+                    std::string m_interfaceId;
+                    std::string m_methodId;
+                    std::int64_t m_deadline = 0;
+                    std::uint32_t m_createService = 0;
+                    std::string m_createInterface;
+                    bool m_hasException = false;
+                    std::string m_exception;
+                    Common::Buffer m_params;
+
+                    template <typename TParam, typename ... TParams>
+                    static void WriteParams(::Mif::Serialization::Binary::Detail::Writer &writer,
+                            TParam const &param, TParams const & ... params)
+                    {
+                        ::Mif::Serialization::Binary::Detail::Write(writer, param);
+                        WriteParams(writer, params ... );
+                    }
+
+                    static void WriteParams(::Mif::Serialization::Binary::Detail::Writer &)
+                    {
+                    }
+                };
+
+                class Deserializer final
+                {
+                public:
+                    Deserializer(Common::Buffer buffer)
+                        : m_buffer(std::move(buffer))
+                    {
+                        if (m_buffer.empty())
+                            throw std::invalid_argument{"[Mif::Remote::Serialization::Binary::Deserializer] Empty buffer."};
+
+                        using namespace ::Mif::Serialization::Binary::Detail;
+
+                        Reader reader{m_buffer.data(), m_buffer.data() + m_buffer.size()};
+
+                        if (reader.ReadByte() != Format::Version)
+                            throw std::invalid_argument{"[Mif::Remote::Serialization::Binary::Deserializer] Unsupported format version."};
+
+                        auto const flags = reader.ReadByte();
+                        if (flags & ~(Format::Response | Format::Tagged))
+                            throw std::invalid_argument{"[Mif::Remote::Serialization::Binary::Deserializer] Bad message flags."};
+                        m_isRequest = !(flags & Format::Response);
+                        m_paramsLayout = (flags & Format::Tagged) ?
+                                ::Mif::Serialization::Binary::Layout::Tagged :
+                                ::Mif::Serialization::Binary::Layout::Compact;
+
+                        Read(reader, m_uuid);
+                        Read(reader, m_instance);
+                        Read(reader, m_interface);
+                        Read(reader, m_method);
+                        Read(reader, m_deadline);
+                        Read(reader, m_createService);
+                        Read(reader, m_createInterface);
+
+                        bool hasException = false;
+                        Read(reader, hasException);
+                        if (hasException)
+                        {
+                            std::string message;
+                            Read(reader, message);
+                            try
+                            {
+                                throw std::runtime_error{std::move(message)};
+                            }
+                            catch (...)
+                            {
+                                m_exception = std::current_exception();
+                            }
+                        }
+
+                        m_params = static_cast<std::size_t>(reader.GetPosition() - m_buffer.data());
+                    }
+
+                    std::string const& GetUuid() const
+                    {
+                        return m_uuid;
+                    }
+
+                    bool IsRequest() const
+                    {
+                        return m_isRequest;
+                    }
+
+                    bool IsResponse() const
+                    {
+                        return !m_isRequest;
+                    }
+
+                    std::string GetType() const
+                    {
+                        return m_isRequest ? Detail::Tag::Request::Value : Detail::Tag::Response::Value;
+                    }
+
+                    std::string const& GetInstance() const
+                    {
+                        return m_instance;
+                    }
+
+                    std::string const& GetInterface() const
+                    {
+                        return m_interface;
+                    }
+
+                    std::string const& GetMethod() const
+                    {
+                        return m_method;
+                    }
+
+                    std::int64_t GetDeadline() const
+                    {
+                        return m_deadline;
+                    }
+
+                    std::uint32_t GetCreationService() const
+                    {
+                        return m_createService;
+                    }
+
+                    std::string const& GetCreationInterface() const
+                    {
+                        return m_createInterface;
+                    }
+
+                    template <typename ... TParams>
+                    std::tuple<typename std::decay<TParams>::type ... > GetParams() const
+                    {
+                        std::tuple<typename std::decay<TParams>::type ... > res;
+                        ::Mif::Serialization::Binary::Detail::Reader reader{m_buffer.data() + m_params,
+                                m_buffer.data() + m_buffer.size(), m_paramsLayout};
+                        ::Mif::Serialization::Binary::Detail::Read(reader, res);
+                        return res;
+                    }
+
+                    bool HasException() const
+                    {
+                        return !!m_exception;
+                    }
+
+                    std::exception_ptr GetException() const
+                    {
+                        return m_exception;
+                    }
+
+                private:
+                    Common::Buffer m_buffer;
+                    std::size_t m_params = 0;
+                    ::Mif::Serialization::Binary::Layout m_paramsLayout = ::Mif::Serialization::Binary::Layout::Compact;
+
+                    bool m_isRequest = false;
+                    std::string m_uuid;
+                    std::string m_instance;
+                    std::string m_interface;
+                    std::string m_method;
+                    std::int64_t m_deadline = 0;
+                    std::uint32_t m_createService = 0;
+                    std::string m_createInterface;
+                    std::exception_ptr m_exception;
+                };
+
+            }   // namespace Binary
+        }   // namespace Serialization
+    }   //  namespace Remote
+}   // namespace Mif
+
+
+#endif  // !__MIF_REMOTE_SERIALIZATION_BINARY_H__
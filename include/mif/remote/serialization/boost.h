@@ -9,18 +9,25 @@
 #define __MIF_REMOTE_SERIALIZATION_BOOST_H__
 
 // STD
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <exception>
+#include <istream>
+#include <new>
+#include <ostream>
 #include <stdexcept>
 #include <string>
 #include <vector>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 
 // BOOST
-#include <boost/iostreams/stream.hpp>
-#include <boost/iostreams/filtering_stream.hpp>
-#include <boost/iostreams/device/back_inserter.hpp>
-#include <boost/iostreams/device/array.hpp>
+#include <boost/archive/basic_archive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/optional.hpp>
 #include <boost/serialization/array.hpp>
 #include <boost/serialization/bitset.hpp>
 //#include <boost/serialization/boost_unordered_map.hpp>
@@ -44,9 +51,10 @@
 
 // MIF
 #include "mif/common/types.h"
-#include "mif/common/unused.h"
+#include "mif/remote/serialization/detail/buffer_stream.h"
 #include "mif/remote/serialization/detail/tag.h"
 #include "mif/serialization/boost.h"
+#include "mif/serialization/estimate_size.h"
 
 namespace Mif
 {
@@ -66,6 +74,287 @@ namespace Mif
 
             namespace Boost
             {
+                namespace Detail
+                {
+
+                    // The names of the parameters are made once, not on every call.
+                    template <std::size_t Index>
+                    struct ParamName final
+                    {
+                        static char const* Get()
+                        {
+                            static std::string const name = Serialization::Detail::Tag::Param::Value + std::to_string(Index);
+                            return name.c_str();
+                        }
+                    };
+
+                    template <typename TArchive>
+                    using IsBinaryArchive = std::is_constructible<TArchive, std::streambuf &>;
+
+                    // The values which the boost binary archives save as is, without any type information.
+                    template <typename ... T>
+                    struct IsPrimitive;
+
+                    template <typename T, typename ... Tail>
+                    struct IsPrimitive<T, Tail ... >
+                        : public std::integral_constant
+                            <
+                                bool,
+                                (std::is_arithmetic<T>::value || std::is_same<T, std::string>::value) &&
+                                    IsPrimitive<Tail ... >::value
+                            >
+                    {
+                    };
+
+                    template <>
+                    struct IsPrimitive<>
+                        : public std::true_type
+                    {
+                    };
+
+                    template <typename T>
+                    inline typename std::enable_if<std::is_arithmetic<T>::value, std::size_t>::type
+                    EstimateSize(T const &)
+                    {
+                        return sizeof(T);
+                    }
+
+                    inline std::size_t EstimateSize(std::string const &value)
+                    {
+                        return sizeof(std::size_t) + value.size();
+                    }
+
+                    template <typename T>
+                    inline typename std::enable_if<!std::is_arithmetic<T>::value, std::size_t>::type
+                    EstimateSize(T const &value)
+                    {
+                        return ::Mif::Serialization::EstimateSize(value);
+                    }
+
+                    // Writes the primitive values in the format of the boost binary archives.
+                    // The header is made by the archive itself (see GetArchiveHeader).
+                    class BinaryWriter final
+                    {
+                    public:
+                        BinaryWriter(Common::Buffer &buffer)
+                            : m_buffer(buffer)
+                        {
+                        }
+
+                        void WriteHeader(Common::Buffer const &header)
+                        {
+                            m_buffer.insert(std::end(m_buffer), std::begin(header), std::end(header));
+                        }
+
+                        template <typename T>
+                        typename std::enable_if<std::is_arithmetic<T>::value, void>::type
+                        Write(T value)
+                        {
+                            auto const *data = reinterpret_cast<char const *>(&value);
+                            m_buffer.insert(std::end(m_buffer), data, data + sizeof(value));
+                        }
+
+                        void Write(std::string const &value)
+                        {
+                            Write(value.c_str(), value.size());
+                        }
+
+                    private:
+                        Common::Buffer &m_buffer;
+
+                        void Write(char const *value, std::size_t size)
+                        {
+                            Write(size);
+                            m_buffer.insert(std::end(m_buffer), value, value + size);
+                        }
+                    };
+
+                    class BinaryReader final
+                    {
+                    public:
+                        BinaryReader(char const *begin, char const *end)
+                            : m_pos{begin}
+                            , m_end{end}
+                        {
+                        }
+
+                        // Returns false if the data was made by the archive of another version
+                        // or on an incompatible machine. Such data is read by the archive itself.
+                        bool ReadHeader(Common::Buffer const &header)
+                        {
+                            if (static_cast<std::size_t>(m_end - m_pos) < header.size() ||
+                                    std::memcmp(m_pos, header.data(), header.size()))
+                            {
+                                return false;
+                            }
+                            m_pos += header.size();
+                            return true;
+                        }
+
+                        template <typename T>
+                        typename std::enable_if<std::is_arithmetic<T>::value, void>::type
+                        Read(T &value)
+                        {
+                            Check(sizeof(value));
+                            std::memcpy(&value, m_pos, sizeof(value));
+                            m_pos += sizeof(value);
+                        }
+
+                        void Read(bool &value)
+                        {
+                            unsigned char data = 0;
+                            Read(data);
+                            if (data > 1)
+                                throw std::runtime_error{"[Mif::Remote::Serialization::Boost::Detail::BinaryReader] Bad bool value."};
+                            value = !!data;
+                        }
+
+                        void Read(std::string &value)
+                        {
+                            std::size_t size = 0;
+                            Read(size);
+                            Check(size);
+                            value.assign(m_pos, size);
+                            m_pos += size;
+                        }
+
+                        char const* GetPosition() const
+                        {
+                            return m_pos;
+                        }
+
+                    private:
+                        char const *m_pos;
+                        char const *m_end;
+
+                        void Check(std::size_t size) const
+                        {
+                            if (static_cast<std::size_t>(m_end - m_pos) < size)
+                                throw std::runtime_error{"[Mif::Remote::Serialization::Boost::Detail::BinaryReader] Unexpected end of data."};
+                        }
+                    };
+
+                    // The archive which writes the data for the archive. The data of the unknown input
+                    // archives is not read directly.
+                    template <typename TArchive>
+                    struct OutputArchive
+                    {
+                        using Type = typename std::conditional<TArchive::is_saving::value, TArchive, void>::type;
+                    };
+
+                    template <>
+                    struct OutputArchive<boost::archive::binary_iarchive>
+                    {
+                        using Type = boost::archive::binary_oarchive;
+                    };
+
+                    // The header of the binary archive is taken from the archive once.
+                    template <typename TArchive>
+                    Common::Buffer MakeArchiveHeader()
+                    {
+                        Common::Buffer header;
+                        Serialization::Detail::BufferSink sink{header};
+                        Serialization::Detail::Archive<TArchive, std::ostream> holder{sink};
+                        return header;
+                    }
+
+                    template <>
+                    inline Common::Buffer MakeArchiveHeader<void>()
+                    {
+                        return {};
+                    }
+
+                    template <typename TArchive>
+                    Common::Buffer const& GetArchiveHeader()
+                    {
+                        static Common::Buffer const header = MakeArchiveHeader<TArchive>();
+                        return header;
+                    }
+
+                    template <typename TArchive>
+                    class ArchiveWriter final
+                    {
+                    public:
+                        ArchiveWriter(TArchive &archive)
+                            : m_archive(archive)
+                        {
+                        }
+
+                        template <typename T>
+                        void Write(T const &value)
+                        {
+                            m_archive << boost::serialization::make_nvp("value", value);
+                        }
+
+                    private:
+                        TArchive &m_archive;
+                    };
+
+                    template <typename TWriter>
+                    void WriteProbe(TWriter &writer)
+                    {
+                        writer.Write(true);
+                        writer.Write('m');
+                        writer.Write(static_cast<signed char>(-1));
+                        writer.Write(static_cast<unsigned char>(0xfe));
+                        writer.Write(static_cast<short>(-2));
+                        writer.Write(static_cast<unsigned short>(3));
+                        writer.Write(-4);
+                        writer.Write(5u);
+                        writer.Write(-6l);
+                        writer.Write(7ul);
+                        writer.Write(-8ll);
+                        writer.Write(9ull);
+                        writer.Write(0.5f);
+                        writer.Write(-0.25);
+                        writer.Write(std::string{});
+                        writer.Write(std::string{"mif"});
+                    }
+
+                    // The values are written directly only if it gives the same bytes as the archive
+                    // of the used boost version does. Otherwise the archive is used, so the messages
+                    // stay readable by the archive after an upgrade of boost.
+                    template <typename TArchive>
+                    bool CheckDirectFormat()
+                    {
+                        try
+                        {
+                            Common::Buffer byArchive;
+
+                            {
+                                Serialization::Detail::BufferSink sink{byArchive};
+                                Serialization::Detail::Archive<TArchive, std::ostream> holder{sink};
+                                ArchiveWriter<TArchive> writer{holder.Get()};
+                                WriteProbe(writer);
+                            }
+
+                            Common::Buffer direct;
+                            BinaryWriter writer{direct};
+                            writer.WriteHeader(GetArchiveHeader<TArchive>());
+                            WriteProbe(writer);
+
+                            return byArchive == direct;
+                        }
+                        catch (std::exception const &)
+                        {
+                            return false;
+                        }
+                    }
+
+                    template <>
+                    inline bool CheckDirectFormat<void>()
+                    {
+                        return false;
+                    }
+
+                    template <typename TArchive>
+                    bool IsDirectFormat()
+                    {
+                        static bool const isDirect = CheckDirectFormat<typename OutputArchive<TArchive>::Type>();
+                        return isDirect;
+                    }
+
+                }   // namespace Detail
 
                 template <typename TArchive>
                 class Serializer final
@@ -75,19 +364,51 @@ namespace Mif
                     Serializer(bool isReques, std::string const &uuid,
                         std::string const &instanceId, std::string const &interfaceId,
                         std::string const &methodId, TParams && ... params)
-                        : m_type{isReques ? Detail::Tag::Request::Value : Detail::Tag::Response::Value}
+                        : m_type{isReques ? Serialization::Detail::Tag::Request::Value : Serialization::Detail::Tag::Response::Value}
                         , m_uuid{uuid}
                         , m_instanceId{instanceId}
                         , m_interfaceId{interfaceId}
                         , m_methodId{methodId}
-                        , m_params{new ParamPack<TParams ... >{std::forward<TParams>(params) ... }}
                     {
+                        PutParams(std::forward<TParams>(params) ... );
+                    }
+
+                    ~Serializer()
+                    {
+                        ResetParams();
                     }
 
+                    Serializer(Serializer const &) = delete;
+                    Serializer& operator = (Serializer const &) = delete;
+                    Serializer(Serializer &&) = delete;
+                    Serializer& operator = (Serializer &&) = delete;
+
                     template <typename ... TParams>
                     void PutParams(TParams && ... params)
                     {
-                        m_params.reset(new ParamPack<TParams ... >{std::forward<TParams>(params) ... });
+                        ResetParams();
+
+                        using Pack = ParamPack<TParams ... >;
+                        using IsInline = std::integral_constant
+                            <
+                                bool,
+                                sizeof(Pack) <= sizeof(ParamsStorage) &&
+                                    alignof(ParamsStorage) % alignof(Pack) == 0
+                            >;
+
+                        m_params = CreateParams<Pack>(static_cast<IsInline const *>(nullptr),
+                                std::forward<TParams>(params) ... );
+                    }
+
+                    void SetDeadline(std::int64_t deadline)
+                    {
+                        m_deadline = deadline;
+                    }
+
+                    void SetCreation(std::uint32_t serviceId, std::string const &interfaceId)
+                    {
+                        m_createService = serviceId;
+                        m_createInterface = interfaceId;
                     }
 
                     void PutException(std::exception_ptr ex)
@@ -97,62 +418,154 @@ namespace Mif
 
                     Common::Buffer GetBuffer()
                     {
-                        Common::Buffer result;
-
+                        std::string message;
+                        bool const hasException = !!m_exception;
+                        if (hasException)
                         {
-                            boost::iostreams::filtering_ostream stream(boost::iostreams::back_inserter(result));
-                            TArchive archive{stream};
-
-                            archive << boost::serialization::make_nvp(Detail::Tag::Uuid::Value, m_uuid);
-                            archive << boost::serialization::make_nvp(Detail::Tag::Type::Value, m_type);
-                            archive << boost::serialization::make_nvp(Detail::Tag::Instsnce::Value, m_instanceId);
-                            archive << boost::serialization::make_nvp(Detail::Tag::Interface::Value, m_interfaceId);
-                            archive << boost::serialization::make_nvp(Detail::Tag::Method::Value, m_methodId);
-
-                            bool hasException = !!m_exception;
-                            archive << boost::serialization::make_nvp(Detail::Tag::HasException::Value, hasException);
-
-                            if (hasException)
+                            try
+                            {
+                                std::rethrow_exception(m_exception);
+                            }
+                            catch (std::exception const &e)
+                            {
+                                message = e.what();
+                            }
+                            catch (...)
                             {
-                                std::string message;
-                                try
-                                {
-                                    std::rethrow_exception(m_exception);
-                                }
-                                catch (std::exception const &e)
-                                {
-                                    message = e.what();
-                                }
-                                catch (...)
-                                {
-                                    message = "Unknown exception.";
-                                }
-                                archive << boost::serialization::make_nvp(Detail::Tag::Exception::Value, message);
+                                message = "Unknown exception.";
                             }
+                        }
 
-                            m_params->Save(archive);
+                        Common::Buffer result;
+                        result.reserve(EstimateSize(message));
 
-                            stream.flush();
-                        }
+                        Save(result, hasException, message, static_cast<Detail::IsBinaryArchive<TArchive> const *>(nullptr));
 
                         return result;
                     }
 
                 private:
+                    // Fixed part of the archive: its header and the sizes of the fields.
+                    static constexpr std::size_t HeaderSize = 128;
+
+                    using ParamsStorage = typename std::aligned_storage<192>::type;
+
                     std::string m_type;
                     std::string m_uuid;
                     std::string m_instanceId;
                     std::string m_interfaceId;
                     std::string m_methodId;
+                    std::int64_t m_deadline = 0;
+                    std::uint32_t m_createService = 0;
+                    std::string m_createInterface;
                     std::exception_ptr m_exception{};
 
                     struct IData
                     {
                         virtual ~IData() = default;
                         virtual void Save(TArchive &archive) = 0;
+                        virtual void Save(Common::Buffer &buffer) = 0;
+                        virtual std::size_t EstimateSize() const = 0;
                     };
 
-                    std::unique_ptr<IData> m_params;
+                    // The parameters of the most calls are placed in the serializer, so there
+                    // is no allocation for them.
+                    ParamsStorage m_paramsStorage;
+                    IData *m_params = nullptr;
+                    bool m_isInlineParams = false;
+
+                    template <typename TPack, typename ... TParams>
+                    IData* CreateParams(std::true_type const *, TParams && ... params)
+                    {
+                        auto *pack = new (&m_paramsStorage) TPack{std::forward<TParams>(params) ... };
+                        m_isInlineParams = true;
+                        return pack;
+                    }
+
+                    template <typename TPack, typename ... TParams>
+                    IData* CreateParams(std::false_type const *, TParams && ... params)
+                    {
+                        auto *pack = new TPack{std::forward<TParams>(params) ... };
+                        m_isInlineParams = false;
+                        return pack;
+                    }
+
+                    void ResetParams()
+                    {
+                        if (!m_params)
+                            return;
+
+                        if (m_isInlineParams)
+                            m_params->~IData();
+                        else
+                            delete m_params;
+
+                        m_params = nullptr;
+                    }
+
+                    std::size_t EstimateSize(std::string const &message) const
+                    {
+                        auto size = HeaderSize + m_type.size() + m_uuid.size() + m_instanceId.size() +
+                                m_interfaceId.size() + m_methodId.size() + m_createInterface.size() + message.size();
+                        if (m_params)
+                            size += m_params->EstimateSize();
+                        // The text archives are larger than the binary ones.
+                        return Detail::IsBinaryArchive<TArchive>::value ? size : 2 * size;
+                    }
+
+                    // The fields are written directly to the buffer. The same data is made by the archive.
+                    void Save(Common::Buffer &buffer, bool hasException, std::string const &message, std::true_type const *)
+                    {
+                        if (!Detail::IsDirectFormat<TArchive>())
+                        {
+                            Save(buffer, hasException, message, static_cast<std::false_type const *>(nullptr));
+                            return;
+                        }
+
+                        Detail::BinaryWriter writer{buffer};
+
+                        writer.WriteHeader(Detail::GetArchiveHeader<TArchive>());
+                        writer.Write(m_uuid);
+                        writer.Write(m_type);
+                        writer.Write(m_instanceId);
+                        writer.Write(m_interfaceId);
+                        writer.Write(m_methodId);
+                        writer.Write(m_deadline);
+                        writer.Write(m_createService);
+                        writer.Write(m_createInterface);
+
+                        writer.Write(hasException);
+
+                        if (hasException)
+                            writer.Write(message);
+
+                        if (m_params)
+                            m_params->Save(buffer);
+                    }
+
+                    void Save(Common::Buffer &buffer, bool hasException, std::string const &message, std::false_type const *)
+                    {
+                        Serialization::Detail::BufferSink sink{buffer};
+                        Serialization::Detail::Archive<TArchive, std::ostream> holder{sink};
+                        auto &archive = holder.Get();
+
+                        archive << boost::serialization::make_nvp(Serialization::Detail::Tag::Uuid::Value, m_uuid);
+                        archive << boost::serialization::make_nvp(Serialization::Detail::Tag::Type::Value, m_type);
+                        archive << boost::serialization::make_nvp(Serialization::Detail::Tag::Instsnce::Value, m_instanceId);
+                        archive << boost::serialization::make_nvp(Serialization::Detail::Tag::Interface::Value, m_interfaceId);
+                        archive << boost::serialization::make_nvp(Serialization::Detail::Tag::Method::Value, m_methodId);
+                        archive << boost::serialization::make_nvp(Serialization::Detail::Tag::Deadline::Value, m_deadline);
+                        archive << boost::serialization::make_nvp(Serialization::Detail::Tag::CreateService::Value, m_createService);
+                        archive << boost::serialization::make_nvp(Serialization::Detail::Tag::CreateInterface::Value, m_createInterface);
+
+                        archive << boost::serialization::make_nvp(Serialization::Detail::Tag::HasException::Value, hasException);
+
+                        if (hasException)
+                            archive << boost::serialization::make_nvp(Serialization::Detail::Tag::Exception::Value, message);
+
+                        if (m_params)
+                            m_params->Save(archive);
+                    }
 
                     template <typename ... TParams>
                     class ParamPack final
@@ -165,32 +578,89 @@ namespace Mif
                         }
 
                     private:
-                        std::tuple<typename std::remove_cv<typename std::decay<TParams>::type>::type ... > m_params;
+                        using Params = std::tuple<typename std::remove_cv<typename std::decay<TParams>::type>::type ... >;
+                        using Count = std::integral_constant<std::size_t, std::tuple_size<Params>::value>;
+
+                        using IsPrimitive = std::integral_constant
+                            <
+                                bool,
+                                Detail::IsBinaryArchive<TArchive>::value &&
+                                    Detail::IsPrimitive<typename std::decay<TParams>::type ... >::value
+                            >;
+
+                        Params m_params;
+
                         // IData
                         virtual void Save(TArchive &archive) override final
                         {
-                            SaveParams(m_params, archive);
+                            SaveParams(archive, static_cast<Count const *>(nullptr));
+                        }
+
+                        virtual void Save(Common::Buffer &buffer) override final
+                        {
+                            SaveParams(buffer, static_cast<IsPrimitive const *>(nullptr),
+                                    static_cast<Detail::IsBinaryArchive<TArchive> const *>(nullptr));
+                        }
+
+                        virtual std::size_t EstimateSize() const override final
+                        {
+                            return EstimateParamsSize(static_cast<Count const *>(nullptr));
+                        }
+
+                        void SaveParams(Common::Buffer &buffer, std::true_type const *, std::true_type const *)
+                        {
+                            Detail::BinaryWriter writer{buffer};
+                            SaveParams(writer, static_cast<Count const *>(nullptr));
                         }
 
-                        template <typename T, std::size_t ... Indexes>
-                        void SaveTupleParams(T &params, TArchive &archive, Common::IndexSequence<Indexes ... > const *) const
+                        // The parameters of other types are saved by the archive without its header.
+                        void SaveParams(Common::Buffer &buffer, std::false_type const *, std::true_type const *)
                         {
-                            Common::Unused(archive << boost::serialization::make_nvp((Detail::Tag::Param::Value +
-                                std::to_string(Indexes)).c_str(), std::get<Indexes>(params)) ... );
+                            Serialization::Detail::BufferSink sink{buffer};
+                            Serialization::Detail::Archive<TArchive, std::ostream> holder{sink, boost::archive::no_header};
+                            SaveParams(holder.Get(), static_cast<Count const *>(nullptr));
                         }
 
-                        template <typename ... T>
-                        typename std::enable_if<std::tuple_size<std::tuple<T ... >>::value != 0, void>::type
-                        SaveParams(std::tuple<T ... > &params, TArchive &archive) const
+                        void SaveParams(Common::Buffer &, std::false_type const *, std::false_type const *)
                         {
-                            SaveTupleParams(params, archive,
-                                static_cast<Common::MakeIndexSequence<sizeof ... (T)> const *>(nullptr));
+                            throw std::logic_error{"[Mif::Remote::Serialization::Boost::Serializer::ParamPack::SaveParams] "
+                                "Only the binary archives can be written to the buffer directly."};
                         }
 
-                        template <typename ... T>
-                        typename std::enable_if<std::tuple_size<std::tuple<T ... >>::value == 0, void>::type
-                        SaveParams(std::tuple<T ... > &, TArchive &) const
+                        // The parameters are saved from the last one in order to keep the format.
+                        template <std::size_t Index>
+                        void SaveParams(TArchive &archive, std::integral_constant<std::size_t, Index> const *)
                         {
+                            archive << boost::serialization::make_nvp(Detail::ParamName<Index - 1>::Get(),
+                                    std::get<Index - 1>(m_params));
+                            SaveParams(archive, static_cast<std::integral_constant<std::size_t, Index - 1> const *>(nullptr));
+                        }
+
+                        void SaveParams(TArchive &, std::integral_constant<std::size_t, 0> const *)
+                        {
+                        }
+
+                        template <std::size_t Index>
+                        void SaveParams(Detail::BinaryWriter &writer, std::integral_constant<std::size_t, Index> const *)
+                        {
+                            writer.Write(std::get<Index - 1>(m_params));
+                            SaveParams(writer, static_cast<std::integral_constant<std::size_t, Index - 1> const *>(nullptr));
+                        }
+
+                        void SaveParams(Detail::BinaryWriter &, std::integral_constant<std::size_t, 0> const *)
+                        {
+                        }
+
+                        template <std::size_t Index>
+                        std::size_t EstimateParamsSize(std::integral_constant<std::size_t, Index> const *) const
+                        {
+                            return Detail::EstimateSize(std::get<Index - 1>(m_params)) +
+                                EstimateParamsSize(static_cast<std::integral_constant<std::size_t, Index - 1> const *>(nullptr));
+                        }
+
+                        std::size_t EstimateParamsSize(std::integral_constant<std::size_t, 0> const *) const
+                        {
+                            return 0;
                         }
                     };
                 };
@@ -201,35 +671,19 @@ namespace Mif
                 public:
                     Deserializer(Common::Buffer buffer)
                         : m_buffer(std::move(buffer))
-                        , m_source(!m_buffer.empty() ? m_buffer.data() : nullptr, m_buffer.size())
-                        , m_stream(m_source)
-                        , m_archive(m_stream)
                     {
                         if (m_buffer.empty())
                             throw std::invalid_argument{"[Mif::Remote::Serialization::Boost::Deserializer] Empty buffer."};
-                        m_archive >> boost::serialization::make_nvp(Detail::Tag::Uuid::Value, m_uuid);
-                        m_archive >> boost::serialization::make_nvp(Detail::Tag::Type::Value, m_type);
-                        m_archive >> boost::serialization::make_nvp(Detail::Tag::Instsnce::Value, m_instance);
-                        m_archive >> boost::serialization::make_nvp(Detail::Tag::Interface::Value, m_interface);
-                        m_archive >> boost::serialization::make_nvp(Detail::Tag::Method::Value, m_method);
 
-                        bool hasException = false;
-                        m_archive >> boost::serialization::make_nvp(Detail::Tag::HasException::Value, hasException);
-                        if (hasException)
-                        {
-                            std::string message;
-                            m_archive >> boost::serialization::make_nvp(Detail::Tag::Exception::Value, message);
-                            try
-                            {
-                                throw std::runtime_error{message};
-                            }
-                            catch (...)
-                            {
-                                m_exception = std::current_exception();
-                            }
-                        }
+                        if (!Load(static_cast<Detail::IsBinaryArchive<TArchive> const *>(nullptr)))
+                            LoadByArchive();
                     }
 
+                    Deserializer(Deserializer const &) = delete;
+                    Deserializer& operator = (Deserializer const &) = delete;
+                    Deserializer(Deserializer &&) = delete;
+                    Deserializer& operator = (Deserializer &&) = delete;
+
                     std::string const& GetUuid() const
                     {
                         return m_uuid;
@@ -237,12 +691,12 @@ namespace Mif
 
                     bool IsRequest() const
                     {
-                        return GetType() == Detail::Tag::Request::Value;
+                        return GetType() == Serialization::Detail::Tag::Request::Value;
                     }
 
                     bool IsResponse() const
                     {
-                        return GetType() == Detail::Tag::Response::Value;
+                        return GetType() == Serialization::Detail::Tag::Response::Value;
                     }
 
                     std::string const& GetType() const
@@ -265,18 +719,31 @@ namespace Mif
                         return m_method;
                     }
 
+                    std::int64_t GetDeadline() const
+                    {
+                        return m_deadline;
+                    }
+
+                    std::uint32_t GetCreationService() const
+                    {
+                        return m_createService;
+                    }
+
+                    std::string const& GetCreationInterface() const
+                    {
+                        return m_createInterface;
+                    }
+
                     template <typename ... TParams>
                     std::tuple<typename std::decay<TParams>::type ... > GetParams() const
                     {
                         using TResult = std::tuple<typename std::decay<TParams>::type ... >;
+                        using Count = std::integral_constant<std::size_t, std::tuple_size<TResult>::value>;
+
+                        using IsPrimitive = Detail::IsPrimitive<typename std::decay<TParams>::type ... >;
+
                         TResult res;
-                        LoadParams(reinterpret_cast
-                                    <
-                                        std::integral_constant
-                                            <
-                                                std::size_t, std::tuple_size<TResult>::value
-                                            > const *
-                                    >(0), res);
+                        LoadParams(static_cast<Count const *>(nullptr), static_cast<IsPrimitive const *>(nullptr), res);
                         return res;
                     }
 
@@ -291,37 +758,155 @@ namespace Mif
                     }
 
                 private:
-                    using SourceType = boost::iostreams::basic_array_source<char>;
+                    using Archive = Serialization::Detail::Archive<TArchive, std::istream>;
+
                     Common::Buffer m_buffer;
-                    SourceType m_source;
-                    boost::iostreams::stream<SourceType> m_stream;
-                    mutable TArchive m_archive;
+                    char const *m_params = nullptr;
+
+                    // The archive is made only for the data which can't be read directly.
+                    mutable boost::optional<Serialization::Detail::BufferSource> m_source;
+                    mutable boost::optional<Archive> m_archive;
+
                     std::string m_uuid;
                     std::string m_type;
                     std::string m_instance;
                     std::string m_interface;
                     std::string m_method;
+                    std::int64_t m_deadline = 0;
+                    std::uint32_t m_createService = 0;
+                    std::string m_createInterface;
                     std::exception_ptr m_exception;
 
-                    template <std::size_t Index, typename TParams,
+                    bool Load(std::true_type const *)
+                    {
+                        if (!Detail::IsDirectFormat<TArchive>())
+                            return false;
+
+                        Detail::BinaryReader reader{m_buffer.data(), m_buffer.data() + m_buffer.size()};
+                        if (!reader.ReadHeader(Detail::GetArchiveHeader<typename Detail::OutputArchive<TArchive>::Type>()))
+                            return false;
+
+                        reader.Read(m_uuid);
+                        reader.Read(m_type);
+                        reader.Read(m_instance);
+                        reader.Read(m_interface);
+                        reader.Read(m_method);
+                        reader.Read(m_deadline);
+                        reader.Read(m_createService);
+                        reader.Read(m_createInterface);
+
+                        bool hasException = false;
+                        reader.Read(hasException);
+                        if (hasException)
+                        {
+                            std::string message;
+                            reader.Read(message);
+                            SetException(std::move(message));
+                        }
+
+                        m_params = reader.GetPosition();
+
+                        return true;
+                    }
+
+                    bool Load(std::false_type const *)
+                    {
+                        return false;
+                    }
+
+                    void LoadByArchive()
+                    {
+                        m_source.emplace(m_buffer.data(), m_buffer.data() + m_buffer.size());
+                        m_archive.emplace(*m_source);
+
+                        auto &archive = m_archive->Get();
+                        archive >> boost::serialization::make_nvp(Serialization::Detail::Tag::Uuid::Value, m_uuid);
+                        archive >> boost::serialization::make_nvp(Serialization::Detail::Tag::Type::Value, m_type);
+                        archive >> boost::serialization::make_nvp(Serialization::Detail::Tag::Instsnce::Value, m_instance);
+                        archive >> boost::serialization::make_nvp(Serialization::Detail::Tag::Interface::Value, m_interface);
+                        archive >> boost::serialization::make_nvp(Serialization::Detail::Tag::Method::Value, m_method);
+                        archive >> boost::serialization::make_nvp(Serialization::Detail::Tag::Deadline::Value, m_deadline);
+                        archive >> boost::serialization::make_nvp(Serialization::Detail::Tag::CreateService::Value, m_createService);
+                        archive >> boost::serialization::make_nvp(Serialization::Detail::Tag::CreateInterface::Value, m_createInterface);
+
+                        bool hasException = false;
+                        archive >> boost::serialization::make_nvp(Serialization::Detail::Tag::HasException::Value, hasException);
+                        if (hasException)
+                        {
+                            std::string message;
+                            archive >> boost::serialization::make_nvp(Serialization::Detail::Tag::Exception::Value, message);
+                            SetException(std::move(message));
+                        }
+                    }
+
+                    void SetException(std::string message)
+                    {
+                        try
+                        {
+                            throw std::runtime_error{std::move(message)};
+                        }
+                        catch (...)
+                        {
+                            m_exception = std::current_exception();
+                        }
+                    }
+
+                    // The parameters which follow the directly read header are read by the archive
+                    // without its header.
+                    TArchive& GetArchive() const
+                    {
+                        if (!m_archive)
+                        {
+                            m_source.emplace(m_params, m_buffer.data() + m_buffer.size());
+                            m_archive.emplace(*m_source, boost::archive::no_header);
+                        }
+                        return m_archive->Get();
+                    }
+
+                    template <typename TCount, typename TParams>
+                    void LoadParams(TCount const *count, std::true_type const *, TParams &params) const
+                    {
+                        if (m_archive)
+                        {
+                            LoadParams(count, GetArchive(), params);
+                            return;
+                        }
+
+                        Detail::BinaryReader reader{m_params, m_buffer.data() + m_buffer.size()};
+                        LoadParams(count, reader, params);
+                    }
+
+                    template <typename TCount, typename TParams>
+                    void LoadParams(TCount const *count, std::false_type const *, TParams &params) const
+                    {
+                        LoadParams(count, GetArchive(), params);
+                    }
+
+                    template <std::size_t Index, typename TReader, typename TParams,
                               typename = typename std::enable_if<Index>::type>
                     void LoadParams(std::integral_constant<std::size_t, Index> const *,
-                                   TParams &params) const
+                                    TReader &reader, TParams &params) const
+                    {
+                        Load(reader, std::get<Index - 1>(params), Detail::ParamName<Index - 1>::Get());
+                        LoadParams(static_cast<std::integral_constant<std::size_t, Index - 1> const *>(nullptr),
+                                reader, params);
+                    }
+
+                    template <typename TReader, typename TParams>
+                    void LoadParams(std::integral_constant<std::size_t, 0> const *, TReader &, TParams &) const
+                    {
+                    }
+
+                    template <typename T>
+                    static void Load(TArchive &archive, T &param, char const *name)
                     {
-                        auto &param = std::get<Index - 1>(params);
-                        m_archive >> boost::serialization::make_nvp((Detail::Tag::Param::Value + std::to_string(Index)).c_str(), param);
-                        LoadParams(reinterpret_cast
-                                    <
-                                        std::integral_constant
-                                            <
-                                                std::size_t, Index - 1
-                                            > const *
-                                    >(0), params);
+                        archive >> boost::serialization::make_nvp(name, param);
                     }
 
-                    template <typename TParams>
-                    void LoadParams(std::integral_constant<std::size_t, 0> const *, TParams &) const
+                    template <typename T>
+                    static void Load(Detail::BinaryReader &reader, T &param, char const *)
                     {
+                        reader.Read(param);
                     }
                 };
 
@@ -0,0 +1,116 @@
+//-------------------------------------------------------------------
+//  MetaInfo Framework (MIF)
+//  https://github.com/tdv/mif
+//  Created:     10.2026
+//  Copyright (C) 2016-2024 tdv
+//-------------------------------------------------------------------
+
+#ifndef __MIF_REMOTE_SERIALIZATION_DETAIL_BUFFER_STREAM_H__
+#define __MIF_REMOTE_SERIALIZATION_DETAIL_BUFFER_STREAM_H__
+
+// STD
+#include <cstddef>
+#include <ios>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <type_traits>
+
+// MIF
+#include "mif/common/types.h"
+
+namespace Mif
+{
+    namespace Remote
+    {
+        namespace Serialization
+        {
+            namespace Detail
+            {
+
+                // Appends the written data to the buffer without any intermediate storage.
+                class BufferSink final
+                    : public std::streambuf
+                {
+                public:
+                    BufferSink(Common::Buffer &buffer)
+                        : m_buffer(buffer)
+                    {
+                    }
+
+                private:
+                    Common::Buffer &m_buffer;
+
+                    virtual int_type overflow(int_type ch) override final
+                    {
+                        if (traits_type::eq_int_type(ch, traits_type::eof()))
+                            return traits_type::not_eof(ch);
+                        m_buffer.push_back(traits_type::to_char_type(ch));
+                        return ch;
+                    }
+
+                    virtual std::streamsize xsputn(char_type const *data, std::streamsize size) override final
+                    {
+                        m_buffer.insert(std::end(m_buffer), data, data + size);
+                        return size;
+                    }
+                };
+
+                // Reads the data of the buffer in place.
+                class BufferSource final
+                    : public std::streambuf
+                {
+                public:
+                    BufferSource(char const *begin, char const *end)
+                    {
+                        auto *data = const_cast<char_type *>(begin);
+                        setg(data, data, data + (end - begin));
+                    }
+                };
+
+                // The binary archives work on the stream buffer directly, the other ones need a stream.
+                template <typename TArchive, typename TStream,
+                          bool = std::is_constructible<TArchive, std::streambuf &>::value>
+                class Archive final
+                {
+                public:
+                    Archive(std::streambuf &buffer, unsigned flags = 0)
+                        : m_archive(buffer, flags)
+                    {
+                    }
+
+                    TArchive& Get()
+                    {
+                        return m_archive;
+                    }
+
+                private:
+                    TArchive m_archive;
+                };
+
+                template <typename TArchive, typename TStream>
+                class Archive<TArchive, TStream, false> final
+                {
+                public:
+                    Archive(std::streambuf &buffer, unsigned flags = 0)
+                        : m_stream(&buffer)
+                        , m_archive(m_stream, flags)
+                    {
+                    }
+
+                    TArchive& Get()
+                    {
+                        return m_archive;
+                    }
+
+                private:
+                    TStream m_stream;
+                    TArchive m_archive;
+                };
+
+            }   // namespace Detail
+        }   // namespace Serialization
+    }   // namespace Remote
+}   // namespace Mif
+
+#endif  // !__MIF_REMOTE_SERIALIZATION_DETAIL_BUFFER_STREAM_H__
@@ -30,6 +30,9 @@ namespace Mif
                     using Instsnce = MIF_STATIC_STR("instance");
                     using Interface = MIF_STATIC_STR("interface");
                     using Method = MIF_STATIC_STR("method");
+                    using Deadline = MIF_STATIC_STR("deadline");
+                    using CreateService = MIF_STATIC_STR("create_service");
+                    using CreateInterface = MIF_STATIC_STR("create_interface");
                     using Param = MIF_STATIC_STR("prm");
                     using Exception = MIF_STATIC_STR("exception");
 
@@ -9,6 +9,7 @@
 #define __MIF_REMOTE_SERIALIZATION_JSON_H__
 
 // STD
+#include <cstdint>
 #include <stdexcept>
 #include <string>
 #include <tuple>
@@ -63,6 +64,28 @@ namespace Mif
                         m_value[Detail::Tag::Param::Value] = ::Mif::Serialization::Json::Detail::ValueToJson(tuple);
                     }
 
+                    void SetDeadline(std::int64_t deadline)
+                    {
+                        if (deadline)
+                            m_value[Detail::Tag::Deadline::Value] = deadline;
+                        else
+                            m_value.erase(Detail::Tag::Deadline::Value);
+                    }
+
+                    void SetCreation(std::uint32_t serviceId, std::string const &interfaceId)
+                    {
+                        if (!interfaceId.empty())
+                        {
+                            m_value[Detail::Tag::CreateService::Value] = serviceId;
+                            m_value[Detail::Tag::CreateInterface::Value] = interfaceId;
+                        }
+                        else
+                        {
+                            m_value.erase(Detail::Tag::CreateService::Value);
+                            m_value.erase(Detail::Tag::CreateInterface::Value);
+                        }
+                    }
+
                     void PutException(std::exception_ptr ex)
                     {
                         {
@@ -112,11 +135,13 @@ namespace Mif
                 {
                 public:
                     Deserializer(Common::Buffer buffer)
+                        : m_storage{boost::json::make_shared_resource<boost::json::monotonic_resource>()}
+                        , m_value(m_storage)
                     {
                         if (buffer.empty())
                             throw std::invalid_argument{"[Mif::Remote::Serialization::Json::Deserializer] Empty buffer."};
 
-                        auto val = boost::json::parse(boost::string_view{buffer.data(), buffer.size()});
+                        auto val = boost::json::parse(boost::string_view{buffer.data(), buffer.size()}, m_storage);
 
                         if (val.is_null())
                             throw std::invalid_argument{"[Mif::Remote::Serialization::Json::Deserializer] Empty json object."};
@@ -124,7 +149,8 @@ namespace Mif
                         if (!val.is_object())
                             throw std::invalid_argument{"[Mif::Remote::Serialization::Json::Deserializer] Json is no object type."};
 
-                        m_value = val.as_object();
+                        // The same storage lets the object be taken without the copying.
+                        m_value = std::move(val.as_object());
                     }
 
                     std::string const GetUuid() const
@@ -162,6 +188,24 @@ namespace Mif
                         return m_value.at(Detail::Tag::Method::Value).as_string().c_str();
                     }
 
+                    std::int64_t GetDeadline() const
+                    {
+                        auto iter = m_value.find(Detail::Tag::Deadline::Value);
+                        return iter != std::end(m_value) ? iter->value().as_int64() : 0;
+                    }
+
+                    std::uint32_t GetCreationService() const
+                    {
+                        auto iter = m_value.find(Detail::Tag::CreateService::Value);
+                        return iter != std::end(m_value) ? boost::json::value_to<std::uint32_t>(iter->value()) : 0;
+                    }
+
+                    std::string const GetCreationInterface() const
+                    {
+                        auto iter = m_value.find(Detail::Tag::CreateInterface::Value);
+                        return iter != std::end(m_value) ? iter->value().as_string().c_str() : std::string{};
+                    }
+
                     template <typename ... TParams>
                     std::tuple<typename std::decay<TParams>::type ... > GetParams() const
                     {
@@ -194,6 +238,8 @@ namespace Mif
                     }
 
                 private:
+                    // All nodes of the message live in one arena which is released with the deserializer.
+                    boost::json::storage_ptr m_storage;
                     boost::json::object m_value;
 
                     template <typename ... TParams>
@@ -0,0 +1,367 @@
+//-------------------------------------------------------------------
+//  MetaInfo Framework (MIF)
+//  https://github.com/tdv/mif
+//  Created:     10.2026
+//  Copyright (C) 2016-2024 tdv
+//-------------------------------------------------------------------
+
+#ifndef __MIF_REMOTE_SERIALIZATION_MSGPACK_H__
+#define __MIF_REMOTE_SERIALIZATION_MSGPACK_H__
+
+// STD
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// MIF
+#include "mif/common/types.h"
+#include "mif/remote/serialization/detail/tag.h"
+#include "mif/serialization/msgpack.h"
+
+namespace Mif
+{
+    namespace Remote
+    {
+        namespace Serialization
+        {
+            namespace MsgPack
+            {
+
+                // The message is a msgpack map with the same keys as the json message has,
+                // so the clients in other languages can make and read it with any msgpack library.
+                class Serializer final
+                {
+                public:
+                    template <typename ... TParams>
+                    Serializer(bool isReques, std::string const &uuid,
+                        std::string const &instanceId, std::string const &interfaceId,
+                        std::string const &methodId, TParams && ... params)
+                        : m_isRequest{isReques}
+                        , m_uuid{uuid}
+                        , m_instanceId{instanceId}
+                        , m_interfaceId{interfaceId}
+                        , m_methodId{methodId}
+                    {
+                        PutParams(std::forward<TParams>(params) ... );
+                    }
+
+                    template <typename ... TParams>
+                    void PutParams(TParams && ... params)
+                    {
+                        m_params.clear();
+                        ::Mif::Serialization::Reserve<::Mif::Serialization::Estimate::MsgPack>(m_params,
+                                std::forward_as_tuple(params ... ));
+                        ::Mif::Serialization::MsgPack::Detail::Writer writer{m_params};
+                        writer.WriteArrayHeader(sizeof ... (TParams));
+                        WriteParams(writer, std::forward<TParams>(params) ... );
+                    }
+
+                    void SetDeadline(std::int64_t deadline)
+                    {
+                        m_deadline = deadline;
+                    }
+
+                    void SetCreation(std::uint32_t serviceId, std::string const &interfaceId)
+                    {
+                        m_createService = serviceId;
+                        m_createInterface = interfaceId;
+                    }
+
+                    void PutException(std::exception_ptr ex)
+                    {
+                        m_hasException = true;
+
+                        try
+                        {
+                            std::rethrow_exception(ex);
+                        }
+                        catch (std::exception const &e)
+                        {
+                            m_exception = e.what();
+                        }
+                        catch (...)
+                        {
+                            m_exception = "Unknown exception.";
+                        }
+                    }
+
+                    Common::Buffer GetBuffer()
+                    {
+                        Common::Buffer buffer;
+                        buffer.reserve(128 + m_uuid.size() + m_instanceId.size() + m_interfaceId.size() +
+                                m_methodId.size() + m_createInterface.size() + m_exception.size() + m_params.size());
+
+                        using namespace ::Mif::Serialization::MsgPack::Detail;
+
+                        Writer writer{buffer};
+                        writer.WriteMapHeader(6 + (m_deadline ? 1 : 0) + (!m_createInterface.empty() ? 2 : 0) +
+                                (m_hasException ? 1 : 0));
+
+                        WriteKey<Detail::Tag::Uuid>(writer);
+                        Write(writer, m_uuid);
+                        WriteKey<Detail::Tag::Type>(writer);
+                        if (m_isRequest)
+                            WriteKey<Detail::Tag::Request>(writer);
+                        else
+                            WriteKey<Detail::Tag::Response>(writer);
+                        WriteKey<Detail::Tag::Instsnce>(writer);
+                        Write(writer, m_instanceId);
+                        WriteKey<Detail::Tag::Interface>(writer);
+                        Write(writer, m_interfaceId);
+                        WriteKey<Detail::Tag::Method>(writer);
+                        Write(writer, m_methodId);
+
+                        if (m_deadline)
+                        {
+                            WriteKey<Detail::Tag::Deadline>(writer);
+                            Write(writer, m_deadline);
+                        }
+
+                        if (!m_createInterface.empty())
+                        {
+                            WriteKey<Detail::Tag::CreateService>(writer);
+                            Write(writer, m_createService);
+                            WriteKey<Detail::Tag::CreateInterface>(writer);
+                            Write(writer, m_createInterface);
+                        }
+
+                        if (m_hasException)
+                        {
+                            WriteKey<Detail::Tag::Exception>(writer);
+                            Write(writer, m_exception);
+                        }
+
+                        WriteKey<Detail::Tag::Param>(writer);
+                        writer.WriteRange(std::begin(m_params), std::end(m_params));
+
+                        return buffer;
+                    }
+
+                private:
+                    bool m_isRequest;
+                    std::string m_uuid;
+                    std::string m_instanceId;
+                    std::string m_interfaceId;
+                    std::string m_methodId;
+                    std::int64_t m_deadline = 0;
+                    std::uint32_t m_createService = 0;
+                    std::string m_createInterface;
+                    bool m_hasException = false;
+                    std::string m_exception;
+                    Common::Buffer m_params;
+
+                    template <typename TKey>
+                    static void WriteKey(::Mif::Serialization::MsgPack::Detail::Writer &writer)
+                    {
+                        writer.WriteString(TKey::Value, std::strlen(TKey::Value));
+                    }
+
+                    template <typename TParam, typename ... TParams>
+                    static void WriteParams(::Mif::Serialization::MsgPack::Detail::Writer &writer,
+                            TParam const &param, TParams const & ... params)
+                    {
+                        ::Mif::Serialization::MsgPack::Detail::Write(writer, param);
+                        WriteParams(writer, params ... );
+                    }
+
+                    static void WriteParams(::Mif::Serialization::MsgPack::Detail::Writer &)
+                    {
+                    }
+                };
+
+                class Deserializer final
+                {
+                public:
+                    Deserializer(Common::Buffer buffer)
+                        : m_buffer(std::move(buffer))
+                    {
+                        if (m_buffer.empty())
+                            throw std::invalid_argument{"[Mif::Remote::Serialization::MsgPack::Deserializer] Empty buffer."};
+
+                        using namespace ::Mif::Serialization::MsgPack::Detail;
+
+                        Reader reader{m_buffer.data(), m_buffer.data() + m_buffer.size()};
+
+                        bool hasType = false;
+                        bool hasParams = false;
+                        bool hasException = false;
+                        std::string exception;
+
+                        for (auto count = reader.ReadMapHeader() ; count ; --count)
+                        {
+                            char const *key = nullptr;
+                            auto const size = reader.ReadString(key);
+
+                            if (IsKey(Detail::Tag::Uuid::Value, key, size))
+                            {
+                                Read(reader, m_uuid);
+                            }
+                            else if (IsKey(Detail::Tag::Type::Value, key, size))
+                            {
+                                std::string type;
+                                Read(reader, type);
+                                if (type != Detail::Tag::Request::Value && type != Detail::Tag::Response::Value)
+                                    throw std::invalid_argument{"[Mif::Remote::Serialization::MsgPack::Deserializer] Bad message type."};
+                                m_isRequest = type == Detail::Tag::Request::Value;
+                                hasType = true;
+                            }
+                            else if (IsKey(Detail::Tag::Instsnce::Value, key, size))
+                            {
+                                Read(reader, m_instance);
+                            }
+                            else if (IsKey(Detail::Tag::Interface::Value, key, size))
+                            {
+                                Read(reader, m_interface);
+                            }
+                            else if (IsKey(Detail::Tag::Method::Value, key, size))
+                            {
+                                Read(reader, m_method);
+                            }
+                            else if (IsKey(Detail::Tag::Deadline::Value, key, size))
+                            {
+                                Read(reader, m_deadline);
+                            }
+                            else if (IsKey(Detail::Tag::CreateService::Value, key, size))
+                            {
+                                Read(reader, m_createService);
+                            }
+                            else if (IsKey(Detail::Tag::CreateInterface::Value, key, size))
+                            {
+                                Read(reader, m_createInterface);
+                            }
+                            else if (IsKey(Detail::Tag::Exception::Value, key, size))
+                            {
+                                Read(reader, exception);
+                                hasException = true;
+                            }
+                            else if (IsKey(Detail::Tag::Param::Value, key, size))
+                            {
+                                // The parameters are read later when their types are known.
+                                m_params = static_cast<std::size_t>(reader.GetPosition() - m_buffer.data());
+                                reader.Skip();
+                                m_paramsEnd = static_cast<std::size_t>(reader.GetPosition() - m_buffer.data());
+                                hasParams = true;
+                            }
+                            else
+                            {
+                                reader.Skip();
+                            }
+                        }
+
+                        if (!hasType)
+                            throw std::invalid_argument{"[Mif::Remote::Serialization::MsgPack::Deserializer] No message type."};
+
+                        if (!hasParams)
+                            throw std::invalid_argument{"[Mif::Remote::Serialization::MsgPack::Deserializer] No parameters."};
+
+                        if (hasException)
+                        {
+                            try
+                            {
+                                throw std::runtime_error{std::move(exception)};
+                            }
+                            catch (...)
+                            {
+                                m_exception = std::current_exception();
+                            }
+                        }
+                    }
+
+                    std::string const& GetUuid() const
+                    {
+                        return m_uuid;
+                    }
+
+                    bool IsRequest() const
+                    {
+                        return m_isRequest;
+                    }
+
+                    bool IsResponse() const
+                    {
+                        return !m_isRequest;
+                    }
+
+                    std::string GetType() const
+                    {
+                        return m_isRequest ? Detail::Tag::Request::Value : Detail::Tag::Response::Value;
+                    }
+
+                    std::string const& GetInstance() const
+                    {
+                        return m_instance;
+                    }
+
+                    std::string const& GetInterface() const
+                    {
+                        return m_interface;
+                    }
+
+                    std::string const& GetMethod() const
+                    {
+                        return m_method;
+                    }
+
+                    std::int64_t GetDeadline() const
+                    {
+                        return m_deadline;
+                    }
+
+                    std::uint32_t GetCreationService() const
+                    {
+                        return m_createService;
+                    }
+
+                    std::string const& GetCreationInterface() const
+                    {
+                        return m_createInterface;
+                    }
+
+                    template <typename ... TParams>
+                    std::tuple<typename std::decay<TParams>::type ... > GetParams() const
+                    {
+                        std::tuple<typename std::decay<TParams>::type ... > res;
+                        ::Mif::Serialization::MsgPack::Detail::Reader reader{m_buffer.data() + m_params,
+                                m_buffer.data() + m_paramsEnd};
+                        ::Mif::Serialization::MsgPack::Detail::Read(reader, res);
+                        return res;
+                    }
+
+                    bool HasException() const
+                    {
+                        return !!m_exception;
+                    }
+
+                    std::exception_ptr GetException() const
+                    {
+                        return m_exception;
+                    }
+
+                private:
+                    Common::Buffer m_buffer;
+                    std::size_t m_params = 0;
+                    std::size_t m_paramsEnd = 0;
+
+                    bool m_isRequest = false;
+                    std::string m_uuid;
+                    std::string m_instance;
+                    std::string m_interface;
+                    std::string m_method;
+                    std::int64_t m_deadline = 0;
+                    std::uint32_t m_createService = 0;
+                    std::string m_createInterface;
+                    std::exception_ptr m_exception;
+                };
+
+            }   // namespace MsgPack
+        }   // namespace Serialization
+    }   //  namespace Remote
+}   // namespace Mif
+
+
+#endif  // !__MIF_REMOTE_SERIALIZATION_MSGPACK_H__
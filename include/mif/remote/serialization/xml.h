@@ -9,18 +9,14 @@
 #define __MIF_REMOTE_SERIALIZATION_XML_H__
 
 // STD
+#include <cstdint>
+#include <cstdlib>
 #include <stdexcept>
 #include <string>
 #include <tuple>
 #include <type_traits>
 #include <utility>
 
-// BOOST
-#include <boost/iostreams/device/back_inserter.hpp>
-#include <boost/iostreams/device/array.hpp>
-#include <boost/iostreams/filtering_stream.hpp>
-#include <boost/iostreams/stream.hpp>
-
 // PUGIXML
 #include <pugixml.hpp>
 
@@ -86,6 +82,35 @@ namespace Mif
                         ::Mif::Serialization::Xml::Detail::Serialize(m_root, tuple, Detail::Tag::Param::Value);
                     }
 
+                    void SetDeadline(std::int64_t deadline)
+                    {
+                        m_root.remove_child(Detail::Tag::Deadline::Value);
+
+                        if (deadline)
+                        {
+                            m_root.append_child(Detail::Tag::Deadline::Value)
+                                    .append_child(pugi::xml_node_type::node_pcdata)
+                                    .set_value(std::to_string(deadline).c_str());
+                        }
+                    }
+
+                    void SetCreation(std::uint32_t serviceId, std::string const &interfaceId)
+                    {
+                        m_root.remove_child(Detail::Tag::CreateService::Value);
+                        m_root.remove_child(Detail::Tag::CreateInterface::Value);
+
+                        if (!interfaceId.empty())
+                        {
+                            m_root.append_child(Detail::Tag::CreateService::Value)
+                                    .append_child(pugi::xml_node_type::node_pcdata)
+                                    .set_value(std::to_string(serviceId).c_str());
+
+                            m_root.append_child(Detail::Tag::CreateInterface::Value)
+                                    .append_child(pugi::xml_node_type::node_pcdata)
+                                    .set_value(interfaceId.c_str());
+                        }
+                    }
+
                     void PutException(std::exception_ptr ex)
                     {
                         m_root.remove_child(Detail::Tag::Exception::Value);
@@ -111,13 +136,8 @@ namespace Mif
                     Common::Buffer GetBuffer()
                     {
                         Common::Buffer buffer;
-
-                        {
-                            boost::iostreams::filtering_ostream stream{boost::iostreams::back_inserter(buffer)};
-                            m_doc.save(stream);
-                            stream.flush();
-                        }
-
+                        ::Mif::Serialization::Xml::Detail::BufferWriter writer{buffer};
+                        m_doc.save(writer);
                         return buffer;
                     }
 
@@ -143,23 +163,20 @@ namespace Mif
                 {
                 public:
                     Deserializer(Common::Buffer buffer)
+                        : m_buffer(std::move(buffer))
                     {
-                        if (buffer.empty())
+                        if (m_buffer.empty())
                             throw std::invalid_argument{"[Mif::Remote::Serialization::Xml::Deserializer] Empty buffer."};
 
+                        // The document refers to the buffer parsed in place.
+                        auto result = m_doc.load_buffer_inplace(m_buffer.data(), m_buffer.size());
+                        if (!result)
                         {
-                            using SourceType = boost::iostreams::basic_array_source<char>;
-                            SourceType source{!buffer.empty() ? buffer.data() : nullptr, buffer.size()};
-                            boost::iostreams::stream<SourceType> stream{source};
-                            auto result = m_doc.load(stream);
-                            if (!result)
-                            {
-                                throw std::invalid_argument{"[Mif::Remote::Serialization::Xml::Deserializer] Bad xml. "
-                                        "Error" + std::string{result.description()}};
-                            }
-
-                            m_root = m_doc.child(Detail::Tag::Pack::Value);
+                            throw std::invalid_argument{"[Mif::Remote::Serialization::Xml::Deserializer] Bad xml. "
+                                    "Error" + std::string{result.description()}};
                         }
+
+                        m_root = m_doc.child(Detail::Tag::Pack::Value);
                     }
 
                     std::string const GetUuid() const
@@ -197,6 +214,22 @@ namespace Mif
                         return m_root.child(Detail::Tag::Method::Value).child_value();
                     }
 
+                    std::int64_t GetDeadline() const
+                    {
+                        return std::strtoll(m_root.child(Detail::Tag::Deadline::Value).child_value(), nullptr, 10);
+                    }
+
+                    std::uint32_t GetCreationService() const
+                    {
+                        return static_cast<std::uint32_t>(std::strtoul(
+                                m_root.child(Detail::Tag::CreateService::Value).child_value(), nullptr, 10));
+                    }
+
+                    std::string const GetCreationInterface() const
+                    {
+                        return m_root.child(Detail::Tag::CreateInterface::Value).child_value();
+                    }
+
                     template <typename ... TParams>
                     std::tuple<typename std::decay<TParams>::type ... > GetParams() const
                     {
@@ -229,6 +262,7 @@ namespace Mif
                     }
 
                 private:
+                    Common::Buffer m_buffer;
                     pugi::xml_document m_doc;
                     pugi::xml_node m_root;
 
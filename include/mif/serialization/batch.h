@@ -0,0 +1,598 @@
+//-------------------------------------------------------------------
+//  MetaInfo Framework (MIF)
+//  https://github.com/tdv/mif
+//  Created:     10.2026
+//  Copyright (C) 2016-2024 tdv
+//-------------------------------------------------------------------
+
+#ifndef __MIF_SERIALIZATION_BATCH_H__
+#define __MIF_SERIALIZATION_BATCH_H__
+
+// STD
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// MIF
+#include "mif/common/index_sequence.h"
+#include "mif/common/static_string.h"
+#include "mif/common/types.h"
+#include "mif/common/unused.h"
+#include "mif/reflection/soa_vector.h"
+#include "mif/serialization/binary.h"
+#include "mif/serialization/json_reader.h"
+#include "mif/serialization/json_writer.h"
+#include "mif/serialization/msgpack.h"
+
+// The batch is the columnar form of a vector of the reflected structures. The names of the fields
+// are written once and then the values of each field are written as one array.
+//  - json: {"count": N, "fields": ["name", ...], "columns": [[value, ...], ...]}
+//  - msgpack: the map with the same keys as json has
+//  - binary: the varint count, the varint number of the fields, the names of the fields and then
+//    the columns in the compact binary format, each one prefixed by its size
+// The fields of the reflected bases are named by the path of the base names, e.g. "Human.name".
+// The columns are matched with the fields by the names, so the unknown columns are skipped and the
+// missing ones are filled with the default values. The count has to be the size of each read column
+// and can't exceed the size of the input if any column is missing. The fields have to go before
+// the columns.
+
+namespace Mif
+{
+    namespace Serialization
+    {
+        namespace Batch
+        {
+            namespace Detail
+            {
+                namespace Tag
+                {
+
+                    using Count = MIF_STATIC_STR("count");
+                    using Fields = MIF_STATIC_STR("fields");
+                    using Columns = MIF_STATIC_STR("columns");
+
+                }   // namespace Tag
+
+                constexpr auto NoColumn = std::numeric_limits<std::size_t>::max();
+
+                // The names of the columns of Reflection::SoAVector<T>.
+                template <typename T>
+                class ColumnNames final
+                {
+                public:
+                    static ColumnNames const& Get()
+                    {
+                        static ColumnNames const names;
+                        return names;
+                    }
+
+                    std::string const& GetName(std::size_t index) const
+                    {
+                        return m_names[index];
+                    }
+
+                    // Returns NoColumn if there is no column with the name. The search starts from
+                    // the hint, because the columns usually go in the order they are written.
+                    std::size_t Find(char const *name, std::size_t size, std::size_t hint) const
+                    {
+                        for (std::size_t i = 0 ; i < m_names.size() ; ++i)
+                        {
+                            auto const index = (hint + i) % m_names.size();
+                            auto const &item = m_names[index];
+                            if (item.size() == size && !std::memcmp(item.data(), name, size))
+                                return index;
+                        }
+                        return NoColumn;
+                    }
+
+                private:
+                    using Fields = typename Reflection::SoAVector<T>::Fields;
+
+                    static constexpr std::size_t Count = std::tuple_size<Fields>::value;
+
+                    std::vector<std::string> m_names;
+
+                    ColumnNames()
+                    {
+                        Fill(static_cast<Common::MakeIndexSequence<Count> const *>(nullptr));
+                    }
+
+                    template <std::size_t ... Indexes>
+                    void Fill(Common::IndexSequence<Indexes ... > const *)
+                    {
+                        m_names = {MakeName<typename std::tuple_element<Indexes, Fields>::type>() ... };
+                    }
+
+                    template <typename TField>
+                    static std::string MakeName()
+                    {
+                        std::string name;
+                        AppendPath(name, static_cast<typename TField::Path const *>(nullptr));
+                        name.append(TField::Info::Name::Value);
+                        return name;
+                    }
+
+                    // The first item is for the fields of the struct itself, they have no path.
+                    template <typename ... TPath>
+                    static void AppendPath(std::string &name, std::tuple<TPath ... > const *)
+                    {
+                        char const *const path[] = {nullptr, Reflection::Reflect<TPath>::Name::Value ... };
+                        for (std::size_t i = 1 ; i < sizeof(path) / sizeof(path[0]) ; ++i)
+                            name.append(path[i]).append(1, '.');
+                    }
+                };
+
+                struct JsonFormat final
+                {
+                    using Reader = Json::Detail::StreamReader;
+
+                    template <typename T>
+                    static void ReadColumn(Reader &reader, T &column)
+                    {
+                        Json::Detail::ReadValue(reader, column);
+                    }
+                };
+
+                struct MsgPackFormat final
+                {
+                    using Reader = MsgPack::Detail::Reader;
+
+                    template <typename T>
+                    static void ReadColumn(Reader &reader, T &column)
+                    {
+                        MsgPack::Detail::Read(reader, column);
+                    }
+                };
+
+                // Each column is read by its own reader over the data of the column.
+                struct BinaryFormat final
+                {
+                    using Reader = Binary::Detail::Reader;
+
+                    template <typename T>
+                    static void ReadColumn(Reader &reader, T &column)
+                    {
+                        char const *data = nullptr;
+                        auto const size = reader.ReadBytes(data);
+                        Reader body{data, data + size};
+                        Binary::Detail::Read(body, column);
+                        if (!body.IsEnd())
+                            throw std::invalid_argument{"[Mif::Serialization::Batch::DeserializeBinary] Unexpected data after the column."};
+                    }
+                };
+
+                // Reads the columns in the order of the fields of the batch header.
+                template <typename T, typename TFormat>
+                class ColumnsReader final
+                {
+                public:
+                    using Columns = typename Reflection::SoAVector<T>::Columns;
+                    using Reader = typename TFormat::Reader;
+
+                    ColumnsReader(std::size_t inputSize)
+                        : m_inputSize{inputSize}
+                    {
+                    }
+
+                    void AddField(char const *name, std::size_t size)
+                    {
+                        m_fields.push_back(ColumnNames<T>::Get().Find(name, size, m_fields.size()));
+                    }
+
+                    std::size_t GetFieldsCount() const
+                    {
+                        return m_fields.size();
+                    }
+
+                    // Returns false if the column is unknown and has to be skipped by the caller.
+                    bool ReadColumn(Reader &reader, std::size_t index)
+                    {
+                        if (index >= m_fields.size())
+                            throw std::invalid_argument{"[Mif::Serialization::Batch] The batch has more columns than fields."};
+                        auto const column = m_fields[index];
+                        if (column == NoColumn)
+                            return false;
+                        Dispatch(reader, column, static_cast<Common::MakeIndexSequence<Count> const *>(nullptr));
+                        return true;
+                    }
+
+                    std::vector<T> GetItems(std::uint64_t count)
+                    {
+                        CheckSizes(count, static_cast<Common::MakeIndexSequence<Count> const *>(nullptr));
+                        // The structures without fields have no columns to take the count from.
+                        if (!Count)
+                        {
+                            if (count > std::numeric_limits<std::size_t>::max())
+                                throw std::invalid_argument{"[Mif::Serialization::Batch] The items count is too large."};
+                            return std::vector<T>(static_cast<std::size_t>(count));
+                        }
+                        return Reflection::SoAVector<T>{std::move(m_columns)}.ToVector();
+                    }
+
+                private:
+                    static constexpr std::size_t Count = Reflection::SoAVector<T>::FieldsCount;
+
+                    std::size_t m_inputSize;
+                    std::vector<std::size_t> m_fields;
+                    Columns m_columns;
+                    std::array<bool, Count> m_read{};
+
+                    template <std::size_t I>
+                    static void Read(Reader &reader, Columns &columns, bool *read)
+                    {
+                        auto &column = std::get<I>(columns);
+                        column.clear();
+                        TFormat::ReadColumn(reader, column);
+                        read[I] = true;
+                    }
+
+                    template <std::size_t ... Indexes>
+                    void Dispatch(Reader &reader, std::size_t index, Common::IndexSequence<Indexes ... > const *)
+                    {
+                        using Invoker = void (*)(Reader &, Columns &, bool *);
+                        static Invoker const invokers[] = {&Read<Indexes> ... };
+                        invokers[index](reader, m_columns, m_read.data());
+                    }
+
+                    // The missing column can't have more items than the input has bytes, so the bad
+                    // data can't make it large.
+                    template <std::size_t I>
+                    bool Resize(std::uint64_t count)
+                    {
+                        if (m_read[I])
+                            return true;
+                        if (count > m_inputSize)
+                            throw std::invalid_argument{"[Mif::Serialization::Batch] The items count exceeds the size of the batch."};
+                        std::get<I>(m_columns).resize(static_cast<std::size_t>(count));
+                        return true;
+                    }
+
+                    // The read columns have to have count items, the missing ones are filled with the
+                    // default values. The first item of the sizes is for the structures without fields.
+                    template <std::size_t ... Indexes>
+                    void CheckSizes(std::uint64_t count, Common::IndexSequence<Indexes ... > const *)
+                    {
+                        std::size_t const sizes[] = {NoColumn, (m_read[Indexes] ? std::get<Indexes>(m_columns).size() : NoColumn) ... };
+                        for (auto const size : sizes)
+                        {
+                            if (size != NoColumn && size != count)
+                                throw std::invalid_argument{"[Mif::Serialization::Batch] The column size differs from the items count."};
+                        }
+
+                        Common::Unused(Resize<Indexes>(count) ... );
+                    }
+                };
+
+                template <typename T>
+                inline std::string const& GetFieldName(std::size_t index)
+                {
+                    return ColumnNames<T>::Get().GetName(index);
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I == N, void>::type
+                WriteJsonColumns(Json::Detail::StreamWriter &writer, T const &columns)
+                {
+                    Common::Unused(writer, columns);
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I != N, void>::type
+                WriteJsonColumns(Json::Detail::StreamWriter &writer, T const &columns)
+                {
+                    if (I)
+                        writer.WriteChar(',');
+                    Json::Detail::WriteValue(writer, std::get<I>(columns));
+                    WriteJsonColumns<I + 1, N>(writer, columns);
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I == N, void>::type
+                WriteMsgPackColumns(MsgPack::Detail::Writer &writer, T const &columns)
+                {
+                    Common::Unused(writer, columns);
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I != N, void>::type
+                WriteMsgPackColumns(MsgPack::Detail::Writer &writer, T const &columns)
+                {
+                    MsgPack::Detail::Write(writer, std::get<I>(columns));
+                    WriteMsgPackColumns<I + 1, N>(writer, columns);
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I == N, void>::type
+                WriteBinaryColumns(Binary::Detail::Writer &writer, T const &columns)
+                {
+                    Common::Unused(writer, columns);
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I != N, void>::type
+                WriteBinaryColumns(Binary::Detail::Writer &writer, T const &columns)
+                {
+                    auto const size = writer.BeginSize();
+                    Binary::Detail::Write(writer, std::get<I>(columns));
+                    writer.EndSize(size);
+                    WriteBinaryColumns<I + 1, N>(writer, columns);
+                }
+
+            }   // namespace Detail
+
+            template <typename T>
+            inline void WriteJson(std::vector<T> const &items, Common::Buffer &buffer)
+            {
+                using Rows = Reflection::SoAVector<T>;
+                Rows const rows{items};
+
+                Json::Detail::StreamWriter writer{buffer};
+                writer.WriteChar('{');
+                writer.WriteRaw(Json::Detail::StreamKey<Detail::Tag::Count>::Get());
+                Json::Detail::WriteValue(writer, static_cast<std::uint64_t>(items.size()));
+                writer.WriteChar(',');
+                writer.WriteRaw(Json::Detail::StreamKey<Detail::Tag::Fields>::Get());
+                writer.WriteChar('[');
+                for (std::size_t i = 0 ; i < Rows::FieldsCount ; ++i)
+                {
+                    if (i)
+                        writer.WriteChar(',');
+                    writer.WriteString(Detail::GetFieldName<T>(i));
+                }
+                writer.WriteChar(']');
+                writer.WriteChar(',');
+                writer.WriteRaw(Json::Detail::StreamKey<Detail::Tag::Columns>::Get());
+                writer.WriteChar('[');
+                Detail::WriteJsonColumns<0, Rows::FieldsCount>(writer, rows.GetColumns());
+                writer.WriteChar(']');
+                writer.WriteChar('}');
+            }
+
+            template <typename T>
+            inline Common::Buffer WriteJson(std::vector<T> const &items)
+            {
+                Common::Buffer buffer;
+                WriteJson(items, buffer);
+                return buffer;
+            }
+
+            template <typename T>
+            inline std::vector<T> ReadJson(char const *data, std::size_t size)
+            {
+                Json::Detail::StreamReader reader{data, data + size};
+                Detail::ColumnsReader<T, Detail::JsonFormat> columns{size};
+                std::uint64_t count = 0;
+                bool hasFields = false;
+
+                reader.Expect('{');
+                if (!reader.TryTake('}'))
+                {
+                    do
+                    {
+                        char const *key = nullptr;
+                        std::size_t keySize = 0;
+                        reader.ReadString(key, keySize);
+                        reader.Expect(':');
+
+                        if (Json::Detail::IsKey(Detail::Tag::Count::Value, key, keySize))
+                        {
+                            Json::Detail::ReadValue(reader, count);
+                        }
+                        else if (Json::Detail::IsKey(Detail::Tag::Fields::Value, key, keySize))
+                        {
+                            reader.Expect('[');
+                            if (!reader.TryTake(']'))
+                            {
+                                do
+                                {
+                                    char const *name = nullptr;
+                                    std::size_t nameSize = 0;
+                                    reader.ReadString(name, nameSize);
+                                    columns.AddField(name, nameSize);
+                                }
+                                while (reader.TryTake(','));
+                                reader.Expect(']');
+                            }
+                            hasFields = true;
+                        }
+                        else if (Json::Detail::IsKey(Detail::Tag::Columns::Value, key, keySize))
+                        {
+                            if (!hasFields)
+                                reader.Fail("The columns have to go after the fields.");
+                            reader.Expect('[');
+                            if (!reader.TryTake(']'))
+                            {
+                                std::size_t index = 0;
+                                do
+                                {
+                                    if (!columns.ReadColumn(reader, index++))
+                                        reader.SkipValue();
+                                }
+                                while (reader.TryTake(','));
+                                reader.Expect(']');
+                            }
+                        }
+                        else
+                        {
+                            reader.SkipValue();
+                        }
+                    }
+                    while (reader.TryTake(','));
+                    reader.Expect('}');
+                }
+
+                if (!reader.IsEnd())
+                    reader.Fail("Unexpected data after the value.");
+
+                return columns.GetItems(count);
+            }
+
+            template <typename T>
+            inline std::vector<T> ReadJson(Common::Buffer const &buffer)
+            {
+                return ReadJson<T>(buffer.data(), buffer.size());
+            }
+
+            template <typename T>
+            inline void SerializeMsgPack(std::vector<T> const &items, Common::Buffer &buffer)
+            {
+                using Rows = Reflection::SoAVector<T>;
+                Rows const rows{items};
+
+                MsgPack::Detail::Writer writer{buffer};
+                writer.WriteMapHeader(3);
+                writer.WriteString(Detail::Tag::Count::Value, std::strlen(Detail::Tag::Count::Value));
+                writer.WriteUInt(items.size());
+                writer.WriteString(Detail::Tag::Fields::Value, std::strlen(Detail::Tag::Fields::Value));
+                writer.WriteArrayHeader(Rows::FieldsCount);
+                for (std::size_t i = 0 ; i < Rows::FieldsCount ; ++i)
+                {
+                    auto const &name = Detail::GetFieldName<T>(i);
+                    writer.WriteString(name.data(), name.size());
+                }
+                writer.WriteString(Detail::Tag::Columns::Value, std::strlen(Detail::Tag::Columns::Value));
+                writer.WriteArrayHeader(Rows::FieldsCount);
+                Detail::WriteMsgPackColumns<0, Rows::FieldsCount>(writer, rows.GetColumns());
+            }
+
+            template <typename T>
+            inline Common::Buffer SerializeMsgPack(std::vector<T> const &items)
+            {
+                Common::Buffer buffer;
+                SerializeMsgPack(items, buffer);
+                return buffer;
+            }
+
+            template <typename T>
+            inline std::vector<T> DeserializeMsgPack(char const *data, std::size_t size)
+            {
+                MsgPack::Detail::Reader reader{data, data + size};
+                Detail::ColumnsReader<T, Detail::MsgPackFormat> columns{size};
+                std::uint64_t count = 0;
+                bool hasFields = false;
+
+                for (auto keys = reader.ReadMapHeader() ; keys ; --keys)
+                {
+                    char const *key = nullptr;
+                    auto const keySize = reader.ReadString(key);
+
+                    if (MsgPack::Detail::IsKey(Detail::Tag::Count::Value, key, keySize))
+                    {
+                        MsgPack::Detail::Read(reader, count);
+                    }
+                    else if (MsgPack::Detail::IsKey(Detail::Tag::Fields::Value, key, keySize))
+                    {
+                        for (auto fields = reader.ReadArrayHeader() ; fields ; --fields)
+                        {
+                            char const *name = nullptr;
+                            auto const nameSize = reader.ReadString(name);
+                            columns.AddField(name, nameSize);
+                        }
+                        hasFields = true;
+                    }
+                    else if (MsgPack::Detail::IsKey(Detail::Tag::Columns::Value, key, keySize))
+                    {
+                        if (!hasFields)
+                            throw std::invalid_argument{"[Mif::Serialization::Batch::DeserializeMsgPack] The columns have to go after the fields."};
+                        auto const number = reader.ReadArrayHeader();
+                        for (std::size_t i = 0 ; i < number ; ++i)
+                        {
+                            if (!columns.ReadColumn(reader, i))
+                                reader.Skip();
+                        }
+                    }
+                    else
+                    {
+                        reader.Skip();
+                    }
+                }
+
+                if (!reader.IsEnd())
+                    throw std::invalid_argument{"[Mif::Serialization::Batch::DeserializeMsgPack] Unexpected data after the batch."};
+
+                return columns.GetItems(count);
+            }
+
+            template <typename T>
+            inline std::vector<T> DeserializeMsgPack(Common::Buffer const &buffer)
+            {
+                return DeserializeMsgPack<T>(buffer.data(), buffer.size());
+            }
+
+            template <typename T>
+            inline void SerializeBinary(std::vector<T> const &items, Common::Buffer &buffer)
+            {
+                using Rows = Reflection::SoAVector<T>;
+                Rows const rows{items};
+
+                auto const write = [&items, &rows] (Binary::Detail::Writer &writer)
+                    {
+                        writer.WriteVarint(items.size());
+                        writer.WriteVarint(Rows::FieldsCount);
+                        for (std::size_t i = 0 ; i < Rows::FieldsCount ; ++i)
+                        {
+                            auto const &name = Detail::GetFieldName<T>(i);
+                            writer.WriteBytes(name.data(), name.size());
+                        }
+                        Detail::WriteBinaryColumns<0, Rows::FieldsCount>(writer, rows.GetColumns());
+                    };
+
+                // The columns are prefixed by their sizes, so they are counted before writing.
+                Binary::Detail::WriteData(buffer, Binary::Layout::Compact, write, true);
+            }
+
+            template <typename T>
+            inline Common::Buffer SerializeBinary(std::vector<T> const &items)
+            {
+                Common::Buffer buffer;
+                SerializeBinary(items, buffer);
+                return buffer;
+            }
+
+            template <typename T>
+            inline std::vector<T> DeserializeBinary(char const *data, std::size_t size)
+            {
+                Binary::Detail::Reader reader{data, data + size};
+                Detail::ColumnsReader<T, Detail::BinaryFormat> columns{size};
+
+                auto const count = reader.ReadVarint();
+                for (auto fields = reader.ReadSize() ; fields ; --fields)
+                {
+                    char const *name = nullptr;
+                    auto const nameSize = reader.ReadBytes(name);
+                    columns.AddField(name, nameSize);
+                }
+
+                for (std::size_t i = 0 ; i < columns.GetFieldsCount() ; ++i)
+                {
+                    if (!columns.ReadColumn(reader, i))
+                    {
+                        char const *column = nullptr;
+                        reader.ReadBytes(column);
+                    }
+                }
+
+                if (!reader.IsEnd())
+                    throw std::invalid_argument{"[Mif::Serialization::Batch::DeserializeBinary] Unexpected data after the batch."};
+
+                return columns.GetItems(count);
+            }
+
+            template <typename T>
+            inline std::vector<T> DeserializeBinary(Common::Buffer const &buffer)
+            {
+                return DeserializeBinary<T>(buffer.data(), buffer.size());
+            }
+
+        }   // namespace Batch
+    }   // namespace Serialization
+}   // namespace Mif
+
+#endif  // !__MIF_SERIALIZATION_BATCH_H__
@@ -0,0 +1,1136 @@
+//-------------------------------------------------------------------
+//  MetaInfo Framework (MIF)
+//  https://github.com/tdv/mif
+//  Created:     10.2026
+//  Copyright (C) 2016-2024 tdv
+//-------------------------------------------------------------------
+
+#ifndef __MIF_SERIALIZATION_BINARY_H__
+#define __MIF_SERIALIZATION_BINARY_H__
+
+// STD
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// MIF
+#include "mif/common/crc32.h"
+#include "mif/common/types.h"
+#include "mif/common/unused.h"
+#include "mif/reflection/reflection.h"
+#include "mif/serialization/estimate_size.h"
+#include "mif/serialization/traits.h"
+
+// Compact binary format made from the reflection metadata. There are no names and
+// no type information in the data, so the reader must know the type of the data.
+//  - integers are varints (the signed ones are zigzag-encoded), bool and 1-byte
+//    integers are single bytes;
+//  - floating point values are little-endian IEEE 754;
+//  - strings and containers are prefixed by the varint size;
+//  - optional values and smart pointers are prefixed by a presence byte;
+//  - enums are written as their underlying values;
+//  - structures are the sequences of the fields of their bases and their own fields.
+// The tagged layout is tolerant to the changes of the structures. Each structure is
+// prefixed by its size, and each field (or base) by the CRC32 of its name (the bases are
+// named without namespaces) and its size. The structures and the bases are written once
+// with their own size prefix, which is the size of the field as well. All sizes are counted
+// by the first pass, so the data is never moved to put the size before it.
+// The reader skips the unknown fields and leaves the missing ones with their defaults.
+
+namespace Mif
+{
+    namespace Serialization
+    {
+        namespace Binary
+        {
+
+            enum class Layout
+            {
+                Compact,
+                Tagged
+            };
+
+            namespace Detail
+            {
+
+                // The sizes of the parts of the data which are put before them (the structures and
+                // the fields in the tagged layout, the columns of the batch). They are counted by
+                // the first pass, so the data is written once and never moved.
+                using Sizes = std::vector<std::uint64_t>;
+
+                class Writer final
+                {
+                public:
+                    Writer(Common::Buffer &buffer, Layout layout = Layout::Compact, Sizes const *sizes = nullptr)
+                        : m_buffer{&buffer}
+                        , m_layout{layout}
+                        , m_sizes{sizes}
+                    {
+                    }
+
+                    // Counts the sizes only, nothing is written.
+                    Writer(Sizes &sizes, Layout layout = Layout::Compact)
+                        : m_layout{layout}
+                        , m_counted{&sizes}
+                    {
+                    }
+
+                    Layout GetLayout() const
+                    {
+                        return m_layout;
+                    }
+
+                    void WriteByte(std::uint8_t value)
+                    {
+                        if (!m_buffer)
+                        {
+                            ++m_size;
+                            return;
+                        }
+                        m_buffer->push_back(static_cast<char>(value));
+                    }
+
+                    void WriteVarint(std::uint64_t value)
+                    {
+                        if (!m_buffer)
+                        {
+                            m_size += Estimate::GetVarintSize(value);
+                            return;
+                        }
+                        char data[10];
+                        std::size_t size = 0;
+                        while (value >= 0x80)
+                        {
+                            data[size++] = static_cast<char>((value & 0x7F) | 0x80);
+                            value >>= 7;
+                        }
+                        data[size++] = static_cast<char>(value);
+                        m_buffer->insert(std::end(*m_buffer), data, data + size);
+                    }
+
+                    void WriteFixed(std::uint64_t value, std::size_t size)
+                    {
+                        if (!m_buffer)
+                        {
+                            m_size += size;
+                            return;
+                        }
+                        char data[sizeof(value)];
+                        for (std::size_t i = 0 ; i < size ; ++i)
+                            data[i] = static_cast<char>((value >> (i * 8)) & 0xFF);
+                        m_buffer->insert(std::end(*m_buffer), data, data + size);
+                    }
+
+                    void WriteBytes(char const *data, std::size_t size)
+                    {
+                        WriteVarint(size);
+                        if (!m_buffer)
+                        {
+                            m_size += size;
+                            return;
+                        }
+                        m_buffer->insert(std::end(*m_buffer), data, data + size);
+                    }
+
+                    template <typename TIterator>
+                    void WriteRange(TIterator begin, TIterator end)
+                    {
+                        if (!m_buffer)
+                        {
+                            m_size += static_cast<std::size_t>(std::distance(begin, end));
+                            return;
+                        }
+                        m_buffer->insert(std::end(*m_buffer), begin, end);
+                    }
+
+                    // The size of the data written between BeginSize and EndSize is put before the data.
+                    // The counting writer remembers it, the other one writes the counted size.
+                    std::size_t BeginSize()
+                    {
+                        if (m_counted)
+                        {
+                            m_counted->push_back(m_size);
+                            return m_counted->size() - 1;
+                        }
+
+                        if (!m_sizes || m_nextSize >= m_sizes->size())
+                            throw std::logic_error{"[Mif::Serialization::Binary::Detail::Writer::BeginSize] The sizes are not counted."};
+
+                        WriteVarint((*m_sizes)[m_nextSize]);
+                        return m_nextSize++;
+                    }
+
+                    void EndSize(std::size_t index)
+                    {
+                        if (!m_counted)
+                            return;
+
+                        auto &size = (*m_counted)[index];
+                        size = m_size - size;
+                        m_size += Estimate::GetVarintSize(size);
+                    }
+
+                private:
+                    Common::Buffer *m_buffer = nullptr;
+                    Layout m_layout;
+                    Sizes const *m_sizes = nullptr;
+                    std::size_t m_nextSize = 0;
+                    Sizes *m_counted = nullptr;
+                    std::size_t m_size = 0;
+                };
+
+                // Writes the data by the function called with the writer. The tagged layout and the
+                // data with the sizes (see BeginSize) are counted by the first pass.
+                template <typename TFunction>
+                inline void WriteData(Common::Buffer &buffer, Layout layout, TFunction const &function, bool withSizes = false)
+                {
+                    if (!withSizes && layout == Layout::Compact)
+                    {
+                        Writer writer{buffer, layout};
+                        function(writer);
+                        return;
+                    }
+
+                    Sizes sizes;
+
+                    {
+                        Writer counter{sizes, layout};
+                        function(counter);
+                    }
+
+                    Writer writer{buffer, layout, &sizes};
+                    function(writer);
+                }
+
+                class Reader final
+                {
+                public:
+                    Reader(char const *begin, char const *end, Layout layout = Layout::Compact)
+                        : m_pos{begin}
+                        , m_end{end}
+                        , m_layout{layout}
+                    {
+                    }
+
+                    Layout GetLayout() const
+                    {
+                        return m_layout;
+                    }
+
+                    std::uint8_t ReadByte()
+                    {
+                        Check(1);
+                        return static_cast<std::uint8_t>(*m_pos++);
+                    }
+
+                    std::uint64_t ReadVarint()
+                    {
+                        std::uint64_t value = 0;
+                        for (unsigned shift = 0 ; shift < 64 ; shift += 7)
+                        {
+                            auto const byte = ReadByte();
+                            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                            if (!(byte & 0x80))
+                                return value;
+                        }
+                        throw std::invalid_argument{"[Mif::Serialization::Binary::Detail::Reader::ReadVarint] Bad varint."};
+                    }
+
+                    std::uint64_t ReadFixed(std::size_t size)
+                    {
+                        Check(size);
+                        std::uint64_t value = 0;
+                        for (std::size_t i = 0 ; i < size ; ++i)
+                            value |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(m_pos[i])) << (i * 8);
+                        m_pos += size;
+                        return value;
+                    }
+
+                    // Returns the size of the data and moves the position to its end.
+                    std::size_t ReadBytes(char const *&data)
+                    {
+                        auto const size = ReadSize();
+                        Check(size);
+                        data = m_pos;
+                        m_pos += size;
+                        return size;
+                    }
+
+                    // The size of the data is checked against the rest of the buffer, so
+                    // the bad data can't make the reader allocate a lot of memory.
+                    std::size_t ReadSize()
+                    {
+                        auto const size = ReadVarint();
+                        if (size > static_cast<std::uint64_t>(m_end - m_pos))
+                            throw std::invalid_argument{"[Mif::Serialization::Binary::Detail::Reader::ReadSize] Bad size."};
+                        return static_cast<std::size_t>(size);
+                    }
+
+                    char const* GetPosition() const
+                    {
+                        return m_pos;
+                    }
+
+                    bool IsEnd() const
+                    {
+                        return m_pos == m_end;
+                    }
+
+                private:
+                    char const *m_pos;
+                    char const *m_end;
+                    Layout m_layout;
+
+                    void Check(std::size_t size) const
+                    {
+                        if (static_cast<std::size_t>(m_end - m_pos) < size)
+                            throw std::invalid_argument{"[Mif::Serialization::Binary::Detail::Reader] Unexpected end of data."};
+                    }
+                };
+
+                template <typename T>
+                struct MutableValue
+                {
+                    using Type = T;
+                };
+
+                template <typename TFirst, typename TSecond>
+                struct MutableValue<std::pair<TFirst, TSecond>>
+                {
+                    using Type = std::pair<typename std::remove_const<TFirst>::type, TSecond>;
+                };
+
+                template <typename T>
+                inline auto Reserve(T &object, std::size_t size, int)
+                    -> decltype(object.reserve(size), void())
+                {
+                    object.reserve(size);
+                }
+
+                template <typename T>
+                inline void Reserve(T &, std::size_t, ...)
+                {
+                }
+
+                //--------------------------------------------------------------------------------------------------------------------------
+
+                template <typename T>
+                typename std::enable_if<std::is_same<T, bool>::value, void>::type
+                Write(Writer &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value && sizeof(T) == 1, void>::type
+                Write(Writer &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value && (sizeof(T) > 1), void>::type
+                Write(Writer &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value && (sizeof(T) > 1), void>::type
+                Write(Writer &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if<std::is_floating_point<T>::value, void>::type
+                Write(Writer &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if<std::is_enum<T>::value, void>::type
+                Write(Writer &writer, T const &object);
+
+                inline void Write(Writer &writer, std::string const &object);
+
+                template <typename T>
+                typename std::enable_if<Reflection::IsReflectable<T>() && !std::is_enum<T>::value, void>::type
+                Write(Writer &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if<Traits::IsSmartPointer<T>(), void>::type
+                Write(Writer &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if<Traits::IsOptional<T>(), void>::type
+                Write(Writer &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() &&
+                            !std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                        void
+                    >::type
+                Write(Writer &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() &&
+                            std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                        void
+                    >::type
+                Write(Writer &writer, T const &object);
+
+                template <typename T, std::size_t N>
+                void Write(Writer &writer, std::array<T, N> const &object);
+
+                template <typename TFirst, typename TSecond>
+                void Write(Writer &writer, std::pair<TFirst, TSecond> const &object);
+
+                template <typename ... T>
+                void Write(Writer &writer, std::tuple<T ... > const &object);
+
+                template <typename TBases, std::size_t I, typename T>
+                typename std::enable_if<I != std::tuple_size<TBases>::value, void>::type
+                WriteBase(Writer &writer, T const &object);
+
+                template <typename TBases, std::size_t I, typename T>
+                typename std::enable_if<I == std::tuple_size<TBases>::value, void>::type
+                WriteBase(Writer &writer, T const &object);
+
+                template <std::size_t I, std::size_t N, typename T>
+                typename std::enable_if<I != N, void>::type
+                WriteFields(Writer &writer, T const &object);
+
+                template <std::size_t I, std::size_t N, typename T>
+                typename std::enable_if<I == N, void>::type
+                WriteFields(Writer &writer, T const &object);
+
+                template <typename TBases, std::size_t I, typename T>
+                typename std::enable_if<I != std::tuple_size<TBases>::value, void>::type
+                WriteTaggedBase(Writer &writer, T const &object);
+
+                template <typename TBases, std::size_t I, typename T>
+                typename std::enable_if<I == std::tuple_size<TBases>::value, void>::type
+                WriteTaggedBase(Writer &writer, T const &object);
+
+                template <std::size_t I, std::size_t N, typename T>
+                typename std::enable_if<I != N, void>::type
+                WriteTaggedFields(Writer &writer, T const &object);
+
+                template <std::size_t I, std::size_t N, typename T>
+                typename std::enable_if<I == N, void>::type
+                WriteTaggedFields(Writer &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if<Reflection::IsReflectable<T>() && !std::is_enum<T>::value, void>::type
+                WriteTaggedValue(Writer &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if<!Reflection::IsReflectable<T>() || std::is_enum<T>::value, void>::type
+                WriteTaggedValue(Writer &writer, T const &object);
+
+                template <std::size_t I, std::size_t N, typename T>
+                typename std::enable_if<I != N, void>::type
+                WriteItems(Writer &writer, T const &object);
+
+                template <std::size_t I, std::size_t N, typename T>
+                typename std::enable_if<I == N, void>::type
+                WriteItems(Writer &writer, T const &object);
+
+                //--------------------------------------------------------------------------------------------------------------------------
+
+                template <typename T>
+                typename std::enable_if<std::is_same<T, bool>::value, void>::type
+                Read(Reader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value && sizeof(T) == 1, void>::type
+                Read(Reader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value && (sizeof(T) > 1), void>::type
+                Read(Reader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value && (sizeof(T) > 1), void>::type
+                Read(Reader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if<std::is_floating_point<T>::value, void>::type
+                Read(Reader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if<std::is_enum<T>::value, void>::type
+                Read(Reader &reader, T &object);
+
+                inline void Read(Reader &reader, std::string &object);
+
+                template <typename T>
+                typename std::enable_if<Reflection::IsReflectable<T>() && !std::is_enum<T>::value, void>::type
+                Read(Reader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if<Traits::IsSmartPointer<T>(), void>::type
+                Read(Reader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if<Traits::IsOptional<T>(), void>::type
+                Read(Reader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() &&
+                            !std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                        void
+                    >::type
+                Read(Reader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() &&
+                            std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                        void
+                    >::type
+                Read(Reader &reader, T &object);
+
+                template <typename T, std::size_t N>
+                void Read(Reader &reader, std::array<T, N> &object);
+
+                template <typename TFirst, typename TSecond>
+                void Read(Reader &reader, std::pair<TFirst, TSecond> &object);
+
+                template <typename ... T>
+                void Read(Reader &reader, std::tuple<T ... > &object);
+
+                template <typename TBases, std::size_t I, typename T>
+                typename std::enable_if<I != std::tuple_size<TBases>::value, void>::type
+                ReadBase(Reader &reader, T &object);
+
+                template <typename TBases, std::size_t I, typename T>
+                typename std::enable_if<I == std::tuple_size<TBases>::value, void>::type
+                ReadBase(Reader &reader, T &object);
+
+                template <std::size_t I, std::size_t N, typename T>
+                typename std::enable_if<I != N, void>::type
+                ReadFields(Reader &reader, T &object);
+
+                template <std::size_t I, std::size_t N, typename T>
+                typename std::enable_if<I == N, void>::type
+                ReadFields(Reader &reader, T &object);
+
+                template <typename TBases, std::size_t I, typename T>
+                typename std::enable_if<I != std::tuple_size<TBases>::value, bool>::type
+                ReadTaggedBase(Reader &reader, T &object, std::uint32_t tag);
+
+                template <typename TBases, std::size_t I, typename T>
+                typename std::enable_if<I == std::tuple_size<TBases>::value, bool>::type
+                ReadTaggedBase(Reader &reader, T &object, std::uint32_t tag);
+
+                template <std::size_t I, std::size_t N, typename T>
+                typename std::enable_if<I != N, bool>::type
+                ReadTaggedFields(Reader &reader, T &object, std::uint32_t tag);
+
+                template <std::size_t I, std::size_t N, typename T>
+                typename std::enable_if<I == N, bool>::type
+                ReadTaggedFields(Reader &reader, T &object, std::uint32_t tag);
+
+                template <typename T>
+                void ReadTaggedBody(Reader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if<Reflection::IsReflectable<T>() && !std::is_enum<T>::value, void>::type
+                ReadTaggedValue(Reader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if<!Reflection::IsReflectable<T>() || std::is_enum<T>::value, void>::type
+                ReadTaggedValue(Reader &reader, T &object);
+
+                template <std::size_t I, std::size_t N, typename T>
+                typename std::enable_if<I != N, void>::type
+                ReadItems(Reader &reader, T &object);
+
+                template <std::size_t I, std::size_t N, typename T>
+                typename std::enable_if<I == N, void>::type
+                ReadItems(Reader &reader, T &object);
+
+                //--------------------------------------------------------------------------------------------------------------------------
+
+                template <typename T>
+                inline typename std::enable_if<std::is_pointer<T>::value, void>::type
+                Write(Writer &, T const &)
+                {
+                    static_assert(!std::is_pointer<T>::value, "[Mif::Serialization::Binary::Detail] You can't serialize the raw pointers.");
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_same<T, bool>::value, void>::type
+                Write(Writer &writer, T const &object)
+                {
+                    writer.WriteByte(object ? 1 : 0);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value && sizeof(T) == 1, void>::type
+                Write(Writer &writer, T const &object)
+                {
+                    writer.WriteByte(static_cast<std::uint8_t>(object));
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value && (sizeof(T) > 1), void>::type
+                Write(Writer &writer, T const &object)
+                {
+                    writer.WriteVarint(object);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value && (sizeof(T) > 1), void>::type
+                Write(Writer &writer, T const &object)
+                {
+                    auto const value = static_cast<std::int64_t>(object);
+                    writer.WriteVarint((static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63));
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_floating_point<T>::value, void>::type
+                Write(Writer &writer, T const &object)
+                {
+                    using Bits = typename std::conditional<sizeof(T) == sizeof(std::uint32_t), std::uint32_t, std::uint64_t>::type;
+                    static_assert(sizeof(T) == sizeof(Bits), "[Mif::Serialization::Binary::Detail] Unsupported floating point type.");
+                    Bits bits = 0;
+                    std::memcpy(&bits, &object, sizeof(bits));
+                    writer.WriteFixed(bits, sizeof(bits));
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_enum<T>::value, void>::type
+                Write(Writer &writer, T const &object)
+                {
+                    Write(writer, static_cast<typename std::underlying_type<T>::type>(object));
+                }
+
+                inline void Write(Writer &writer, std::string const &object)
+                {
+                    writer.WriteBytes(object.data(), object.size());
+                }
+
+                template <typename T>
+                inline typename std::enable_if<Reflection::IsReflectable<T>() && !std::is_enum<T>::value, void>::type
+                Write(Writer &writer, T const &object)
+                {
+                    using Meta = Reflection::Reflect<T>;
+
+                    if (writer.GetLayout() == Layout::Tagged)
+                    {
+                        auto const size = writer.BeginSize();
+                        WriteTaggedBase<typename Meta::Base, 0>(writer, object);
+                        WriteTaggedFields<0, Meta::Fields::Count>(writer, object);
+                        writer.EndSize(size);
+                        return;
+                    }
+
+                    WriteBase<typename Meta::Base, 0>(writer, object);
+                    WriteFields<0, Meta::Fields::Count>(writer, object);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<Traits::IsSmartPointer<T>(), void>::type
+                Write(Writer &writer, T const &object)
+                {
+                    writer.WriteByte(object ? 1 : 0);
+                    if (object)
+                        Write(writer, *object);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<Traits::IsOptional<T>(), void>::type
+                Write(Writer &writer, T const &object)
+                {
+                    writer.WriteByte(object ? 1 : 0);
+                    if (object)
+                        Write(writer, *object);
+                }
+
+                template <typename T>
+                inline typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() &&
+                            !std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                        void
+                    >::type
+                Write(Writer &writer, T const &object)
+                {
+                    writer.WriteVarint(static_cast<std::uint64_t>(std::distance(std::begin(object), std::end(object))));
+                    for (auto const &i : object)
+                        Write(writer, i);
+                }
+
+                template <typename T>
+                inline typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() &&
+                            std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                        void
+                    >::type
+                Write(Writer &writer, T const &object)
+                {
+                    writer.WriteVarint(static_cast<std::uint64_t>(std::distance(std::begin(object), std::end(object))));
+                    writer.WriteRange(std::begin(object), std::end(object));
+                }
+
+                template <typename T, std::size_t N>
+                inline void Write(Writer &writer, std::array<T, N> const &object)
+                {
+                    WriteItems<0, N>(writer, object);
+                }
+
+                template <typename TFirst, typename TSecond>
+                inline void Write(Writer &writer, std::pair<TFirst, TSecond> const &object)
+                {
+                    Write(writer, object.first);
+                    Write(writer, object.second);
+                }
+
+                template <typename ... T>
+                inline void Write(Writer &writer, std::tuple<T ... > const &object)
+                {
+                    WriteItems<0, sizeof ... (T)>(writer, object);
+                }
+
+                template <typename TBases, std::size_t I, typename T>
+                inline typename std::enable_if<I != std::tuple_size<TBases>::value, void>::type
+                WriteBase(Writer &writer, T const &object)
+                {
+                    using Base = typename std::tuple_element<I, TBases>::type;
+                    Write(writer, static_cast<Base const &>(object));
+                    WriteBase<TBases, I + 1>(writer, object);
+                }
+
+                template <typename TBases, std::size_t I, typename T>
+                inline typename std::enable_if<I == std::tuple_size<TBases>::value, void>::type
+                WriteBase(Writer &writer, T const &object)
+                {
+                    Common::Unused(writer, object);
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I != N, void>::type
+                WriteFields(Writer &writer, T const &object)
+                {
+                    using Field = typename Reflection::Reflect<T>::Fields::template Field<I>;
+                    Write(writer, object.*Field::Access());
+                    WriteFields<I + 1, N>(writer, object);
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I == N, void>::type
+                WriteFields(Writer &writer, T const &object)
+                {
+                    Common::Unused(writer, object);
+                }
+
+                template <typename TBases, std::size_t I, typename T>
+                inline typename std::enable_if<I != std::tuple_size<TBases>::value, void>::type
+                WriteTaggedBase(Writer &writer, T const &object)
+                {
+                    using Base = typename std::tuple_element<I, TBases>::type;
+                    using Tag = std::integral_constant<std::uint32_t, Common::Crc32(Reflection::Reflect<Base>::Name::Value)>;
+                    writer.WriteFixed(Tag::value, sizeof(std::uint32_t));
+                    // The size of the base is the one of the structure.
+                    Write(writer, static_cast<Base const &>(object));
+                    WriteTaggedBase<TBases, I + 1>(writer, object);
+                }
+
+                template <typename TBases, std::size_t I, typename T>
+                inline typename std::enable_if<I == std::tuple_size<TBases>::value, void>::type
+                WriteTaggedBase(Writer &writer, T const &object)
+                {
+                    Common::Unused(writer, object);
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I != N, void>::type
+                WriteTaggedFields(Writer &writer, T const &object)
+                {
+                    using Field = typename Reflection::Reflect<T>::Fields::template Field<I>;
+                    using Tag = std::integral_constant<std::uint32_t, Common::Crc32(Field::Name::Value)>;
+                    writer.WriteFixed(Tag::value, sizeof(std::uint32_t));
+                    WriteTaggedValue(writer, object.*Field::Access());
+                    WriteTaggedFields<I + 1, N>(writer, object);
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I == N, void>::type
+                WriteTaggedFields(Writer &writer, T const &object)
+                {
+                    Common::Unused(writer, object);
+                }
+
+                // The structure is prefixed by its own size, the other values get the size of the field.
+                template <typename T>
+                inline typename std::enable_if<Reflection::IsReflectable<T>() && !std::is_enum<T>::value, void>::type
+                WriteTaggedValue(Writer &writer, T const &object)
+                {
+                    Write(writer, object);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<!Reflection::IsReflectable<T>() || std::is_enum<T>::value, void>::type
+                WriteTaggedValue(Writer &writer, T const &object)
+                {
+                    auto const size = writer.BeginSize();
+                    Write(writer, object);
+                    writer.EndSize(size);
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I != N, void>::type
+                WriteItems(Writer &writer, T const &object)
+                {
+                    Write(writer, std::get<I>(object));
+                    WriteItems<I + 1, N>(writer, object);
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I == N, void>::type
+                WriteItems(Writer &writer, T const &object)
+                {
+                    Common::Unused(writer, object);
+                }
+
+                //--------------------------------------------------------------------------------------------------------------------------
+
+                template <typename T>
+                inline typename std::enable_if<std::is_same<T, bool>::value, void>::type
+                Read(Reader &reader, T &object)
+                {
+                    auto const value = reader.ReadByte();
+                    if (value > 1)
+                        throw std::invalid_argument{"[Mif::Serialization::Binary::Detail::Read] Bad bool value."};
+                    object = value != 0;
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value && sizeof(T) == 1, void>::type
+                Read(Reader &reader, T &object)
+                {
+                    object = static_cast<T>(reader.ReadByte());
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value && (sizeof(T) > 1), void>::type
+                Read(Reader &reader, T &object)
+                {
+                    auto const value = reader.ReadVarint();
+                    if (value > static_cast<std::uint64_t>(std::numeric_limits<T>::max()))
+                        throw std::invalid_argument{"[Mif::Serialization::Binary::Detail::Read] Value is out of range."};
+                    object = static_cast<T>(value);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value && (sizeof(T) > 1), void>::type
+                Read(Reader &reader, T &object)
+                {
+                    auto const data = reader.ReadVarint();
+                    auto const value = static_cast<std::int64_t>(data >> 1) ^ -static_cast<std::int64_t>(data & 1);
+                    if (value < static_cast<std::int64_t>(std::numeric_limits<T>::min()) ||
+                            value > static_cast<std::int64_t>(std::numeric_limits<T>::max()))
+                    {
+                        throw std::invalid_argument{"[Mif::Serialization::Binary::Detail::Read] Value is out of range."};
+                    }
+                    object = static_cast<T>(value);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_floating_point<T>::value, void>::type
+                Read(Reader &reader, T &object)
+                {
+                    using Bits = typename std::conditional<sizeof(T) == sizeof(std::uint32_t), std::uint32_t, std::uint64_t>::type;
+                    static_assert(sizeof(T) == sizeof(Bits), "[Mif::Serialization::Binary::Detail] Unsupported floating point type.");
+                    auto const bits = static_cast<Bits>(reader.ReadFixed(sizeof(Bits)));
+                    std::memcpy(&object, &bits, sizeof(bits));
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_enum<T>::value, void>::type
+                Read(Reader &reader, T &object)
+                {
+                    typename std::underlying_type<T>::type value{};
+                    Read(reader, value);
+                    object = static_cast<T>(value);
+                }
+
+                inline void Read(Reader &reader, std::string &object)
+                {
+                    char const *data = nullptr;
+                    auto const size = reader.ReadBytes(data);
+                    object.assign(data, size);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<Reflection::IsReflectable<T>() && !std::is_enum<T>::value, void>::type
+                Read(Reader &reader, T &object)
+                {
+                    using Meta = Reflection::Reflect<T>;
+
+                    if (reader.GetLayout() == Layout::Tagged)
+                    {
+                        char const *data = nullptr;
+                        auto const size = reader.ReadBytes(data);
+                        Reader body{data, data + size, Layout::Tagged};
+                        ReadTaggedBody(body, object);
+                        return;
+                    }
+
+                    ReadBase<typename Meta::Base, 0>(reader, object);
+                    ReadFields<0, Meta::Fields::Count>(reader, object);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<Traits::IsSmartPointer<T>(), void>::type
+                Read(Reader &reader, T &object)
+                {
+                    if (!reader.ReadByte())
+                    {
+                        object.reset();
+                        return;
+                    }
+
+                    using Type = typename T::element_type;
+                    object.reset(new Type{});
+                    Read(reader, *object);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<Traits::IsOptional<T>(), void>::type
+                Read(Reader &reader, T &object)
+                {
+                    if (!reader.ReadByte())
+                    {
+                        object = T{};
+                        return;
+                    }
+
+                    typename T::value_type value{};
+                    Read(reader, value);
+                    object = std::move(value);
+                }
+
+                template <typename T>
+                inline typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() &&
+                            !std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                        void
+                    >::type
+                Read(Reader &reader, T &object)
+                {
+                    {
+                        T tmp;
+                        std::swap(tmp, object);
+                    }
+
+                    auto const count = reader.ReadSize();
+                    Reserve(object, count, 0);
+
+                    auto inserter = std::inserter(object, std::end(object));
+                    for (std::size_t i = 0 ; i < count ; ++i)
+                    {
+                        typename MutableValue<typename T::value_type>::Type data{};
+                        Read(reader, data);
+                        *inserter = std::move(data);
+                    }
+                }
+
+                template <typename T>
+                inline typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() &&
+                            std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                        void
+                    >::type
+                Read(Reader &reader, T &object)
+                {
+                    char const *data = nullptr;
+                    auto const size = reader.ReadBytes(data);
+                    object = T(data, data + size);
+                }
+
+                template <typename T, std::size_t N>
+                inline void Read(Reader &reader, std::array<T, N> &object)
+                {
+                    ReadItems<0, N>(reader, object);
+                }
+
+                template <typename TFirst, typename TSecond>
+                inline void Read(Reader &reader, std::pair<TFirst, TSecond> &object)
+                {
+                    Read(reader, const_cast<typename std::remove_const<TFirst>::type &>(object.first));
+                    Read(reader, object.second);
+                }
+
+                template <typename ... T>
+                inline void Read(Reader &reader, std::tuple<T ... > &object)
+                {
+                    ReadItems<0, sizeof ... (T)>(reader, object);
+                }
+
+                template <typename TBases, std::size_t I, typename T>
+                inline typename std::enable_if<I != std::tuple_size<TBases>::value, void>::type
+                ReadBase(Reader &reader, T &object)
+                {
+                    using Base = typename std::tuple_element<I, TBases>::type;
+                    Read(reader, static_cast<Base &>(object));
+                    ReadBase<TBases, I + 1>(reader, object);
+                }
+
+                template <typename TBases, std::size_t I, typename T>
+                inline typename std::enable_if<I == std::tuple_size<TBases>::value, void>::type
+                ReadBase(Reader &reader, T &object)
+                {
+                    Common::Unused(reader, object);
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I != N, void>::type
+                ReadFields(Reader &reader, T &object)
+                {
+                    using Field = typename Reflection::Reflect<T>::Fields::template Field<I>;
+                    Read(reader, object.*Field::Access());
+                    ReadFields<I + 1, N>(reader, object);
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I == N, void>::type
+                ReadFields(Reader &reader, T &object)
+                {
+                    Common::Unused(reader, object);
+                }
+
+                template <typename TBases, std::size_t I, typename T>
+                inline typename std::enable_if<I != std::tuple_size<TBases>::value, bool>::type
+                ReadTaggedBase(Reader &reader, T &object, std::uint32_t tag)
+                {
+                    using Base = typename std::tuple_element<I, TBases>::type;
+                    using Tag = std::integral_constant<std::uint32_t, Common::Crc32(Reflection::Reflect<Base>::Name::Value)>;
+                    if (tag != Tag::value)
+                        return ReadTaggedBase<TBases, I + 1>(reader, object, tag);
+                    ReadTaggedBody(reader, static_cast<Base &>(object));
+                    return true;
+                }
+
+                template <typename TBases, std::size_t I, typename T>
+                inline typename std::enable_if<I == std::tuple_size<TBases>::value, bool>::type
+                ReadTaggedBase(Reader &reader, T &object, std::uint32_t tag)
+                {
+                    Common::Unused(reader, object, tag);
+                    return false;
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I != N, bool>::type
+                ReadTaggedFields(Reader &reader, T &object, std::uint32_t tag)
+                {
+                    using Field = typename Reflection::Reflect<T>::Fields::template Field<I>;
+                    using Tag = std::integral_constant<std::uint32_t, Common::Crc32(Field::Name::Value)>;
+                    if (tag != Tag::value)
+                        return ReadTaggedFields<I + 1, N>(reader, object, tag);
+                    ReadTaggedValue(reader, object.*Field::Access());
+                    return true;
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I == N, bool>::type
+                ReadTaggedFields(Reader &reader, T &object, std::uint32_t tag)
+                {
+                    Common::Unused(reader, object, tag);
+                    return false;
+                }
+
+                // The body of the structure is the sequence of the fields, each one is the tag and
+                // the sized data. The fields which are unknown to this version of the structure
+                // are skipped.
+                template <typename T>
+                inline void ReadTaggedBody(Reader &reader, T &object)
+                {
+                    using Meta = Reflection::Reflect<T>;
+
+                    while (!reader.IsEnd())
+                    {
+                        auto const tag = static_cast<std::uint32_t>(reader.ReadFixed(sizeof(std::uint32_t)));
+                        char const *data = nullptr;
+                        auto const size = reader.ReadBytes(data);
+                        Reader field{data, data + size, Layout::Tagged};
+                        if (!ReadTaggedBase<typename Meta::Base, 0>(field, object, tag))
+                            ReadTaggedFields<0, Meta::Fields::Count>(field, object, tag);
+                    }
+                }
+
+                template <typename T>
+                inline typename std::enable_if<Reflection::IsReflectable<T>() && !std::is_enum<T>::value, void>::type
+                ReadTaggedValue(Reader &reader, T &object)
+                {
+                    ReadTaggedBody(reader, object);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<!Reflection::IsReflectable<T>() || std::is_enum<T>::value, void>::type
+                ReadTaggedValue(Reader &reader, T &object)
+                {
+                    Read(reader, object);
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I != N, void>::type
+                ReadItems(Reader &reader, T &object)
+                {
+                    Read(reader, std::get<I>(object));
+                    ReadItems<I + 1, N>(reader, object);
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I == N, void>::type
+                ReadItems(Reader &reader, T &object)
+                {
+                    Common::Unused(reader, object);
+                }
+
+            }   // namespace Detail
+
+            template <typename T>
+            inline void Serialize(T const &object, Common::Buffer &buffer, Layout layout = Layout::Compact)
+            {
+                Serialization::Reserve<Estimate::Binary>(buffer, object);
+                Detail::WriteData(buffer, layout, [&object] (Detail::Writer &writer) { Detail::Write(writer, object); });
+            }
+
+            template <typename T>
+            inline Common::Buffer Serialize(T const &object, Layout layout = Layout::Compact)
+            {
+                Common::Buffer buffer;
+                Serialize(object, buffer, layout);
+                return buffer;
+            }
+
+            template <typename T>
+            inline T Deserialize(char const *data, std::size_t size, Layout layout = Layout::Compact)
+            {
+                Detail::Reader reader{data, data + size, layout};
+                T object{};
+                Detail::Read(reader, object);
+                if (!reader.IsEnd())
+                    throw std::invalid_argument{"[Mif::Serialization::Binary::Deserialize] Unexpected data after the object."};
+                return object;
+            }
+
+            template <typename T>
+            inline T Deserialize(Common::Buffer const &buffer, Layout layout = Layout::Compact)
+            {
+                return Deserialize<T>(buffer.data(), buffer.size(), layout);
+            }
+
+        }   // namespace Binary
+    }   // namespace Serialization
+}   // namespace Mif
+
+#endif  // !__MIF_SERIALIZATION_BINARY_H__
@@ -0,0 +1,527 @@
+//-------------------------------------------------------------------
+//  MetaInfo Framework (MIF)
+//  https://github.com/tdv/mif
+//  Created:     10.2026
+//  Copyright (C) 2016-2024 tdv
+//-------------------------------------------------------------------
+
+#ifndef __MIF_SERIALIZATION_ESTIMATE_SIZE_H__
+#define __MIF_SERIALIZATION_ESTIMATE_SIZE_H__
+
+// STD
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// MIF
+#include "mif/common/types.h"
+#include "mif/common/unused.h"
+#include "mif/reflection/reflection.h"
+#include "mif/serialization/traits.h"
+
+namespace Mif
+{
+    namespace Serialization
+    {
+        // The formats for EstimateSize. The size of the fixed-size values is exact or the upper bound
+        // (the varints, the numbers in text), the strings and the containers are walked without
+        // formatting. The escaping of the strings in json is not taken into account.
+        namespace Estimate
+        {
+
+            inline std::size_t GetVarintSize(std::uint64_t value)
+            {
+                std::size_t size = 1;
+                for ( ; value >= 0x80 ; value >>= 7)
+                    ++size;
+                return size;
+            }
+
+            // Serialization::Binary in the compact layout.
+            struct Binary final
+            {
+                template <typename T>
+                static constexpr std::size_t Number()
+                {
+                    return std::is_floating_point<T>::value || sizeof(T) == 1 ? sizeof(T) : (sizeof(T) * 8 + 6) / 7;
+                }
+
+                template <typename T>
+                static constexpr std::size_t Enum()
+                {
+                    return Number<typename std::underlying_type<T>::type>();
+                }
+
+                static std::size_t String(std::size_t size)
+                {
+                    return GetVarintSize(size) + size;
+                }
+
+                template <typename>
+                static std::size_t Blob(std::size_t size)
+                {
+                    return String(size);
+                }
+
+                static std::size_t Struct(std::size_t)
+                {
+                    return 0;
+                }
+
+                static std::size_t Member(std::size_t)
+                {
+                    return 0;
+                }
+
+                static std::size_t Nullable(bool)
+                {
+                    return 1;
+                }
+
+                static std::size_t Array(std::size_t size)
+                {
+                    return GetVarintSize(size);
+                }
+
+                static std::size_t Map(std::size_t size)
+                {
+                    return GetVarintSize(size);
+                }
+
+                static std::size_t Tuple(std::size_t)
+                {
+                    return 0;
+                }
+
+                static std::size_t Unknown()
+                {
+                    return 16;
+                }
+            };
+
+            // Serialization::MsgPack
+            struct MsgPack final
+            {
+                template <typename T>
+                static constexpr std::size_t Number()
+                {
+                    return std::is_same<T, bool>::value ? 1 : 1 + sizeof(T);
+                }
+
+                template <typename T>
+                static constexpr std::size_t Enum()
+                {
+                    return Reflection::IsReflectable<T>() ? 1 + 16 : Number<typename std::underlying_type<T>::type>();
+                }
+
+                static std::size_t String(std::size_t size)
+                {
+                    return (size < 32 ? 1 : size < 0x100 ? 2 : size < 0x10000 ? 3 : 5) + size;
+                }
+
+                template <typename>
+                static std::size_t Blob(std::size_t size)
+                {
+                    return (size < 0x100 ? 2 : size < 0x10000 ? 3 : 5) + size;
+                }
+
+                static std::size_t Struct(std::size_t count)
+                {
+                    return Map(count);
+                }
+
+                static std::size_t Member(std::size_t size)
+                {
+                    return String(size);
+                }
+
+                static std::size_t Nullable(bool)
+                {
+                    return 1;
+                }
+
+                static std::size_t Array(std::size_t size)
+                {
+                    return size < 16 ? 1 : size < 0x10000 ? 3 : 5;
+                }
+
+                static std::size_t Map(std::size_t size)
+                {
+                    return Array(size);
+                }
+
+                static std::size_t Tuple(std::size_t size)
+                {
+                    return Array(size);
+                }
+
+                static std::size_t Unknown()
+                {
+                    return 16;
+                }
+            };
+
+            // Serialization::Json (the compact form)
+            struct Json final
+            {
+                template <typename T>
+                static constexpr std::size_t Number()
+                {
+                    return std::is_same<T, bool>::value ? 5 :
+                            std::is_floating_point<T>::value ? 24 :
+                            std::numeric_limits<T>::digits10 + 1 + (std::is_signed<T>::value ? 1 : 0);
+                }
+
+                template <typename T>
+                static constexpr std::size_t Enum()
+                {
+                    return 2 + 16;
+                }
+
+                static std::size_t String(std::size_t size)
+                {
+                    return 2 + size;
+                }
+
+                // The base64 string or the string of hex pairs in the array.
+                template <typename T>
+                static std::size_t Blob(std::size_t size)
+                {
+                    return BlobAsBase64<T>::value ? 2 + (size + 2) / 3 * 4 : 4 + 3 * size;
+                }
+
+                static std::size_t Struct(std::size_t count)
+                {
+                    return 2 + (count ? count - 1 : 0);
+                }
+
+                static std::size_t Member(std::size_t size)
+                {
+                    return size + 3;
+                }
+
+                static std::size_t Nullable(bool isNull)
+                {
+                    return isNull ? 4 : 0;
+                }
+
+                static std::size_t Array(std::size_t size)
+                {
+                    return 2 + (size ? size - 1 : 0);
+                }
+
+                // The map item is either {"id":key,"val":value} or "key":value.
+                static std::size_t Map(std::size_t size)
+                {
+                    return Array(size) + size * 14;
+                }
+
+                static std::size_t Tuple(std::size_t size)
+                {
+                    return Array(size);
+                }
+
+                static std::size_t Unknown()
+                {
+                    return 16;
+                }
+            };
+
+            namespace Detail
+            {
+
+                template <typename T, typename = void>
+                struct IsCharItem
+                    : public std::false_type
+                {
+                };
+
+                template <typename T>
+                struct IsCharItem<T, typename std::enable_if<Traits::IsIterable<T>()>::type>
+                    : public std::is_same<typename std::decay<typename T::value_type>::type, char>
+                {
+                };
+
+                template <typename T>
+                inline constexpr bool IsBlob()
+                {
+                    return Traits::IsIterable<T>() && !Traits::IsMap<T>() && IsCharItem<T>::value;
+                }
+
+                template <typename T>
+                inline constexpr bool IsArray()
+                {
+                    return Traits::IsIterable<T>() && !Traits::IsMap<T>() && !IsBlob<T>();
+                }
+
+                template <typename T>
+                inline constexpr bool IsNullable()
+                {
+                    return Traits::IsSmartPointer<T>() || Traits::IsOptional<T>();
+                }
+
+                template <typename T>
+                inline constexpr bool IsStruct()
+                {
+                    return Reflection::IsReflectable<T>() && !std::is_enum<T>::value;
+                }
+
+                template <typename>
+                struct IsTuple
+                    : public std::false_type
+                {
+                };
+
+                template <typename TFirst, typename TSecond>
+                struct IsTuple<std::pair<TFirst, TSecond>>
+                    : public std::true_type
+                {
+                };
+
+                template <typename ... T>
+                struct IsTuple<std::tuple<T ... >>
+                    : public std::true_type
+                {
+                };
+
+                template <typename T>
+                inline constexpr bool IsKnown()
+                {
+                    return std::is_arithmetic<T>::value || std::is_enum<T>::value || std::is_same<T, std::string>::value ||
+                            IsStruct<T>() || IsNullable<T>() || Traits::IsIterable<T>() || IsTuple<T>::value;
+                }
+
+                //--------------------------------------------------------------------------------------------------------------------------
+
+                template <typename TFormat, typename T>
+                typename std::enable_if<std::is_arithmetic<T>::value, std::size_t>::type
+                GetSize(T const &object);
+
+                template <typename TFormat, typename T>
+                typename std::enable_if<std::is_enum<T>::value, std::size_t>::type
+                GetSize(T const &object);
+
+                template <typename TFormat>
+                std::size_t GetSize(std::string const &object);
+
+                template <typename TFormat, typename T>
+                typename std::enable_if<IsStruct<T>(), std::size_t>::type
+                GetSize(T const &object);
+
+                template <typename TFormat, typename T>
+                typename std::enable_if<IsNullable<T>(), std::size_t>::type
+                GetSize(T const &object);
+
+                template <typename TFormat, typename T>
+                typename std::enable_if<IsBlob<T>(), std::size_t>::type
+                GetSize(T const &object);
+
+                template <typename TFormat, typename T>
+                typename std::enable_if<IsArray<T>(), std::size_t>::type
+                GetSize(T const &object);
+
+                template <typename TFormat, typename T>
+                typename std::enable_if<Traits::IsMap<T>(), std::size_t>::type
+                GetSize(T const &object);
+
+                template <typename TFormat, typename TFirst, typename TSecond>
+                std::size_t GetSize(std::pair<TFirst, TSecond> const &object);
+
+                template <typename TFormat, typename ... T>
+                std::size_t GetSize(std::tuple<T ... > const &object);
+
+                template <typename TFormat, typename T>
+                typename std::enable_if<!IsKnown<T>(), std::size_t>::type
+                GetSize(T const &object);
+
+                //--------------------------------------------------------------------------------------------------------------------------
+
+                template <typename TFormat, typename TBases, std::size_t I, typename T>
+                inline typename std::enable_if<I == std::tuple_size<TBases>::value, std::size_t>::type
+                GetBasesSize(T const &object)
+                {
+                    Common::Unused(object);
+                    return 0;
+                }
+
+                template <typename TFormat, typename TBases, std::size_t I, typename T>
+                inline typename std::enable_if<I != std::tuple_size<TBases>::value, std::size_t>::type
+                GetBasesSize(T const &object)
+                {
+                    using Base = typename std::tuple_element<I, TBases>::type;
+                    return TFormat::Member(std::strlen(Reflection::Reflect<Base>::Name::Value)) +
+                            GetSize<TFormat>(static_cast<Base const &>(object)) +
+                            GetBasesSize<TFormat, TBases, I + 1>(object);
+                }
+
+                template <typename TFormat, std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I == N, std::size_t>::type
+                GetFieldsSize(T const &object)
+                {
+                    Common::Unused(object);
+                    return 0;
+                }
+
+                template <typename TFormat, std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I != N, std::size_t>::type
+                GetFieldsSize(T const &object)
+                {
+                    using Field = typename Reflection::Reflect<T>::Fields::template Field<I>;
+                    return TFormat::Member(std::strlen(Field::Name::Value)) +
+                            GetSize<TFormat>(object.*Field::Access()) +
+                            GetFieldsSize<TFormat, I + 1, N>(object);
+                }
+
+                template <typename TFormat, std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I == N, std::size_t>::type
+                GetItemsSize(T const &object)
+                {
+                    Common::Unused(object);
+                    return 0;
+                }
+
+                template <typename TFormat, std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I != N, std::size_t>::type
+                GetItemsSize(T const &object)
+                {
+                    return GetSize<TFormat>(std::get<I>(object)) + GetItemsSize<TFormat, I + 1, N>(object);
+                }
+
+                // The items of the fixed size are not walked.
+                template <typename TFormat, typename T>
+                inline typename std::enable_if<std::is_arithmetic<typename T::value_type>::value, std::size_t>::type
+                GetArrayItemsSize(T const &object, std::size_t count)
+                {
+                    Common::Unused(object);
+                    return count * TFormat::template Number<typename T::value_type>();
+                }
+
+                template <typename TFormat, typename T>
+                inline typename std::enable_if<!std::is_arithmetic<typename T::value_type>::value, std::size_t>::type
+                GetArrayItemsSize(T const &object, std::size_t count)
+                {
+                    Common::Unused(count);
+                    std::size_t size = 0;
+                    for (auto const &i : object)
+                        size += GetSize<TFormat>(i);
+                    return size;
+                }
+
+                //--------------------------------------------------------------------------------------------------------------------------
+
+                template <typename TFormat, typename T>
+                inline typename std::enable_if<std::is_arithmetic<T>::value, std::size_t>::type
+                GetSize(T const &object)
+                {
+                    Common::Unused(object);
+                    return TFormat::template Number<T>();
+                }
+
+                template <typename TFormat, typename T>
+                inline typename std::enable_if<std::is_enum<T>::value, std::size_t>::type
+                GetSize(T const &object)
+                {
+                    Common::Unused(object);
+                    return TFormat::template Enum<T>();
+                }
+
+                template <typename TFormat>
+                inline std::size_t GetSize(std::string const &object)
+                {
+                    return TFormat::String(object.size());
+                }
+
+                template <typename TFormat, typename T>
+                inline typename std::enable_if<IsStruct<T>(), std::size_t>::type
+                GetSize(T const &object)
+                {
+                    using Meta = Reflection::Reflect<T>;
+                    using Bases = typename Meta::Base;
+                    return TFormat::Struct(std::tuple_size<Bases>::value + Meta::Fields::Count) +
+                            GetBasesSize<TFormat, Bases, 0>(object) +
+                            GetFieldsSize<TFormat, 0, Meta::Fields::Count>(object);
+                }
+
+                template <typename TFormat, typename T>
+                inline typename std::enable_if<IsNullable<T>(), std::size_t>::type
+                GetSize(T const &object)
+                {
+                    return TFormat::Nullable(!object) + (object ? GetSize<TFormat>(*object) : 0);
+                }
+
+                template <typename TFormat, typename T>
+                inline typename std::enable_if<IsBlob<T>(), std::size_t>::type
+                GetSize(T const &object)
+                {
+                    return TFormat::template Blob<T>(static_cast<std::size_t>(std::distance(std::begin(object), std::end(object))));
+                }
+
+                template <typename TFormat, typename T>
+                inline typename std::enable_if<IsArray<T>(), std::size_t>::type
+                GetSize(T const &object)
+                {
+                    auto const count = static_cast<std::size_t>(std::distance(std::begin(object), std::end(object)));
+                    return TFormat::Array(count) + GetArrayItemsSize<TFormat>(object, count);
+                }
+
+                template <typename TFormat, typename T>
+                inline typename std::enable_if<Traits::IsMap<T>(), std::size_t>::type
+                GetSize(T const &object)
+                {
+                    auto size = TFormat::Map(object.size());
+                    for (auto const &i : object)
+                        size += GetSize<TFormat>(i.first) + GetSize<TFormat>(i.second);
+                    return size;
+                }
+
+                template <typename TFormat, typename TFirst, typename TSecond>
+                inline std::size_t GetSize(std::pair<TFirst, TSecond> const &object)
+                {
+                    return TFormat::Tuple(2) + GetSize<TFormat>(object.first) + GetSize<TFormat>(object.second);
+                }
+
+                template <typename TFormat, typename ... T>
+                inline std::size_t GetSize(std::tuple<T ... > const &object)
+                {
+                    return TFormat::Tuple(sizeof ... (T)) + GetItemsSize<TFormat, 0, sizeof ... (T)>(object);
+                }
+
+                template <typename TFormat, typename T>
+                inline typename std::enable_if<!IsKnown<T>(), std::size_t>::type
+                GetSize(T const &object)
+                {
+                    Common::Unused(object);
+                    return TFormat::Unknown();
+                }
+
+            }   // namespace Detail
+        }   // namespace Estimate
+
+        // Returns the estimated size of the object serialized in the format in order to reserve
+        // the buffer before the serialization.
+        template <typename TFormat = Estimate::Binary, typename T>
+        inline std::size_t EstimateSize(T const &object)
+        {
+            return Estimate::Detail::GetSize<TFormat>(object);
+        }
+
+        // Reserves the buffer for the object to be appended. The capacity grows at least twice,
+        // so the reserving before each of many small objects doesn't reallocate the buffer each time.
+        template <typename TFormat = Estimate::Binary, typename T>
+        inline void Reserve(Common::Buffer &buffer, T const &object)
+        {
+            auto const size = buffer.size() + EstimateSize<TFormat>(object);
+            if (size > buffer.capacity())
+                buffer.reserve(std::max(size, buffer.capacity() * 2));
+        }
+
+    }   // namespace Serialization
+}   // namespace Mif
+
+#endif  // !__MIF_SERIALIZATION_ESTIMATE_SIZE_H__
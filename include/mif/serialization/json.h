@@ -27,15 +27,21 @@
 #include <boost/json.hpp>
 
 // MIF
+#include "mif/common/base64.h"
 #include "mif/common/config.h"
 #include "mif/common/types.h"
 #include "mif/common/index_sequence.h"
 #include "mif/common/static_string.h"
 #include "mif/common/unused.h"
 #include "mif/reflection/reflection.h"
+#include "mif/serialization/estimate_size.h"
+#include "mif/serialization/json_reader.h"
+#include "mif/serialization/json_writer.h"
 #include "mif/serialization/traits.h"
 
 // Use MIF_PRETTY_JSON_WRITER define in order to write pretty json
+// Specialize BlobAsBase64 in order to write the byte containers as base64 strings instead of hex strings
+// Specialize Json::MapAsObject in order to write the maps with the string or integer keys as json objects
 
 namespace Mif
 {
@@ -45,13 +51,6 @@ namespace Mif
         {
             namespace Detail
             {
-                namespace Tag
-                {
-
-                    using Id = MIF_STATIC_STR("id");
-                    using Value = MIF_STATIC_STR("val");
-
-                }   // namespace Tag
 
                 template <typename, std::size_t>
                 struct BasesSerializer;
@@ -93,11 +92,16 @@ namespace Mif
                 typename std::enable_if
                     <
                         Traits::IsIterable<T>() &&
-                            !std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                            !std::is_same<typename std::decay<typename T::value_type>::type, char>::value &&
+                            !IsObjectMap<T>(),
                         boost::json::value
                     >::type
                 ValueToJson(T const &array);
 
+                template <typename T>
+                typename std::enable_if<IsObjectMap<T>(), boost::json::value>::type
+                ValueToJson(T const &map);
+
                 template <typename T>
                 typename std::enable_if
                     <
@@ -153,11 +157,19 @@ namespace Mif
                 inline typename std::enable_if
                     <
                         Traits::IsIterable<T>() &&
-                            !std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                            !std::is_same<typename std::decay<typename T::value_type>::type, char>::value &&
+                            !HasObjectKey<T>::value,
                         T
                     >::type&
                 JsonToValue(boost::json::value const &root, T &object);
 
+                template <typename T>
+                inline typename std::enable_if<HasObjectKey<T>::value, T>::type&
+                JsonToValue(boost::json::value const &root, T &object);
+
+                template <typename T>
+                T& JsonArrayToValue(boost::json::value const &root, T &object);
+
                 template <typename T>
                 inline typename std::enable_if
                     <
@@ -228,7 +240,8 @@ namespace Mif
                 inline typename std::enable_if
                     <
                         Traits::IsIterable<T>() &&
-                            !std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                            !std::is_same<typename std::decay<typename T::value_type>::type, char>::value &&
+                            !IsObjectMap<T>(),
                         boost::json::value
                     >::type
                 ValueToJson(T const &array)
@@ -241,6 +254,30 @@ namespace Mif
                     return boost::json::value_from(root);
                 }
 
+                inline std::string const& KeyToString(std::string const &key)
+                {
+                    return key;
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_integral<T>::value, std::string>::type
+                KeyToString(T const &key)
+                {
+                    return std::to_string(key);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<IsObjectMap<T>(), boost::json::value>::type
+                ValueToJson(T const &map)
+                {
+                    boost::json::object root;
+
+                    for (auto const &i : map)
+                        root[KeyToString(i.first)] = ValueToJson(i.second);
+
+                    return boost::json::value_from(root);
+                }
+
                 template <typename T>
                 inline typename std::enable_if
                     <
@@ -250,6 +287,13 @@ namespace Mif
                     >::type
                 ValueToJson(T const &array)
                 {
+                    if (BlobAsBase64<T>::value)
+                    {
+                        std::string data;
+                        Common::Base64::Encode(std::begin(array), std::end(array), data);
+                        return ValueToJson(data);
+                    }
+
                     boost::json::array root;
 
                     std::ostringstream stream;
@@ -628,10 +672,40 @@ namespace Mif
                 inline typename std::enable_if
                     <
                         Traits::IsIterable<T>() &&
-                            !std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                            !std::is_same<typename std::decay<typename T::value_type>::type, char>::value &&
+                            !HasObjectKey<T>::value,
                         T
                     >::type&
                 JsonToValue(boost::json::value const &root, T &object)
+                {
+                    return JsonArrayToValue(root, object);
+                }
+
+                // The map is taken as the json object {"key": value} or as the array of the pairs.
+                template <typename T>
+                inline typename std::enable_if<HasObjectKey<T>::value, T>::type&
+                JsonToValue(boost::json::value const &root, T &object)
+                {
+                    auto const *obj = root.if_object();
+                    if (!obj)
+                        return JsonArrayToValue(root, object);
+
+                    T{}.swap(object);
+
+                    for (auto const &i : *obj)
+                    {
+                        typename T::key_type key{};
+                        KeyFromString(i.key().data(), i.key().size(), key);
+                        typename T::mapped_type value{};
+                        JsonToValue(i.value(), value);
+                        *std::inserter(object, std::end(object)) = typename T::value_type{std::move(key), std::move(value)};
+                    }
+
+                    return object;
+                }
+
+                template <typename T>
+                inline T& JsonArrayToValue(boost::json::value const &root, T &object)
                 {
                     auto const *arr = root.if_array();
                     if (!arr)
@@ -666,28 +740,23 @@ namespace Mif
                     >::type&
                 JsonToValue(boost::json::value const &root, T &object)
                 {
-                    auto const *arr = root.if_string();
-                    if (!arr)
+                    // The string of hex pairs in the array or the base64 string.
+                    auto const *str = root.if_string();
+                    if (!str)
+                    {
+                        auto const *arr = root.if_array();
+                        if (arr && arr->size() == 1)
+                            str = (*arr)[0].if_string();
+                    }
+
+                    if (!str)
                     {
                         throw std::invalid_argument{"[Mif::Serialization::Json::Detail::JsonToValue] Failed to get value. "
                             "Json element is invalid or is not converted to the array."};
                     }
 
                     T{}.swap(object);
-
-                    if (!arr->size())
-                        return object;
-
-                    using ObjectType = typename T::value_type;
-
-                    std::stringstream stream{arr->c_str()};
-
-                    for (int i = 0 ; stream.good() ; i = 0)
-                    {
-                        stream >> std::hex >> std::setw(2) >> std::setfill('0') >> i;
-                        ObjectType item{static_cast<ObjectType>(i)};
-                        *std::inserter(object, std::end(object)) = std::move(item);
-                    }
+                    DecodeBlob(str->data(), str->size(), object);
 
                     return object;
                 }
@@ -700,8 +769,8 @@ namespace Mif
                     {
                         BasesDeserializer<TBases, I - 1>::Deserialize(root, object);
                         using BaseType = typename std::tuple_element<I - 1, TBases>::type;
-                        auto tmp = boost::json::value_from(root.as_object().at(Reflection::Reflect<BaseType>::Name::Value));
-                        JsonToValue(tmp, static_cast<BaseType &>(object));
+                        JsonToValue(root.as_object().at(Reflection::Reflect<BaseType>::Name::Value),
+                                static_cast<BaseType &>(object));
                     }
                 };
 
@@ -723,11 +792,9 @@ namespace Mif
                     {
                         Deserializer<I - 1>::Deserialize(root, object);
                         using FieldType = typename Reflection::Reflect<T>::Fields::template Field<I - 1>;
-                        auto const &item = root.as_object();
-                        JsonToValue(item.contains(FieldType::Name::Value) ?
-                                item.at(FieldType::Name::Value) :
-                                boost::json::value{},
-                                object.*FieldType::Access());
+                        static boost::json::value const null{};
+                        auto const *item = root.as_object().if_contains(FieldType::Name::Value);
+                        JsonToValue(item ? *item : null, object.*FieldType::Access());
                     }
                 };
 
@@ -740,6 +807,13 @@ namespace Mif
                     }
                 };
 
+                // All nodes of the document are placed in one arena which is released at once with the document.
+                inline boost::json::value Parse(char const *data, std::size_t size)
+                {
+                    return boost::json::parse(boost::json::string_view{data, size},
+                            boost::json::make_shared_resource<boost::json::monotonic_resource>());
+                }
+
 #ifdef MIF_PRETTY_JSON_WRITER
                 inline void Write(std::ostream &os, boost::json::value const &val,
                         std::size_t level = 0)
@@ -841,6 +915,7 @@ namespace Mif
             Serialize(T const &object)
             {
                 Common::Buffer buffer;
+                Serialization::Reserve<Estimate::Json>(buffer, object);
 
                 {
                     boost::iostreams::filtering_ostream stream{boost::iostreams::back_inserter(buffer)};
@@ -872,6 +947,7 @@ namespace Mif
             Serialize(T const &object, std::string const &rootName = {})
             {
                 Common::Buffer buffer;
+                Serialization::Reserve<Estimate::Json>(buffer, object);
 
                 {
                     boost::iostreams::filtering_ostream stream{boost::iostreams::back_inserter(buffer)};
@@ -882,14 +958,11 @@ namespace Mif
                 return buffer;
             }
 
-            template <typename T, typename TStream>
+            template <typename T>
             inline typename std::enable_if<Reflection::IsReflectable<T>(), T>::type
-            Deserialize(TStream &stream)
+            Deserialize(Common::Buffer const &buffer)
             {
-                Common::Buffer buffer;
-                std::copy(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>(),
-                        std::back_inserter(buffer));
-                auto root = boost::json::parse({buffer.data(), buffer.size()});
+                auto const root = Detail::Parse(buffer.data(), buffer.size());
 
                 T object;
                 using BasesType = typename Reflection::Reflect<T>::Base;
@@ -898,40 +971,35 @@ namespace Mif
                 return object;
             }
 
-            template <typename T>
+            template <typename T, typename TStream>
             inline typename std::enable_if<Reflection::IsReflectable<T>(), T>::type
-            Deserialize(Common::Buffer const &buffer)
+            Deserialize(TStream &stream)
             {
-                using SourceType = boost::iostreams::basic_array_source<char>;
-                SourceType source{!buffer.empty() ? buffer.data() : nullptr, buffer.size()};
-                boost::iostreams::stream<SourceType> stream{source};
-
-                return Deserialize<T>(stream);
+                Common::Buffer buffer;
+                std::copy(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>(),
+                        std::back_inserter(buffer));
+                return Deserialize<T>(static_cast<Common::Buffer const &>(buffer));
             }
 
-            template <typename T, typename TStream>
+            template <typename T>
             inline typename std::enable_if<!Reflection::IsReflectable<T>(), T>::type
-            Deserialize(TStream &stream, std::string const &rootName = {})
+            Deserialize(Common::Buffer const &buffer, std::string const &rootName = {})
             {
-                Common::Buffer buffer;
-                std::copy(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>(),
-                        std::back_inserter(buffer));
-                auto root = boost::json::parse({buffer.data(), buffer.size()});
+                auto root = Detail::Parse(buffer.data(), buffer.size());
 
                 T object{};
                 Detail::JsonToValue<T>(rootName.empty() ? root : root.as_object()[rootName], object);
                 return object;
             }
 
-            template <typename T>
+            template <typename T, typename TStream>
             inline typename std::enable_if<!Reflection::IsReflectable<T>(), T>::type
-            Deserialize(Common::Buffer const &buffer, std::string const &rootName = {})
+            Deserialize(TStream &stream, std::string const &rootName = {})
             {
-                using SourceType = boost::iostreams::basic_array_source<char>;
-                SourceType source{!buffer.empty() ? buffer.data() : nullptr, buffer.size()};
-                boost::iostreams::stream<SourceType> stream{source};
-
-                return Deserialize<T>(stream, rootName);
+                Common::Buffer buffer;
+                std::copy(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>(),
+                        std::back_inserter(buffer));
+                return Deserialize<T>(static_cast<Common::Buffer const &>(buffer), rootName);
             }
 
         }   // namespace Json
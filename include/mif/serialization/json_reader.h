@@ -0,0 +1,1095 @@
+//-------------------------------------------------------------------
+//  MetaInfo Framework (MIF)
+//  https://github.com/tdv/mif
+//  Created:     10.2026
+//  Copyright (C) 2016-2024 tdv
+//-------------------------------------------------------------------
+
+#ifndef __MIF_SERIALIZATION_JSON_READER_H__
+#define __MIF_SERIALIZATION_JSON_READER_H__
+
+// STD
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// MIF
+#include "mif/common/base64.h"
+#include "mif/common/number.h"
+#include "mif/common/types.h"
+#include "mif/common/unused.h"
+#include "mif/reflection/field_table.h"
+#include "mif/reflection/reflection.h"
+#include "mif/serialization/json_writer.h"
+#include "mif/serialization/traits.h"
+
+// The reader fills the object straight from the json text in one pass without building
+// the json document. It takes the same json as Json::Deserialize: the unknown members
+// are skipped, the missing ones are allowed only for the pointers and optional values.
+
+namespace Mif
+{
+    namespace Serialization
+    {
+        namespace Json
+        {
+            namespace Detail
+            {
+
+                class StreamReader final
+                {
+                public:
+                    struct Number
+                    {
+                        bool isInteger = false;
+                        bool isNegative = false;
+                        std::uint64_t integer = 0;
+                        double value = 0;
+                    };
+
+                    StreamReader(char const *begin, char const *end)
+                        : m_begin{begin}
+                        , m_pos{begin}
+                        , m_end{end}
+                    {
+                    }
+
+                    // Returns the next significant char without taking it or 0 at the end of data.
+                    char Peek()
+                    {
+                        SkipSpaces();
+                        return m_pos != m_end ? *m_pos : 0;
+                    }
+
+                    void Expect(char ch)
+                    {
+                        if (Peek() != ch)
+                            Fail(std::string{"Expected \""} + ch + "\".");
+                        ++m_pos;
+                    }
+
+                    bool TryTake(char ch)
+                    {
+                        if (Peek() != ch)
+                            return false;
+                        ++m_pos;
+                        return true;
+                    }
+
+                    bool TryNull()
+                    {
+                        return Peek() == 'n' && TryLiteral("null", 4);
+                    }
+
+                    bool ReadBool()
+                    {
+                        if (Peek() == 't' && TryLiteral("true", 4))
+                            return true;
+                        if (Peek() == 'f' && TryLiteral("false", 5))
+                            return false;
+                        Fail("Expected bool value.");
+                        return false;
+                    }
+
+                    bool IsBool()
+                    {
+                        auto const ch = Peek();
+                        return ch == 't' || ch == 'f';
+                    }
+
+                    bool IsNumber()
+                    {
+                        auto const ch = Peek();
+                        return ch == '-' || (ch >= '0' && ch <= '9');
+                    }
+
+                    Number ReadNumber()
+                    {
+                        SkipSpaces();
+
+                        Number number;
+                        auto const *begin = m_pos;
+
+                        if (m_pos != m_end && *m_pos == '-')
+                        {
+                            number.isNegative = true;
+                            ++m_pos;
+                        }
+
+                        auto const *digits = m_pos;
+                        bool overflow = false;
+                        while (m_pos != m_end && *m_pos >= '0' && *m_pos <= '9')
+                        {
+                            auto const digit = static_cast<std::uint64_t>(*m_pos - '0');
+                            if (number.integer > (std::numeric_limits<std::uint64_t>::max() - digit) / 10)
+                                overflow = true;
+                            number.integer = number.integer * 10 + digit;
+                            ++m_pos;
+                        }
+                        if (m_pos == digits)
+                            Fail("Bad number.");
+
+                        number.isInteger = !overflow;
+
+                        if (m_pos != m_end && *m_pos == '.')
+                        {
+                            number.isInteger = false;
+                            ++m_pos;
+                            auto const *fraction = m_pos;
+                            while (m_pos != m_end && *m_pos >= '0' && *m_pos <= '9')
+                                ++m_pos;
+                            if (m_pos == fraction)
+                                Fail("Bad number.");
+                        }
+
+                        if (m_pos != m_end && (*m_pos == 'e' || *m_pos == 'E'))
+                        {
+                            number.isInteger = false;
+                            ++m_pos;
+                            if (m_pos != m_end && (*m_pos == '+' || *m_pos == '-'))
+                                ++m_pos;
+                            auto const *exponent = m_pos;
+                            while (m_pos != m_end && *m_pos >= '0' && *m_pos <= '9')
+                                ++m_pos;
+                            if (m_pos == exponent)
+                                Fail("Bad number.");
+                        }
+
+                        if (number.isInteger && number.isNegative &&
+                                number.integer > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()) + 1)
+                        {
+                            number.isInteger = false;
+                        }
+
+                        if (number.isInteger)
+                        {
+                            number.value = number.isNegative ?
+                                    -static_cast<double>(number.integer) :
+                                    static_cast<double>(number.integer);
+                        }
+                        else
+                        {
+                            Common::Number::ParseDouble(begin, m_pos, number.value);
+                        }
+
+                        return number;
+                    }
+
+                    void ReadString(std::string &value)
+                    {
+                        char const *data = nullptr;
+                        std::size_t size = 0;
+                        ReadString(data, size);
+                        value.assign(data, size);
+                    }
+
+                    // The string is given in place if it has no escaped chars. Otherwise it
+                    // is decoded into the inner buffer which is valid up to the next call.
+                    void ReadString(char const *&data, std::size_t &size)
+                    {
+                        Expect('"');
+
+                        auto const *begin = m_pos;
+                        while (m_pos != m_end && *m_pos != '"' && *m_pos != '\\')
+                        {
+                            if (static_cast<unsigned char>(*m_pos) < 0x20)
+                                Fail("Control char in string.");
+                            ++m_pos;
+                        }
+
+                        if (m_pos == m_end)
+                            Fail("Unterminated string.");
+
+                        if (*m_pos == '"')
+                        {
+                            data = begin;
+                            size = static_cast<std::size_t>(m_pos - begin);
+                            ++m_pos;
+                            return;
+                        }
+
+                        m_string.assign(begin, m_pos);
+                        while (true)
+                        {
+                            if (m_pos == m_end)
+                                Fail("Unterminated string.");
+
+                            auto const ch = *m_pos++;
+                            if (ch == '"')
+                                break;
+
+                            if (static_cast<unsigned char>(ch) < 0x20)
+                                Fail("Control char in string.");
+
+                            if (ch != '\\')
+                            {
+                                m_string.push_back(ch);
+                                continue;
+                            }
+
+                            if (m_pos == m_end)
+                                Fail("Unterminated string.");
+
+                            switch (*m_pos++)
+                            {
+                            case '"' :
+                                m_string.push_back('"');
+                                break;
+                            case '\\' :
+                                m_string.push_back('\\');
+                                break;
+                            case '/' :
+                                m_string.push_back('/');
+                                break;
+                            case 'b' :
+                                m_string.push_back('\b');
+                                break;
+                            case 'f' :
+                                m_string.push_back('\f');
+                                break;
+                            case 'n' :
+                                m_string.push_back('\n');
+                                break;
+                            case 'r' :
+                                m_string.push_back('\r');
+                                break;
+                            case 't' :
+                                m_string.push_back('\t');
+                                break;
+                            case 'u' :
+                                AppendCodePoint(ReadCodePoint());
+                                break;
+                            default :
+                                Fail("Bad escape sequence.");
+                            }
+                        }
+
+                        data = m_string.data();
+                        size = m_string.size();
+                    }
+
+                    // Skips the value of any type without the recursion.
+                    void SkipValue()
+                    {
+                        std::string containers;
+                        do
+                        {
+                            auto const ch = Peek();
+                            if (ch == '{' || ch == '[')
+                            {
+                                ++m_pos;
+                                if (!TryTake(ch == '{' ? '}' : ']'))
+                                {
+                                    containers.push_back(ch);
+                                    if (ch == '{')
+                                    {
+                                        SkipString();
+                                        Expect(':');
+                                    }
+                                    continue;
+                                }
+                            }
+                            else if (ch == '"')
+                            {
+                                SkipString();
+                            }
+                            else if (ch == 't' || ch == 'f')
+                            {
+                                ReadBool();
+                            }
+                            else if (ch == 'n')
+                            {
+                                if (!TryNull())
+                                    Fail("Bad value.");
+                            }
+                            else
+                            {
+                                ReadNumber();
+                            }
+
+                            // The end of the value: go to the next item or leave the finished containers.
+                            while (!containers.empty())
+                            {
+                                if (TryTake(','))
+                                {
+                                    if (containers.back() == '{')
+                                    {
+                                        SkipString();
+                                        Expect(':');
+                                    }
+                                    break;
+                                }
+                                Expect(containers.back() == '{' ? '}' : ']');
+                                containers.pop_back();
+                            }
+                        }
+                        while (!containers.empty());
+                    }
+
+                    bool IsEnd()
+                    {
+                        SkipSpaces();
+                        return m_pos == m_end;
+                    }
+
+                    [[noreturn]]
+                    void Fail(std::string const &message) const
+                    {
+                        throw std::invalid_argument{"[Mif::Serialization::Json::Detail::StreamReader] " + message +
+                                " Position: " + std::to_string(m_pos - m_begin) + "."};
+                    }
+
+                private:
+                    char const *m_begin;
+                    char const *m_pos;
+                    char const *m_end;
+                    std::string m_string;
+
+                    void SkipSpaces()
+                    {
+                        while (m_pos != m_end && (*m_pos == ' ' || *m_pos == '\n' || *m_pos == '\r' || *m_pos == '\t'))
+                            ++m_pos;
+                    }
+
+                    bool TryLiteral(char const *literal, std::size_t size)
+                    {
+                        if (static_cast<std::size_t>(m_end - m_pos) < size || std::memcmp(m_pos, literal, size))
+                            return false;
+                        m_pos += size;
+                        return true;
+                    }
+
+                    void SkipString()
+                    {
+                        char const *data = nullptr;
+                        std::size_t size = 0;
+                        ReadString(data, size);
+                    }
+
+                    unsigned ReadHex()
+                    {
+                        if (m_end - m_pos < 4)
+                            Fail("Bad escape sequence.");
+                        unsigned value = 0;
+                        for (int i = 0 ; i < 4 ; ++i)
+                        {
+                            auto const ch = *m_pos++;
+                            value <<= 4;
+                            if (ch >= '0' && ch <= '9')
+                                value |= static_cast<unsigned>(ch - '0');
+                            else if (ch >= 'a' && ch <= 'f')
+                                value |= static_cast<unsigned>(ch - 'a' + 10);
+                            else if (ch >= 'A' && ch <= 'F')
+                                value |= static_cast<unsigned>(ch - 'A' + 10);
+                            else
+                                Fail("Bad escape sequence.");
+                        }
+                        return value;
+                    }
+
+                    std::uint32_t ReadCodePoint()
+                    {
+                        auto const high = ReadHex();
+                        if (high < 0xD800 || high > 0xDBFF)
+                            return high;
+                        if (m_end - m_pos < 2 || m_pos[0] != '\\' || m_pos[1] != 'u')
+                            Fail("Bad surrogate pair.");
+                        m_pos += 2;
+                        auto const low = ReadHex();
+                        if (low < 0xDC00 || low > 0xDFFF)
+                            Fail("Bad surrogate pair.");
+                        return 0x10000 + ((high - 0xD800) << 10) + (low - 0xDC00);
+                    }
+
+                    void AppendCodePoint(std::uint32_t code)
+                    {
+                        if (code < 0x80)
+                        {
+                            m_string.push_back(static_cast<char>(code));
+                        }
+                        else if (code < 0x800)
+                        {
+                            m_string.push_back(static_cast<char>(0xC0 | (code >> 6)));
+                            m_string.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+                        }
+                        else if (code < 0x10000)
+                        {
+                            m_string.push_back(static_cast<char>(0xE0 | (code >> 12)));
+                            m_string.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                            m_string.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+                        }
+                        else
+                        {
+                            m_string.push_back(static_cast<char>(0xF0 | (code >> 18)));
+                            m_string.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+                            m_string.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                            m_string.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+                        }
+                    }
+                };
+
+                template <typename T>
+                typename std::enable_if<std::is_pointer<T>::value, void>::type
+                ReadValue(StreamReader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if<std::is_same<T, bool>::value, void>::type
+                ReadValue(StreamReader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value && std::is_signed<T>::value, void>::type
+                ReadValue(StreamReader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value && std::is_unsigned<T>::value, void>::type
+                ReadValue(StreamReader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if<std::is_floating_point<T>::value, void>::type
+                ReadValue(StreamReader &reader, T &object);
+
+                inline void ReadValue(StreamReader &reader, std::string &object);
+
+                template <typename T>
+                typename std::enable_if<!Reflection::IsReflectable<T>() && std::is_enum<T>::value, void>::type
+                ReadValue(StreamReader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if<Reflection::IsReflectable<T>() && std::is_enum<T>::value, void>::type
+                ReadValue(StreamReader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if<Reflection::IsReflectable<T>() && !std::is_enum<T>::value, void>::type
+                ReadValue(StreamReader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if<Traits::IsSmartPointer<T>(), void>::type
+                ReadValue(StreamReader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if<Traits::IsOptional<T>(), void>::type
+                ReadValue(StreamReader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() &&
+                            !std::is_same<typename std::decay<typename T::value_type>::type, char>::value &&
+                            !HasObjectKey<T>::value,
+                        void
+                    >::type
+                ReadValue(StreamReader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if<HasObjectKey<T>::value, void>::type
+                ReadValue(StreamReader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() &&
+                            std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                        void
+                    >::type
+                ReadValue(StreamReader &reader, T &object);
+
+                template <typename T, std::size_t N>
+                void ReadValue(StreamReader &reader, std::array<T, N> &object);
+
+                template <typename ... T>
+                void ReadValue(StreamReader &reader, std::tuple<T ... > &object);
+
+                template <typename TFirst, typename TSecond>
+                void ReadValue(StreamReader &reader, std::pair<TFirst, TSecond> &object);
+
+                template <typename TBases, std::size_t I, typename T>
+                typename std::enable_if<I != std::tuple_size<TBases>::value, bool>::type
+                ReadBase(StreamReader &reader, T &object, char const *key, std::size_t size, bool *seen);
+
+                template <typename TBases, std::size_t I, typename T>
+                typename std::enable_if<I == std::tuple_size<TBases>::value, bool>::type
+                ReadBase(StreamReader &reader, T &object, char const *key, std::size_t size, bool *seen);
+
+                template <typename T>
+                bool ReadField(StreamReader &reader, T &object, char const *key, std::size_t size, bool *seen);
+
+                template <std::size_t I, std::size_t N, typename T>
+                typename std::enable_if<I != N, void>::type
+                CheckFields(StreamReader &reader, T const &object, bool const *seen);
+
+                template <std::size_t I, std::size_t N, typename T>
+                typename std::enable_if<I == N, void>::type
+                CheckFields(StreamReader &reader, T const &object, bool const *seen);
+
+                template <typename T>
+                void ReadArray(StreamReader &reader, T &object);
+
+                inline void KeyFromString(char const *data, std::size_t size, std::string &key);
+
+                template <typename T>
+                typename std::enable_if<std::is_integral<T>::value, void>::type
+                KeyFromString(char const *data, std::size_t size, T &key);
+
+                template <std::size_t I, std::size_t N, typename T>
+                typename std::enable_if<I != N, void>::type
+                ReadItems(StreamReader &reader, T &object);
+
+                template <std::size_t I, std::size_t N, typename T>
+                typename std::enable_if<I == N, void>::type
+                ReadItems(StreamReader &reader, T &object);
+
+                //--------------------------------------------------------------------------------------------------------------------------
+
+                // The key is compared with the name as is, the names of the fields don't need to be escaped.
+                template <std::size_t N>
+                inline bool IsKey(char const (&name)[N], char const *key, std::size_t size)
+                {
+                    return size < N && !name[size] && !std::memcmp(name, key, size);
+                }
+
+                // The pointers and optional values are kept empty if their fields are missing, other fields are required.
+                template <typename T>
+                inline constexpr bool IsNullable()
+                {
+                    return Traits::IsSmartPointer<T>() || Traits::IsOptional<T>();
+                }
+
+                inline void CheckNotNull(StreamReader &reader)
+                {
+                    if (reader.TryNull())
+                        reader.Fail("Failed to get value from null.");
+                }
+
+                inline int HexDigit(char ch)
+                {
+                    if (ch >= '0' && ch <= '9')
+                        return ch - '0';
+                    if (ch >= 'a' && ch <= 'f')
+                        return ch - 'a' + 10;
+                    if (ch >= 'A' && ch <= 'F')
+                        return ch - 'A' + 10;
+                    throw std::invalid_argument{"[Mif::Serialization::Json::Detail::HexDigit] Bad hex char."};
+                }
+
+                // The hex pairs are always followed by a space, base64 has no spaces.
+                template <typename T>
+                inline void DecodeBlob(char const *data, std::size_t size, T &object)
+                {
+                    using ObjectType = typename T::value_type;
+
+                    if (!std::memchr(data, ' ', size))
+                    {
+                        Common::Base64::Decode<ObjectType>(data, size, std::inserter(object, std::end(object)));
+                        return;
+                    }
+
+                    for (auto const *end = data + size ; data != end ; )
+                    {
+                        if (*data == ' ')
+                        {
+                            ++data;
+                            continue;
+                        }
+
+                        auto value = HexDigit(*data++);
+                        if (data != end && *data != ' ')
+                            value = (value << 4) | HexDigit(*data++);
+
+                        *std::inserter(object, std::end(object)) = static_cast<ObjectType>(value);
+                    }
+                }
+
+                template <typename T>
+                inline T ReadSigned(StreamReader &reader)
+                {
+                    CheckNotNull(reader);
+                    if (!reader.IsNumber())
+                        reader.Fail("Failed to convert to integer.");
+                    auto const number = reader.ReadNumber();
+                    if (!number.isInteger)
+                        reader.Fail("Failed to convert to integer.");
+                    auto const limit = static_cast<std::uint64_t>(std::numeric_limits<T>::max()) + (number.isNegative ? 1 : 0);
+                    if (number.integer > limit)
+                        reader.Fail("Integer is out of range.");
+                    return number.isNegative ?
+                            static_cast<T>(-static_cast<std::int64_t>(number.integer - 1) - 1) :
+                            static_cast<T>(number.integer);
+                }
+
+                template <typename T>
+                inline T ReadUnsigned(StreamReader &reader)
+                {
+                    CheckNotNull(reader);
+                    if (!reader.IsNumber())
+                        reader.Fail("Failed to convert to unsigned integer.");
+                    auto const number = reader.ReadNumber();
+                    if (!number.isInteger || (number.isNegative && number.integer))
+                        reader.Fail("Failed to convert to unsigned integer.");
+                    if (number.integer > std::numeric_limits<T>::max())
+                        reader.Fail("Integer is out of range.");
+                    return static_cast<T>(number.integer);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_pointer<T>::value, void>::type
+                ReadValue(StreamReader &, T &)
+                {
+                    static_assert(!std::is_pointer<T>::value, "[Mif::Serialization::Json::Detail] You can't deserialize the raw pointers.");
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_same<T, bool>::value, void>::type
+                ReadValue(StreamReader &reader, T &object)
+                {
+                    CheckNotNull(reader);
+                    if (reader.IsBool())
+                    {
+                        object = reader.ReadBool();
+                        return;
+                    }
+                    if (!reader.IsNumber())
+                        reader.Fail("Failed to convert to bool.");
+                    auto const number = reader.ReadNumber();
+                    if (!number.isInteger)
+                        reader.Fail("Failed to convert to bool.");
+                    object = !!number.integer;
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value && std::is_signed<T>::value, void>::type
+                ReadValue(StreamReader &reader, T &object)
+                {
+                    object = ReadSigned<T>(reader);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value && std::is_unsigned<T>::value, void>::type
+                ReadValue(StreamReader &reader, T &object)
+                {
+                    object = ReadUnsigned<T>(reader);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_floating_point<T>::value, void>::type
+                ReadValue(StreamReader &reader, T &object)
+                {
+                    CheckNotNull(reader);
+                    if (!reader.IsNumber())
+                        reader.Fail("Failed to convert to double.");
+                    object = static_cast<T>(reader.ReadNumber().value);
+                }
+
+                // Like Json::Deserialize the numbers and bools are taken as the strings too.
+                inline void ReadValue(StreamReader &reader, std::string &object)
+                {
+                    CheckNotNull(reader);
+                    if (reader.Peek() == '"')
+                    {
+                        reader.ReadString(object);
+                    }
+                    else if (reader.IsBool())
+                    {
+                        object = std::to_string(reader.ReadBool());
+                    }
+                    else if (reader.IsNumber())
+                    {
+                        auto const number = reader.ReadNumber();
+                        if (!number.isInteger)
+                            object = std::to_string(number.value);
+                        else if (number.isNegative)
+                            object = std::to_string(-static_cast<std::int64_t>(number.integer - 1) - 1);
+                        else
+                            object = std::to_string(number.integer);
+                    }
+                    else
+                    {
+                        reader.Fail("Failed to convert to string.");
+                    }
+                }
+
+                template <typename T>
+                inline typename std::enable_if<!Reflection::IsReflectable<T>() && std::is_enum<T>::value, void>::type
+                ReadValue(StreamReader &reader, T &object)
+                {
+                    typename std::underlying_type<T>::type value{};
+                    ReadValue(reader, value);
+                    object = static_cast<T>(value);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<Reflection::IsReflectable<T>() && std::is_enum<T>::value, void>::type
+                ReadValue(StreamReader &reader, T &object)
+                {
+                    CheckNotNull(reader);
+                    if (reader.Peek() != '"')
+                        reader.Fail("Failed to convert to enum.");
+                    char const *data = nullptr;
+                    std::size_t size = 0;
+                    reader.ReadString(data, size);
+                    object = Reflection::FromString<T>(data, size);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<Reflection::IsReflectable<T>() && !std::is_enum<T>::value, void>::type
+                ReadValue(StreamReader &reader, T &object)
+                {
+                    using Meta = Reflection::Reflect<T>;
+                    using Bases = typename Meta::Base;
+                    static constexpr std::size_t BasesCount = std::tuple_size<Bases>::value;
+                    static constexpr std::size_t FieldsCount = Meta::Fields::Count;
+
+                    if (reader.Peek() != '{')
+                        reader.Fail("Failed to get value. Json element is not an object.");
+
+                    // One more item to have no zero-sized array.
+                    bool seen[BasesCount + FieldsCount + 1] = {};
+
+                    reader.Expect('{');
+                    if (!reader.TryTake('}'))
+                    {
+                        do
+                        {
+                            char const *key = nullptr;
+                            std::size_t size = 0;
+                            reader.ReadString(key, size);
+                            reader.Expect(':');
+                            // The escaped key is kept in the reader's buffer only up to the next string, so it is
+                            // matched before the value is read.
+                            if (!ReadBase<Bases, 0>(reader, object, key, size, seen) &&
+                                    !ReadField(reader, object, key, size, seen + BasesCount))
+                            {
+                                reader.SkipValue();
+                            }
+                        }
+                        while (reader.TryTake(','));
+                        reader.Expect('}');
+                    }
+
+                    for (std::size_t i = 0 ; i < BasesCount ; ++i)
+                    {
+                        if (!seen[i])
+                            reader.Fail("Failed to get value. The base object is missing.");
+                    }
+
+                    CheckFields<0, FieldsCount>(reader, object, seen + BasesCount);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<Traits::IsSmartPointer<T>(), void>::type
+                ReadValue(StreamReader &reader, T &object)
+                {
+                    if (reader.TryNull())
+                        return;
+
+                    using ObjectType = typename T::element_type;
+                    object.reset(new ObjectType{});
+                    ReadValue(reader, *object);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<Traits::IsOptional<T>(), void>::type
+                ReadValue(StreamReader &reader, T &object)
+                {
+                    if (reader.TryNull())
+                        return;
+
+                    using ObjectType = typename T::value_type;
+                    ObjectType value{};
+                    ReadValue(reader, value);
+                    object.reset(std::move(value));
+                }
+
+                template <typename T>
+                inline typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() &&
+                            !std::is_same<typename std::decay<typename T::value_type>::type, char>::value &&
+                            !HasObjectKey<T>::value,
+                        void
+                    >::type
+                ReadValue(StreamReader &reader, T &object)
+                {
+                    if (reader.Peek() != '[')
+                        reader.Fail("Failed to get value. Json element is not an array.");
+
+                    ReadArray(reader, object);
+                }
+
+                // The map is taken as the json object {"key": value} or as the array of the pairs.
+                template <typename T>
+                inline typename std::enable_if<HasObjectKey<T>::value, void>::type
+                ReadValue(StreamReader &reader, T &object)
+                {
+                    auto const ch = reader.Peek();
+                    if (ch == '[')
+                    {
+                        ReadArray(reader, object);
+                        return;
+                    }
+                    if (ch != '{')
+                        reader.Fail("Failed to get value. Json element is neither an object nor an array.");
+
+                    T{}.swap(object);
+
+                    reader.Expect('{');
+                    if (reader.TryTake('}'))
+                        return;
+
+                    do
+                    {
+                        char const *data = nullptr;
+                        std::size_t size = 0;
+                        reader.ReadString(data, size);
+                        typename T::key_type key{};
+                        KeyFromString(data, size, key);
+                        reader.Expect(':');
+                        typename T::mapped_type value{};
+                        ReadValue(reader, value);
+                        *std::inserter(object, std::end(object)) = typename T::value_type{std::move(key), std::move(value)};
+                    }
+                    while (reader.TryTake(','));
+
+                    reader.Expect('}');
+                }
+
+                template <typename T>
+                inline void ReadArray(StreamReader &reader, T &object)
+                {
+                    T{}.swap(object);
+
+                    reader.Expect('[');
+                    if (reader.TryTake(']'))
+                        return;
+
+                    using ObjectType = typename T::value_type;
+
+                    do
+                    {
+                        ObjectType item{};
+                        ReadValue(reader, item);
+                        *std::inserter(object, std::end(object)) = std::move(item);
+                    }
+                    while (reader.TryTake(','));
+
+                    reader.Expect(']');
+                }
+
+                // The bytes are taken as a string of hex pairs in the array or as a base64 string
+                // which is written if BlobAsBase64 is specialized for the type.
+                template <typename T>
+                inline typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() &&
+                            std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                        void
+                    >::type
+                ReadValue(StreamReader &reader, T &object)
+                {
+                    bool const inArray = reader.TryTake('[');
+                    if (reader.Peek() != '"')
+                        reader.Fail("Failed to get value. Json element is not a string of bytes.");
+
+                    T{}.swap(object);
+
+                    char const *data = nullptr;
+                    std::size_t size = 0;
+                    reader.ReadString(data, size);
+                    DecodeBlob(data, size, object);
+
+                    if (inArray)
+                        reader.Expect(']');
+                }
+
+                template <typename T, std::size_t N>
+                inline void ReadValue(StreamReader &reader, std::array<T, N> &object)
+                {
+                    if (reader.Peek() != '[')
+                        reader.Fail("Failed to get value. Json element is not an array.");
+                    reader.Expect('[');
+                    ReadItems<0, N>(reader, object);
+                    reader.Expect(']');
+                }
+
+                template <typename ... T>
+                inline void ReadValue(StreamReader &reader, std::tuple<T ... > &object)
+                {
+                    if (reader.Peek() != '[')
+                        reader.Fail("Failed to get value. Json element is not an array.");
+                    reader.Expect('[');
+                    ReadItems<0, sizeof ... (T)>(reader, object);
+                    reader.Expect(']');
+                }
+
+                template <typename TFirst, typename TSecond>
+                inline void ReadValue(StreamReader &reader, std::pair<TFirst, TSecond> &object)
+                {
+                    if (reader.Peek() != '{')
+                        reader.Fail("Failed to parse pair. Json element is not an object.");
+
+                    bool hasId = false;
+                    bool hasValue = false;
+
+                    reader.Expect('{');
+                    if (!reader.TryTake('}'))
+                    {
+                        do
+                        {
+                            char const *key = nullptr;
+                            std::size_t size = 0;
+                            reader.ReadString(key, size);
+                            reader.Expect(':');
+                            if (IsKey(Tag::Id::Value, key, size))
+                            {
+                                ReadValue(reader, const_cast<typename std::remove_const<TFirst>::type &>(object.first));
+                                hasId = true;
+                            }
+                            else if (IsKey(Tag::Value::Value, key, size))
+                            {
+                                ReadValue(reader, object.second);
+                                hasValue = true;
+                            }
+                            else
+                            {
+                                reader.SkipValue();
+                            }
+                        }
+                        while (reader.TryTake(','));
+                        reader.Expect('}');
+                    }
+
+                    if (!hasId || !hasValue)
+                        reader.Fail("Failed to parse pair. Json has no pair type object.");
+                }
+
+                template <typename TBases, std::size_t I, typename T>
+                inline typename std::enable_if<I != std::tuple_size<TBases>::value, bool>::type
+                ReadBase(StreamReader &reader, T &object, char const *key, std::size_t size, bool *seen)
+                {
+                    using Base = typename std::tuple_element<I, TBases>::type;
+                    if (!IsKey(Reflection::Reflect<Base>::Name::Value, key, size))
+                        return ReadBase<TBases, I + 1>(reader, object, key, size, seen);
+                    ReadValue(reader, static_cast<Base &>(object));
+                    seen[I] = true;
+                    return true;
+                }
+
+                template <typename TBases, std::size_t I, typename T>
+                inline typename std::enable_if<I == std::tuple_size<TBases>::value, bool>::type
+                ReadBase(StreamReader &reader, T &object, char const *key, std::size_t size, bool *seen)
+                {
+                    Common::Unused(reader, object, key, size, seen);
+                    return false;
+                }
+
+                struct FieldReader final
+                {
+                    StreamReader &reader;
+
+                    template <typename TValue>
+                    void operator () (char const *, TValue &value) const
+                    {
+                        ReadValue(reader, value);
+                    }
+                };
+
+                template <typename T>
+                inline bool ReadField(StreamReader &reader, T &object, char const *key, std::size_t size, bool *seen)
+                {
+                    auto const &table = Reflection::FieldTable<T>::Get();
+                    auto const *field = table.Find(key, size);
+                    if (!field)
+                        return false;
+                    Reflection::FieldTable<T>::Visit(object, field->index, FieldReader{reader});
+                    seen[field->index] = true;
+                    return true;
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I != N, void>::type
+                CheckFields(StreamReader &reader, T const &object, bool const *seen)
+                {
+                    using Field = typename Reflection::Reflect<T>::Fields::template Field<I>;
+                    using FieldType = typename std::decay<decltype(object.*Field::Access())>::type;
+                    if (!seen[I] && !IsNullable<FieldType>())
+                        reader.Fail(std::string{"Failed to get value. The field \""} + Field::Name::Value + "\" is missing.");
+                    CheckFields<I + 1, N>(reader, object, seen);
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I == N, void>::type
+                CheckFields(StreamReader &reader, T const &object, bool const *seen)
+                {
+                    Common::Unused(reader, object, seen);
+                }
+
+                inline void KeyFromString(char const *data, std::size_t size, std::string &key)
+                {
+                    key.assign(data, size);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_integral<T>::value, void>::type
+                KeyFromString(char const *data, std::size_t size, T &key)
+                {
+                    StreamReader reader{data, data + size};
+                    if (!reader.IsNumber())
+                    {
+                        throw std::invalid_argument{"[Mif::Serialization::Json::Detail::KeyFromString] "
+                                "Failed to convert key \"" + std::string{data, size} + "\" to integer."};
+                    }
+                    ReadValue(reader, key);
+                    if (!reader.IsEnd())
+                    {
+                        throw std::invalid_argument{"[Mif::Serialization::Json::Detail::KeyFromString] "
+                                "Failed to convert key \"" + std::string{data, size} + "\" to integer."};
+                    }
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I != N, void>::type
+                ReadItems(StreamReader &reader, T &object)
+                {
+                    if (I)
+                        reader.Expect(',');
+                    ReadValue(reader, std::get<I>(object));
+                    ReadItems<I + 1, N>(reader, object);
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I == N, void>::type
+                ReadItems(StreamReader &reader, T &object)
+                {
+                    Common::Unused(reader, object);
+                }
+
+            }   // namespace Detail
+
+            template <typename T>
+            inline T Read(char const *data, std::size_t size)
+            {
+                Detail::StreamReader reader{data, data + size};
+                T object{};
+                Detail::ReadValue(reader, object);
+                if (!reader.IsEnd())
+                    reader.Fail("Unexpected data after the value.");
+                return object;
+            }
+
+            template <typename T>
+            inline T Read(Common::Buffer const &buffer)
+            {
+                return Read<T>(buffer.data(), buffer.size());
+            }
+
+        }   // namespace Json
+    }   // namespace Serialization
+}   // namespace Mif
+
+#endif  // !__MIF_SERIALIZATION_JSON_READER_H__
@@ -0,0 +1,67 @@
+//-------------------------------------------------------------------
+//  MetaInfo Framework (MIF)
+//  https://github.com/tdv/mif
+//  Created:     10.2026
+//  Copyright (C) 2016-2024 tdv
+//-------------------------------------------------------------------
+
+#ifndef __MIF_SERIALIZATION_JSON_TRAITS_H__
+#define __MIF_SERIALIZATION_JSON_TRAITS_H__
+
+// STD
+#include <string>
+#include <type_traits>
+
+// MIF
+#include "mif/serialization/traits.h"
+
+namespace Mif
+{
+    namespace Serialization
+    {
+        namespace Json
+        {
+
+            // The map is written as the json object {"key": value} instead of the array of
+            // {"id": key, "val": value} objects if it is true. Specialize it with std::true_type
+            // for your map types. The keys have to be the strings or the integers. Both forms
+            // are read regardless of it.
+            template <typename T>
+            struct MapAsObject
+                : public std::false_type
+            {
+            };
+
+            namespace Detail
+            {
+
+                template <typename T, typename = void>
+                struct HasObjectKey
+                    : public std::false_type
+                {
+                };
+
+                template <typename T>
+                struct HasObjectKey<T, typename std::enable_if<Serialization::Traits::IsMap<T>()>::type>
+                    : public std::integral_constant
+                        <
+                            bool,
+                            std::is_same<typename T::key_type, std::string>::value ||
+                                (std::is_integral<typename T::key_type>::value &&
+                                    !std::is_same<typename T::key_type, bool>::value)
+                        >
+                {
+                };
+
+                template <typename T>
+                inline constexpr bool IsObjectMap()
+                {
+                    return HasObjectKey<T>::value && MapAsObject<T>::value;
+                }
+
+            }   // namespace Detail
+        }   // namespace Json
+    }   // namespace Serialization
+}   // namespace Mif
+
+#endif  // !__MIF_SERIALIZATION_JSON_TRAITS_H__
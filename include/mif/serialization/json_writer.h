@@ -0,0 +1,628 @@
+//-------------------------------------------------------------------
+//  MetaInfo Framework (MIF)
+//  https://github.com/tdv/mif
+//  Created:     10.2026
+//  Copyright (C) 2016-2024 tdv
+//-------------------------------------------------------------------
+
+#ifndef __MIF_SERIALIZATION_JSON_WRITER_H__
+#define __MIF_SERIALIZATION_JSON_WRITER_H__
+
+// STD
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// MIF
+#include "mif/common/base64.h"
+#include "mif/common/number.h"
+#include "mif/common/static_string.h"
+#include "mif/common/types.h"
+#include "mif/common/unused.h"
+#include "mif/reflection/reflection.h"
+#include "mif/serialization/estimate_size.h"
+#include "mif/serialization/json_traits.h"
+#include "mif/serialization/traits.h"
+
+// The writer makes the same json as Json::Serialize, but it walks the reflection metadata
+// and puts the text straight into the buffer without building the json document. The
+// numbers are written in the shortest form which is read back to the same value.
+
+namespace Mif
+{
+    namespace Serialization
+    {
+        namespace Json
+        {
+            namespace Detail
+            {
+                namespace Tag
+                {
+
+                    using Id = MIF_STATIC_STR("id");
+                    using Value = MIF_STATIC_STR("val");
+
+                }   // namespace Tag
+
+                // Formats the double into the data in the shortest of the 15 and 17 digits forms
+                // which is read back to the same value. The decimal point of the global locale
+                // is replaced by '.', so the json does not depend on it. Returns the length.
+                inline std::size_t FormatDouble(double value, char (&data)[32])
+                {
+                    auto format = [&value, &data] (int precision)
+                        {
+                            auto const length = std::snprintf(data, sizeof(data), "%.*g", precision, value);
+                            auto const *end = data + (length > 0 ? length : 0);
+                            auto *pos = data;
+                            for (auto const *i = data ; i != end ; )
+                            {
+                                auto const ch = *i;
+                                if ((ch >= '0' && ch <= '9') || ch == '-' || ch == '+' || ch == 'e')
+                                {
+                                    *pos++ = *i++;
+                                    continue;
+                                }
+                                *pos++ = '.';
+                                while (i != end && !(*i >= '0' && *i <= '9') && *i != 'e')
+                                    ++i;
+                            }
+                            return static_cast<std::size_t>(pos - data);
+                        };
+
+                    auto const length = format(15);
+                    double parsed = 0;
+                    if (Common::Number::ParseDouble(data, data + length, parsed) == data + length && parsed == value)
+                        return length;
+
+                    return format(17);
+                }
+
+                class StreamWriter final
+                {
+                public:
+                    StreamWriter(Common::Buffer &buffer)
+                        : m_buffer(buffer)
+                    {
+                    }
+
+                    void WriteRaw(char const *data, std::size_t size)
+                    {
+                        m_buffer.insert(std::end(m_buffer), data, data + size);
+                    }
+
+                    void WriteRaw(std::string const &data)
+                    {
+                        WriteRaw(data.data(), data.size());
+                    }
+
+                    void WriteChar(char ch)
+                    {
+                        m_buffer.push_back(ch);
+                    }
+
+                    template <typename TIterator>
+                    void WriteBase64(TIterator first, TIterator last)
+                    {
+                        WriteChar('"');
+                        Common::Base64::Encode(first, last, m_buffer);
+                        WriteChar('"');
+                    }
+
+                    void WriteNull()
+                    {
+                        WriteRaw("null", 4);
+                    }
+
+                    void WriteBool(bool value)
+                    {
+                        if (value)
+                            WriteRaw("true", 4);
+                        else
+                            WriteRaw("false", 5);
+                    }
+
+                    void WriteUInt(std::uint64_t value)
+                    {
+                        char data[20];
+                        auto *end = data + sizeof(data);
+                        auto *pos = end;
+                        do
+                        {
+                            *--pos = static_cast<char>('0' + value % 10);
+                            value /= 10;
+                        }
+                        while (value);
+                        WriteRaw(pos, static_cast<std::size_t>(end - pos));
+                    }
+
+                    void WriteInt(std::int64_t value)
+                    {
+                        if (value < 0)
+                        {
+                            WriteChar('-');
+                            WriteUInt(~static_cast<std::uint64_t>(value) + 1);
+                        }
+                        else
+                        {
+                            WriteUInt(static_cast<std::uint64_t>(value));
+                        }
+                    }
+
+                    void WriteDouble(double value)
+                    {
+                        // The same as boost::json does for the values which have no json form.
+                        if (std::isnan(value))
+                        {
+                            WriteNull();
+                            return;
+                        }
+                        if (std::isinf(value))
+                        {
+                            WriteRaw(value < 0 ? "-1e99999" : "1e99999", value < 0 ? 8 : 7);
+                            return;
+                        }
+
+                        // The whole numbers below 1e15 have the same form as printf gives them.
+                        if (std::fabs(value) < 1e15 && value == std::trunc(value) &&
+                                !(value == 0 && std::signbit(value)))
+                        {
+                            WriteInt(static_cast<std::int64_t>(value));
+                            return;
+                        }
+
+                        char data[32];
+                        WriteRaw(data, FormatDouble(value, data));
+                    }
+
+                    void WriteString(char const *data, std::size_t size)
+                    {
+                        static char const hex[] = "0123456789abcdef";
+
+                        WriteChar('"');
+
+                        auto const *begin = data;
+                        auto const *end = data + size;
+                        for (auto const *i = begin ; i != end ; ++i)
+                        {
+                            auto const ch = static_cast<unsigned char>(*i);
+                            if (ch >= 0x20 && ch != '"' && ch != '\\')
+                                continue;
+
+                            WriteRaw(begin, static_cast<std::size_t>(i - begin));
+                            begin = i + 1;
+
+                            switch (ch)
+                            {
+                            case '"' :
+                                WriteRaw("\\\"", 2);
+                                break;
+                            case '\\' :
+                                WriteRaw("\\\\", 2);
+                                break;
+                            case '\b' :
+                                WriteRaw("\\b", 2);
+                                break;
+                            case '\f' :
+                                WriteRaw("\\f", 2);
+                                break;
+                            case '\n' :
+                                WriteRaw("\\n", 2);
+                                break;
+                            case '\r' :
+                                WriteRaw("\\r", 2);
+                                break;
+                            case '\t' :
+                                WriteRaw("\\t", 2);
+                                break;
+                            default :
+                                {
+                                    char const escaped[] = {'\\', 'u', '0', '0', hex[ch >> 4], hex[ch & 0x0F]};
+                                    WriteRaw(escaped, sizeof(escaped));
+                                }
+                                break;
+                            }
+                        }
+
+                        WriteRaw(begin, static_cast<std::size_t>(end - begin));
+                        WriteChar('"');
+                    }
+
+                    void WriteString(std::string const &value)
+                    {
+                        WriteString(value.data(), value.size());
+                    }
+
+                private:
+                    Common::Buffer &m_buffer;
+                };
+
+                // The key of an object member with the quotes and the colon. It is made once per name.
+                template <typename TName>
+                struct StreamKey final
+                {
+                    static std::string const& Get()
+                    {
+                        static std::string const key = Make();
+                        return key;
+                    }
+
+                private:
+                    static std::string Make()
+                    {
+                        Common::Buffer buffer;
+                        StreamWriter writer{buffer};
+                        writer.WriteString(TName::Value, std::char_traits<char>::length(TName::Value));
+                        writer.WriteChar(':');
+                        return {buffer.data(), buffer.size()};
+                    }
+                };
+
+                //--------------------------------------------------------------------------------------------------------------------------
+
+                template <typename T>
+                typename std::enable_if<std::is_same<T, bool>::value, void>::type
+                WriteValue(StreamWriter &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value && std::is_signed<T>::value, void>::type
+                WriteValue(StreamWriter &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value && std::is_unsigned<T>::value, void>::type
+                WriteValue(StreamWriter &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if<std::is_floating_point<T>::value, void>::type
+                WriteValue(StreamWriter &writer, T const &object);
+
+                inline void WriteValue(StreamWriter &writer, std::string const &object);
+
+                template <typename T>
+                typename std::enable_if<!Reflection::IsReflectable<T>() && std::is_enum<T>::value, void>::type
+                WriteValue(StreamWriter &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if<Reflection::IsReflectable<T>() && std::is_enum<T>::value, void>::type
+                WriteValue(StreamWriter &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if<Reflection::IsReflectable<T>() && !std::is_enum<T>::value, void>::type
+                WriteValue(StreamWriter &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if<Traits::IsSmartPointer<T>(), void>::type
+                WriteValue(StreamWriter &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if<Traits::IsOptional<T>(), void>::type
+                WriteValue(StreamWriter &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() &&
+                            !std::is_same<typename std::decay<typename T::value_type>::type, char>::value &&
+                            !IsObjectMap<T>(),
+                        void
+                    >::type
+                WriteValue(StreamWriter &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if<IsObjectMap<T>(), void>::type
+                WriteValue(StreamWriter &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() &&
+                            std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                        void
+                    >::type
+                WriteValue(StreamWriter &writer, T const &object);
+
+                template <typename ... T>
+                void WriteValue(StreamWriter &writer, std::tuple<T ... > const &object);
+
+                template <typename TFirst, typename TSecond>
+                void WriteValue(StreamWriter &writer, std::pair<TFirst, TSecond> const &object);
+
+                template <typename TBases, std::size_t I, typename T>
+                typename std::enable_if<I != std::tuple_size<TBases>::value, void>::type
+                WriteBases(StreamWriter &writer, T const &object, bool &first);
+
+                template <typename TBases, std::size_t I, typename T>
+                typename std::enable_if<I == std::tuple_size<TBases>::value, void>::type
+                WriteBases(StreamWriter &writer, T const &object, bool &first);
+
+                template <std::size_t I, std::size_t N, typename T>
+                typename std::enable_if<I != N, void>::type
+                WriteFields(StreamWriter &writer, T const &object, bool &first);
+
+                template <std::size_t I, std::size_t N, typename T>
+                typename std::enable_if<I == N, void>::type
+                WriteFields(StreamWriter &writer, T const &object, bool &first);
+
+                template <std::size_t I, std::size_t N, typename T>
+                typename std::enable_if<I != N, void>::type
+                WriteItems(StreamWriter &writer, T const &object);
+
+                template <std::size_t I, std::size_t N, typename T>
+                typename std::enable_if<I == N, void>::type
+                WriteItems(StreamWriter &writer, T const &object);
+
+                //--------------------------------------------------------------------------------------------------------------------------
+
+                template <typename T>
+                inline typename std::enable_if<std::is_pointer<T>::value, void>::type
+                WriteValue(StreamWriter &, T const &)
+                {
+                    static_assert(!std::is_pointer<T>::value, "[Mif::Serialization::Json::Detail] You can't serialize the raw pointers.");
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_same<T, bool>::value, void>::type
+                WriteValue(StreamWriter &writer, T const &object)
+                {
+                    writer.WriteBool(object);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value && std::is_signed<T>::value, void>::type
+                WriteValue(StreamWriter &writer, T const &object)
+                {
+                    writer.WriteInt(object);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value && std::is_unsigned<T>::value, void>::type
+                WriteValue(StreamWriter &writer, T const &object)
+                {
+                    writer.WriteUInt(object);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_floating_point<T>::value, void>::type
+                WriteValue(StreamWriter &writer, T const &object)
+                {
+                    writer.WriteDouble(static_cast<double>(object));
+                }
+
+                inline void WriteValue(StreamWriter &writer, std::string const &object)
+                {
+                    writer.WriteString(object);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<!Reflection::IsReflectable<T>() && std::is_enum<T>::value, void>::type
+                WriteValue(StreamWriter &writer, T const &object)
+                {
+                    WriteValue(writer, static_cast<typename std::underlying_type<T>::type>(object));
+                }
+
+                template <typename T>
+                inline typename std::enable_if<Reflection::IsReflectable<T>() && std::is_enum<T>::value, void>::type
+                WriteValue(StreamWriter &writer, T const &object)
+                {
+                    writer.WriteString(Reflection::ToString(object));
+                }
+
+                template <typename T>
+                inline typename std::enable_if<Reflection::IsReflectable<T>() && !std::is_enum<T>::value, void>::type
+                WriteValue(StreamWriter &writer, T const &object)
+                {
+                    using Meta = Reflection::Reflect<T>;
+                    bool first = true;
+                    writer.WriteChar('{');
+                    WriteBases<typename Meta::Base, 0>(writer, object, first);
+                    WriteFields<0, Meta::Fields::Count>(writer, object, first);
+                    writer.WriteChar('}');
+                }
+
+                template <typename T>
+                inline typename std::enable_if<Traits::IsSmartPointer<T>(), void>::type
+                WriteValue(StreamWriter &writer, T const &object)
+                {
+                    if (object)
+                        WriteValue(writer, *object);
+                    else
+                        writer.WriteNull();
+                }
+
+                template <typename T>
+                inline typename std::enable_if<Traits::IsOptional<T>(), void>::type
+                WriteValue(StreamWriter &writer, T const &object)
+                {
+                    if (object)
+                        WriteValue(writer, *object);
+                    else
+                        writer.WriteNull();
+                }
+
+                template <typename T>
+                inline typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() &&
+                            !std::is_same<typename std::decay<typename T::value_type>::type, char>::value &&
+                            !IsObjectMap<T>(),
+                        void
+                    >::type
+                WriteValue(StreamWriter &writer, T const &object)
+                {
+                    writer.WriteChar('[');
+                    bool first = true;
+                    for (auto const &i : object)
+                    {
+                        if (!first)
+                            writer.WriteChar(',');
+                        first = false;
+                        WriteValue(writer, i);
+                    }
+                    writer.WriteChar(']');
+                }
+
+                inline void WriteKey(StreamWriter &writer, std::string const &key)
+                {
+                    writer.WriteString(key);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_integral<T>::value, void>::type
+                WriteKey(StreamWriter &writer, T const &key)
+                {
+                    writer.WriteChar('"');
+                    WriteValue(writer, key);
+                    writer.WriteChar('"');
+                }
+
+                template <typename T>
+                inline typename std::enable_if<IsObjectMap<T>(), void>::type
+                WriteValue(StreamWriter &writer, T const &object)
+                {
+                    writer.WriteChar('{');
+                    bool first = true;
+                    for (auto const &i : object)
+                    {
+                        if (!first)
+                            writer.WriteChar(',');
+                        first = false;
+                        WriteKey(writer, i.first);
+                        writer.WriteChar(':');
+                        WriteValue(writer, i.second);
+                    }
+                    writer.WriteChar('}');
+                }
+
+                // The bytes are written as one string of hex pairs in the array or as a base64 string
+                // if BlobAsBase64 is specialized for the type. Json::Serialize does the same.
+                template <typename T>
+                inline typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() &&
+                            std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                        void
+                    >::type
+                WriteValue(StreamWriter &writer, T const &object)
+                {
+                    if (BlobAsBase64<T>::value)
+                    {
+                        writer.WriteBase64(std::begin(object), std::end(object));
+                        return;
+                    }
+
+                    static char const hex[] = "0123456789abcdef";
+                    writer.WriteRaw("[\"", 2);
+                    for (auto const &i : object)
+                    {
+                        auto const ch = static_cast<unsigned char>(i);
+                        char const item[] = {hex[ch >> 4], hex[ch & 0x0F], ' '};
+                        writer.WriteRaw(item, sizeof(item));
+                    }
+                    writer.WriteRaw("\"]", 2);
+                }
+
+                template <typename ... T>
+                inline void WriteValue(StreamWriter &writer, std::tuple<T ... > const &object)
+                {
+                    writer.WriteChar('[');
+                    WriteItems<0, sizeof ... (T)>(writer, object);
+                    writer.WriteChar(']');
+                }
+
+                template <typename TFirst, typename TSecond>
+                inline void WriteValue(StreamWriter &writer, std::pair<TFirst, TSecond> const &object)
+                {
+                    writer.WriteChar('{');
+                    writer.WriteRaw(StreamKey<Tag::Id>::Get());
+                    WriteValue(writer, object.first);
+                    writer.WriteChar(',');
+                    writer.WriteRaw(StreamKey<Tag::Value>::Get());
+                    WriteValue(writer, object.second);
+                    writer.WriteChar('}');
+                }
+
+                template <typename TBases, std::size_t I, typename T>
+                inline typename std::enable_if<I != std::tuple_size<TBases>::value, void>::type
+                WriteBases(StreamWriter &writer, T const &object, bool &first)
+                {
+                    using Base = typename std::tuple_element<I, TBases>::type;
+                    if (!first)
+                        writer.WriteChar(',');
+                    first = false;
+                    writer.WriteRaw(StreamKey<typename Reflection::Reflect<Base>::Name>::Get());
+                    WriteValue(writer, static_cast<Base const &>(object));
+                    WriteBases<TBases, I + 1>(writer, object, first);
+                }
+
+                template <typename TBases, std::size_t I, typename T>
+                inline typename std::enable_if<I == std::tuple_size<TBases>::value, void>::type
+                WriteBases(StreamWriter &writer, T const &object, bool &first)
+                {
+                    Common::Unused(writer, object, first);
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I != N, void>::type
+                WriteFields(StreamWriter &writer, T const &object, bool &first)
+                {
+                    using Field = typename Reflection::Reflect<T>::Fields::template Field<I>;
+                    if (!first)
+                        writer.WriteChar(',');
+                    first = false;
+                    writer.WriteRaw(StreamKey<typename Field::Name>::Get());
+                    WriteValue(writer, object.*Field::Access());
+                    WriteFields<I + 1, N>(writer, object, first);
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I == N, void>::type
+                WriteFields(StreamWriter &writer, T const &object, bool &first)
+                {
+                    Common::Unused(writer, object, first);
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I != N, void>::type
+                WriteItems(StreamWriter &writer, T const &object)
+                {
+                    if (I)
+                        writer.WriteChar(',');
+                    WriteValue(writer, std::get<I>(object));
+                    WriteItems<I + 1, N>(writer, object);
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I == N, void>::type
+                WriteItems(StreamWriter &writer, T const &object)
+                {
+                    Common::Unused(writer, object);
+                }
+
+            }   // namespace Detail
+
+            template <typename T>
+            inline void Write(T const &object, Common::Buffer &buffer)
+            {
+                Serialization::Reserve<Estimate::Json>(buffer, object);
+                Detail::StreamWriter writer{buffer};
+                Detail::WriteValue(writer, object);
+            }
+
+            template <typename T>
+            inline Common::Buffer Write(T const &object)
+            {
+                Common::Buffer buffer;
+                Write(object, buffer);
+                return buffer;
+            }
+
+        }   // namespace Json
+    }   // namespace Serialization
+}   // namespace Mif
+
+#endif  // !__MIF_SERIALIZATION_JSON_WRITER_H__
@@ -0,0 +1,1246 @@
+//-------------------------------------------------------------------
+//  MetaInfo Framework (MIF)
+//  https://github.com/tdv/mif
+//  Created:     10.2026
+//  Copyright (C) 2016-2024 tdv
+//-------------------------------------------------------------------
+
+#ifndef __MIF_SERIALIZATION_MSGPACK_H__
+#define __MIF_SERIALIZATION_MSGPACK_H__
+
+// STD
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// MIF
+#include "mif/common/types.h"
+#include "mif/common/unused.h"
+#include "mif/reflection/field_table.h"
+#include "mif/reflection/reflection.h"
+#include "mif/serialization/estimate_size.h"
+#include "mif/serialization/traits.h"
+
+// MessagePack (https://msgpack.org) made from the reflection metadata. The data has the
+// same shape as the json of Json::Serialize, so any msgpack library can read it:
+//  - structures are maps of the field names to the values, the bases are nested maps
+//    under the names of the bases;
+//  - reflected enums are strings with the names of the items, other enums are integers;
+//  - containers of char are bin, other containers are arrays, maps are msgpack maps;
+//  - tuples, std::array and pairs are arrays;
+//  - empty smart pointers and optional values are nil.
+// The reader skips the unknown fields and leaves the missing ones with their defaults.
+
+namespace Mif
+{
+    namespace Serialization
+    {
+        namespace MsgPack
+        {
+            namespace Detail
+            {
+                namespace Format
+                {
+
+                    static constexpr std::uint8_t PositiveFixInt = 0x00;
+                    static constexpr std::uint8_t FixMap = 0x80;
+                    static constexpr std::uint8_t FixArray = 0x90;
+                    static constexpr std::uint8_t FixStr = 0xa0;
+                    static constexpr std::uint8_t Nil = 0xc0;
+                    static constexpr std::uint8_t False = 0xc2;
+                    static constexpr std::uint8_t True = 0xc3;
+                    static constexpr std::uint8_t Bin8 = 0xc4;
+                    static constexpr std::uint8_t Bin16 = 0xc5;
+                    static constexpr std::uint8_t Bin32 = 0xc6;
+                    static constexpr std::uint8_t Ext8 = 0xc7;
+                    static constexpr std::uint8_t Ext16 = 0xc8;
+                    static constexpr std::uint8_t Ext32 = 0xc9;
+                    static constexpr std::uint8_t Float32 = 0xca;
+                    static constexpr std::uint8_t Float64 = 0xcb;
+                    static constexpr std::uint8_t UInt8 = 0xcc;
+                    static constexpr std::uint8_t UInt16 = 0xcd;
+                    static constexpr std::uint8_t UInt32 = 0xce;
+                    static constexpr std::uint8_t UInt64 = 0xcf;
+                    static constexpr std::uint8_t Int8 = 0xd0;
+                    static constexpr std::uint8_t Int16 = 0xd1;
+                    static constexpr std::uint8_t Int32 = 0xd2;
+                    static constexpr std::uint8_t Int64 = 0xd3;
+                    static constexpr std::uint8_t FixExt1 = 0xd4;
+                    static constexpr std::uint8_t FixExt16 = 0xd8;
+                    static constexpr std::uint8_t Str8 = 0xd9;
+                    static constexpr std::uint8_t Str16 = 0xda;
+                    static constexpr std::uint8_t Str32 = 0xdb;
+                    static constexpr std::uint8_t Array16 = 0xdc;
+                    static constexpr std::uint8_t Array32 = 0xdd;
+                    static constexpr std::uint8_t Map16 = 0xde;
+                    static constexpr std::uint8_t Map32 = 0xdf;
+                    static constexpr std::uint8_t NegativeFixInt = 0xe0;
+
+                }   // namespace Format
+
+                class Writer final
+                {
+                public:
+                    Writer(Common::Buffer &buffer)
+                        : m_buffer(buffer)
+                    {
+                    }
+
+                    void WriteNil()
+                    {
+                        WriteByte(Format::Nil);
+                    }
+
+                    void WriteBool(bool value)
+                    {
+                        WriteByte(value ? Format::True : Format::False);
+                    }
+
+                    void WriteUInt(std::uint64_t value)
+                    {
+                        if (value < 0x80)
+                            WriteByte(static_cast<std::uint8_t>(value));
+                        else if (value <= 0xFF)
+                            WriteHeader(Format::UInt8, value, 1);
+                        else if (value <= 0xFFFF)
+                            WriteHeader(Format::UInt16, value, 2);
+                        else if (value <= 0xFFFFFFFF)
+                            WriteHeader(Format::UInt32, value, 4);
+                        else
+                            WriteHeader(Format::UInt64, value, 8);
+                    }
+
+                    void WriteInt(std::int64_t value)
+                    {
+                        if (value >= 0)
+                            WriteUInt(static_cast<std::uint64_t>(value));
+                        else if (value >= -32)
+                            WriteByte(static_cast<std::uint8_t>(value));
+                        else if (value >= std::numeric_limits<std::int8_t>::min())
+                            WriteHeader(Format::Int8, static_cast<std::uint64_t>(value), 1);
+                        else if (value >= std::numeric_limits<std::int16_t>::min())
+                            WriteHeader(Format::Int16, static_cast<std::uint64_t>(value), 2);
+                        else if (value >= std::numeric_limits<std::int32_t>::min())
+                            WriteHeader(Format::Int32, static_cast<std::uint64_t>(value), 4);
+                        else
+                            WriteHeader(Format::Int64, static_cast<std::uint64_t>(value), 8);
+                    }
+
+                    void WriteFloat(float value)
+                    {
+                        std::uint32_t bits = 0;
+                        std::memcpy(&bits, &value, sizeof(bits));
+                        WriteHeader(Format::Float32, bits, 4);
+                    }
+
+                    void WriteDouble(double value)
+                    {
+                        std::uint64_t bits = 0;
+                        std::memcpy(&bits, &value, sizeof(bits));
+                        WriteHeader(Format::Float64, bits, 8);
+                    }
+
+                    void WriteString(char const *data, std::size_t size)
+                    {
+                        if (size < 32)
+                            WriteByte(static_cast<std::uint8_t>(Format::FixStr | size));
+                        else if (size <= 0xFF)
+                            WriteHeader(Format::Str8, size, 1);
+                        else if (size <= 0xFFFF)
+                            WriteHeader(Format::Str16, size, 2);
+                        else
+                            WriteHeader(Format::Str32, size, 4);
+                        m_buffer.insert(std::end(m_buffer), data, data + size);
+                    }
+
+                    void WriteBinHeader(std::size_t size)
+                    {
+                        if (size <= 0xFF)
+                            WriteHeader(Format::Bin8, size, 1);
+                        else if (size <= 0xFFFF)
+                            WriteHeader(Format::Bin16, size, 2);
+                        else
+                            WriteHeader(Format::Bin32, size, 4);
+                    }
+
+                    void WriteArrayHeader(std::size_t size)
+                    {
+                        if (size < 16)
+                            WriteByte(static_cast<std::uint8_t>(Format::FixArray | size));
+                        else if (size <= 0xFFFF)
+                            WriteHeader(Format::Array16, size, 2);
+                        else
+                            WriteHeader(Format::Array32, size, 4);
+                    }
+
+                    void WriteMapHeader(std::size_t size)
+                    {
+                        if (size < 16)
+                            WriteByte(static_cast<std::uint8_t>(Format::FixMap | size));
+                        else if (size <= 0xFFFF)
+                            WriteHeader(Format::Map16, size, 2);
+                        else
+                            WriteHeader(Format::Map32, size, 4);
+                    }
+
+                    template <typename TIterator>
+                    void WriteRange(TIterator begin, TIterator end)
+                    {
+                        m_buffer.insert(std::end(m_buffer), begin, end);
+                    }
+
+                private:
+                    Common::Buffer &m_buffer;
+
+                    void WriteByte(std::uint8_t value)
+                    {
+                        m_buffer.push_back(static_cast<char>(value));
+                    }
+
+                    // Type byte and the big-endian value.
+                    void WriteHeader(std::uint8_t type, std::uint64_t value, std::size_t size)
+                    {
+                        char data[1 + sizeof(value)];
+                        data[0] = static_cast<char>(type);
+                        for (std::size_t i = 0 ; i < size ; ++i)
+                            data[size - i] = static_cast<char>((value >> (i * 8)) & 0xFF);
+                        m_buffer.insert(std::end(m_buffer), data, data + 1 + size);
+                    }
+                };
+
+                class Reader final
+                {
+                public:
+                    struct Integer
+                    {
+                        bool isNegative = false;
+                        // Two's complement for the negative values.
+                        std::uint64_t value = 0;
+                    };
+
+                    Reader(char const *begin, char const *end)
+                        : m_pos{begin}
+                        , m_end{end}
+                    {
+                    }
+
+                    std::uint8_t Peek() const
+                    {
+                        Check(1);
+                        return static_cast<std::uint8_t>(*m_pos);
+                    }
+
+                    bool TryNil()
+                    {
+                        if (Peek() != Format::Nil)
+                            return false;
+                        ++m_pos;
+                        return true;
+                    }
+
+                    bool IsBool() const
+                    {
+                        auto const type = Peek();
+                        return type == Format::False || type == Format::True;
+                    }
+
+                    bool IsInteger() const
+                    {
+                        auto const type = Peek();
+                        return type < 0x80 || type >= Format::NegativeFixInt ||
+                                (type >= Format::UInt8 && type <= Format::Int64);
+                    }
+
+                    bool IsString() const
+                    {
+                        auto const type = Peek();
+                        return (type & 0xE0) == Format::FixStr || (type >= Format::Str8 && type <= Format::Str32);
+                    }
+
+                    bool ReadBool()
+                    {
+                        switch (ReadByte())
+                        {
+                        case Format::False :
+                            return false;
+                        case Format::True :
+                            return true;
+                        default :
+                            break;
+                        }
+                        Fail("Expected bool.");
+                    }
+
+                    Integer ReadInteger()
+                    {
+                        Integer integer;
+                        auto const type = ReadByte();
+                        if (type < 0x80)
+                        {
+                            integer.value = type;
+                            return integer;
+                        }
+                        if (type >= Format::NegativeFixInt)
+                        {
+                            integer.isNegative = true;
+                            integer.value = static_cast<std::uint64_t>(static_cast<std::int8_t>(type));
+                            return integer;
+                        }
+
+                        switch (type)
+                        {
+                        case Format::UInt8 :
+                            integer.value = ReadFixed(1);
+                            break;
+                        case Format::UInt16 :
+                            integer.value = ReadFixed(2);
+                            break;
+                        case Format::UInt32 :
+                            integer.value = ReadFixed(4);
+                            break;
+                        case Format::UInt64 :
+                            integer.value = ReadFixed(8);
+                            break;
+                        case Format::Int8 :
+                            integer.value = static_cast<std::uint64_t>(static_cast<std::int8_t>(ReadFixed(1)));
+                            break;
+                        case Format::Int16 :
+                            integer.value = static_cast<std::uint64_t>(static_cast<std::int16_t>(ReadFixed(2)));
+                            break;
+                        case Format::Int32 :
+                            integer.value = static_cast<std::uint64_t>(static_cast<std::int32_t>(ReadFixed(4)));
+                            break;
+                        case Format::Int64 :
+                            integer.value = ReadFixed(8);
+                            break;
+                        default :
+                            Fail("Expected integer.");
+                        }
+
+                        integer.isNegative = type >= Format::Int8 && static_cast<std::int64_t>(integer.value) < 0;
+                        return integer;
+                    }
+
+                    // Any number is taken.
+                    double ReadDouble()
+                    {
+                        auto const type = Peek();
+                        if (type == Format::Float32)
+                        {
+                            ++m_pos;
+                            auto const bits = static_cast<std::uint32_t>(ReadFixed(4));
+                            float value = 0;
+                            std::memcpy(&value, &bits, sizeof(value));
+                            return value;
+                        }
+                        if (type == Format::Float64)
+                        {
+                            ++m_pos;
+                            auto const bits = ReadFixed(8);
+                            double value = 0;
+                            std::memcpy(&value, &bits, sizeof(value));
+                            return value;
+                        }
+                        auto const integer = ReadInteger();
+                        return integer.isNegative ?
+                                static_cast<double>(static_cast<std::int64_t>(integer.value)) :
+                                static_cast<double>(integer.value);
+                    }
+
+                    // Returns the size of the string and moves the position to its end.
+                    std::size_t ReadString(char const *&data)
+                    {
+                        auto const type = ReadByte();
+                        std::size_t size = 0;
+                        if ((type & 0xE0) == Format::FixStr)
+                            size = type & 0x1F;
+                        else if (type == Format::Str8)
+                            size = ReadFixed(1);
+                        else if (type == Format::Str16)
+                            size = ReadFixed(2);
+                        else if (type == Format::Str32)
+                            size = ReadFixed(4);
+                        else
+                            Fail("Expected string.");
+                        return ReadData(data, size);
+                    }
+
+                    // The strings are taken as bin too.
+                    std::size_t ReadBin(char const *&data)
+                    {
+                        std::size_t size = 0;
+                        switch (Peek())
+                        {
+                        case Format::Bin8 :
+                            ++m_pos;
+                            size = ReadFixed(1);
+                            break;
+                        case Format::Bin16 :
+                            ++m_pos;
+                            size = ReadFixed(2);
+                            break;
+                        case Format::Bin32 :
+                            ++m_pos;
+                            size = ReadFixed(4);
+                            break;
+                        default :
+                            return ReadString(data);
+                        }
+                        return ReadData(data, size);
+                    }
+
+                    std::size_t ReadArrayHeader()
+                    {
+                        auto const type = ReadByte();
+                        std::size_t size = 0;
+                        if ((type & 0xF0) == Format::FixArray)
+                            size = type & 0x0F;
+                        else if (type == Format::Array16)
+                            size = ReadFixed(2);
+                        else if (type == Format::Array32)
+                            size = ReadFixed(4);
+                        else
+                            Fail("Expected array.");
+                        return CheckCount(size);
+                    }
+
+                    std::size_t ReadMapHeader()
+                    {
+                        auto const type = ReadByte();
+                        std::size_t size = 0;
+                        if ((type & 0xF0) == Format::FixMap)
+                            size = type & 0x0F;
+                        else if (type == Format::Map16)
+                            size = ReadFixed(2);
+                        else if (type == Format::Map32)
+                            size = ReadFixed(4);
+                        else
+                            Fail("Expected map.");
+                        CheckCount(size * 2);
+                        return size;
+                    }
+
+                    // Skips the value of any type without the recursion.
+                    void Skip()
+                    {
+                        char const *data = nullptr;
+                        for (std::uint64_t count = 1 ; count ; --count)
+                        {
+                            auto const type = Peek();
+                            if (type < 0x80 || type >= Format::NegativeFixInt || type == Format::Nil ||
+                                    type == Format::False || type == Format::True)
+                            {
+                                ++m_pos;
+                            }
+                            else if ((type & 0xF0) == Format::FixMap || type == Format::Map16 || type == Format::Map32)
+                            {
+                                count += ReadMapHeader() * 2;
+                            }
+                            else if ((type & 0xF0) == Format::FixArray || type == Format::Array16 || type == Format::Array32)
+                            {
+                                count += ReadArrayHeader();
+                            }
+                            else if (IsString() || (type >= Format::Bin8 && type <= Format::Bin32))
+                            {
+                                ReadBin(data);
+                            }
+                            else if (type >= Format::Ext8 && type <= Format::Ext32)
+                            {
+                                ++m_pos;
+                                auto const size = ReadFixed(type == Format::Ext8 ? 1 : type == Format::Ext16 ? 2 : 4);
+                                ReadData(data, static_cast<std::size_t>(size) + 1);
+                            }
+                            else if (type >= Format::FixExt1 && type <= Format::FixExt16)
+                            {
+                                ++m_pos;
+                                ReadData(data, (std::size_t{1} << (type - Format::FixExt1)) + 1);
+                            }
+                            else if (type == Format::Float32 || type == Format::Float64)
+                            {
+                                ReadDouble();
+                            }
+                            else if (type >= Format::UInt8 && type <= Format::Int64)
+                            {
+                                ReadInteger();
+                            }
+                            else
+                            {
+                                Fail("Unknown type.");
+                            }
+                        }
+                    }
+
+                    bool IsEnd() const
+                    {
+                        return m_pos == m_end;
+                    }
+
+                    char const* GetPosition() const
+                    {
+                        return m_pos;
+                    }
+
+                    [[noreturn]]
+                    void Fail(std::string const &message) const
+                    {
+                        throw std::invalid_argument{"[Mif::Serialization::MsgPack::Detail::Reader] " + message};
+                    }
+
+                private:
+                    char const *m_pos;
+                    char const *m_end;
+
+                    void Check(std::size_t size) const
+                    {
+                        if (static_cast<std::size_t>(m_end - m_pos) < size)
+                            Fail("Unexpected end of data.");
+                    }
+
+                    std::uint8_t ReadByte()
+                    {
+                        Check(1);
+                        return static_cast<std::uint8_t>(*m_pos++);
+                    }
+
+                    std::uint64_t ReadFixed(std::size_t size)
+                    {
+                        Check(size);
+                        std::uint64_t value = 0;
+                        for (std::size_t i = 0 ; i < size ; ++i)
+                            value = (value << 8) | static_cast<std::uint8_t>(m_pos[i]);
+                        m_pos += size;
+                        return value;
+                    }
+
+                    std::size_t ReadData(char const *&data, std::size_t size)
+                    {
+                        Check(size);
+                        data = m_pos;
+                        m_pos += size;
+                        return size;
+                    }
+
+                    // Each item takes one byte at least, so the bad data can't make the reader allocate a lot of memory.
+                    std::size_t CheckCount(std::size_t count) const
+                    {
+                        if (count > static_cast<std::size_t>(m_end - m_pos))
+                            Fail("Bad size.");
+                        return count;
+                    }
+                };
+
+                template <typename T>
+                struct MutableValue
+                {
+                    using Type = T;
+                };
+
+                template <typename TFirst, typename TSecond>
+                struct MutableValue<std::pair<TFirst, TSecond>>
+                {
+                    using Type = std::pair<typename std::remove_const<TFirst>::type, TSecond>;
+                };
+
+                template <std::size_t N>
+                inline bool IsKey(char const (&name)[N], char const *key, std::size_t size)
+                {
+                    return size < N && !name[size] && !std::memcmp(name, key, size);
+                }
+
+                template <typename T>
+                inline T ReadIntegerValue(Reader &reader)
+                {
+                    auto const integer = reader.ReadInteger();
+                    if (integer.isNegative)
+                    {
+                        auto const value = static_cast<std::int64_t>(integer.value);
+                        if (!std::is_signed<T>::value || value < static_cast<std::int64_t>(std::numeric_limits<T>::min()))
+                            reader.Fail("Integer is out of range.");
+                        return static_cast<T>(value);
+                    }
+                    if (integer.value > static_cast<std::uint64_t>(std::numeric_limits<T>::max()))
+                        reader.Fail("Integer is out of range.");
+                    return static_cast<T>(integer.value);
+                }
+
+                //--------------------------------------------------------------------------------------------------------------------------
+
+                template <typename T>
+                typename std::enable_if<std::is_pointer<T>::value, void>::type
+                Write(Writer &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if<std::is_same<T, bool>::value, void>::type
+                Write(Writer &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value && std::is_signed<T>::value, void>::type
+                Write(Writer &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value && std::is_unsigned<T>::value, void>::type
+                Write(Writer &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if<std::is_floating_point<T>::value, void>::type
+                Write(Writer &writer, T const &object);
+
+                inline void Write(Writer &writer, std::string const &object);
+
+                template <typename T>
+                typename std::enable_if<!Reflection::IsReflectable<T>() && std::is_enum<T>::value, void>::type
+                Write(Writer &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if<Reflection::IsReflectable<T>() && std::is_enum<T>::value, void>::type
+                Write(Writer &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if<Reflection::IsReflectable<T>() && !std::is_enum<T>::value, void>::type
+                Write(Writer &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if<Traits::IsSmartPointer<T>(), void>::type
+                Write(Writer &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if<Traits::IsOptional<T>(), void>::type
+                Write(Writer &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() && !Traits::IsMap<T>() &&
+                            !std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                        void
+                    >::type
+                Write(Writer &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() &&
+                            std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                        void
+                    >::type
+                Write(Writer &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if<Traits::IsMap<T>(), void>::type
+                Write(Writer &writer, T const &object);
+
+                template <typename T, std::size_t N>
+                void Write(Writer &writer, std::array<T, N> const &object);
+
+                template <typename TFirst, typename TSecond>
+                void Write(Writer &writer, std::pair<TFirst, TSecond> const &object);
+
+                template <typename ... T>
+                void Write(Writer &writer, std::tuple<T ... > const &object);
+
+                template <typename TBases, std::size_t I, typename T>
+                typename std::enable_if<I != std::tuple_size<TBases>::value, void>::type
+                WriteBase(Writer &writer, T const &object);
+
+                template <typename TBases, std::size_t I, typename T>
+                typename std::enable_if<I == std::tuple_size<TBases>::value, void>::type
+                WriteBase(Writer &writer, T const &object);
+
+                template <std::size_t I, std::size_t N, typename T>
+                typename std::enable_if<I != N, void>::type
+                WriteFields(Writer &writer, T const &object);
+
+                template <std::size_t I, std::size_t N, typename T>
+                typename std::enable_if<I == N, void>::type
+                WriteFields(Writer &writer, T const &object);
+
+                template <std::size_t I, std::size_t N, typename T>
+                typename std::enable_if<I != N, void>::type
+                WriteItems(Writer &writer, T const &object);
+
+                template <std::size_t I, std::size_t N, typename T>
+                typename std::enable_if<I == N, void>::type
+                WriteItems(Writer &writer, T const &object);
+
+                template <typename T>
+                typename std::enable_if<std::is_pointer<T>::value, void>::type
+                Read(Reader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if<std::is_same<T, bool>::value, void>::type
+                Read(Reader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, void>::type
+                Read(Reader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if<std::is_floating_point<T>::value, void>::type
+                Read(Reader &reader, T &object);
+
+                inline void Read(Reader &reader, std::string &object);
+
+                template <typename T>
+                typename std::enable_if<!Reflection::IsReflectable<T>() && std::is_enum<T>::value, void>::type
+                Read(Reader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if<Reflection::IsReflectable<T>() && std::is_enum<T>::value, void>::type
+                Read(Reader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if<Reflection::IsReflectable<T>() && !std::is_enum<T>::value, void>::type
+                Read(Reader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if<Traits::IsSmartPointer<T>(), void>::type
+                Read(Reader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if<Traits::IsOptional<T>(), void>::type
+                Read(Reader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() && !Traits::IsMap<T>() &&
+                            !std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                        void
+                    >::type
+                Read(Reader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() &&
+                            std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                        void
+                    >::type
+                Read(Reader &reader, T &object);
+
+                template <typename T>
+                typename std::enable_if<Traits::IsMap<T>(), void>::type
+                Read(Reader &reader, T &object);
+
+                template <typename T, std::size_t N>
+                void Read(Reader &reader, std::array<T, N> &object);
+
+                template <typename TFirst, typename TSecond>
+                void Read(Reader &reader, std::pair<TFirst, TSecond> &object);
+
+                template <typename ... T>
+                void Read(Reader &reader, std::tuple<T ... > &object);
+
+                template <typename TBases, std::size_t I, typename T>
+                typename std::enable_if<I != std::tuple_size<TBases>::value, bool>::type
+                ReadBase(Reader &reader, T &object, char const *key, std::size_t size);
+
+                template <typename TBases, std::size_t I, typename T>
+                typename std::enable_if<I == std::tuple_size<TBases>::value, bool>::type
+                ReadBase(Reader &reader, T &object, char const *key, std::size_t size);
+
+                template <typename T>
+                bool ReadField(Reader &reader, T &object, char const *key, std::size_t size);
+
+                template <std::size_t I, std::size_t N, typename T>
+                typename std::enable_if<I != N, void>::type
+                ReadItems(Reader &reader, T &object);
+
+                template <std::size_t I, std::size_t N, typename T>
+                typename std::enable_if<I == N, void>::type
+                ReadItems(Reader &reader, T &object);
+
+                //--------------------------------------------------------------------------------------------------------------------------
+
+                template <typename T>
+                inline typename std::enable_if<std::is_pointer<T>::value, void>::type
+                Write(Writer &, T const &)
+                {
+                    static_assert(!std::is_pointer<T>::value, "[Mif::Serialization::MsgPack::Detail] You can't serialize the raw pointers.");
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_same<T, bool>::value, void>::type
+                Write(Writer &writer, T const &object)
+                {
+                    writer.WriteBool(object);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value && std::is_signed<T>::value, void>::type
+                Write(Writer &writer, T const &object)
+                {
+                    writer.WriteInt(object);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value && std::is_unsigned<T>::value, void>::type
+                Write(Writer &writer, T const &object)
+                {
+                    writer.WriteUInt(object);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_floating_point<T>::value, void>::type
+                Write(Writer &writer, T const &object)
+                {
+                    if (std::is_same<T, float>::value)
+                        writer.WriteFloat(static_cast<float>(object));
+                    else
+                        writer.WriteDouble(static_cast<double>(object));
+                }
+
+                inline void Write(Writer &writer, std::string const &object)
+                {
+                    writer.WriteString(object.data(), object.size());
+                }
+
+                template <typename T>
+                inline typename std::enable_if<!Reflection::IsReflectable<T>() && std::is_enum<T>::value, void>::type
+                Write(Writer &writer, T const &object)
+                {
+                    Write(writer, static_cast<typename std::underlying_type<T>::type>(object));
+                }
+
+                template <typename T>
+                inline typename std::enable_if<Reflection::IsReflectable<T>() && std::is_enum<T>::value, void>::type
+                Write(Writer &writer, T const &object)
+                {
+                    Write(writer, Reflection::ToString(object));
+                }
+
+                template <typename T>
+                inline typename std::enable_if<Reflection::IsReflectable<T>() && !std::is_enum<T>::value, void>::type
+                Write(Writer &writer, T const &object)
+                {
+                    using Meta = Reflection::Reflect<T>;
+                    using Bases = typename Meta::Base;
+                    writer.WriteMapHeader(std::tuple_size<Bases>::value + Meta::Fields::Count);
+                    WriteBase<Bases, 0>(writer, object);
+                    WriteFields<0, Meta::Fields::Count>(writer, object);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<Traits::IsSmartPointer<T>(), void>::type
+                Write(Writer &writer, T const &object)
+                {
+                    if (object)
+                        Write(writer, *object);
+                    else
+                        writer.WriteNil();
+                }
+
+                template <typename T>
+                inline typename std::enable_if<Traits::IsOptional<T>(), void>::type
+                Write(Writer &writer, T const &object)
+                {
+                    if (object)
+                        Write(writer, *object);
+                    else
+                        writer.WriteNil();
+                }
+
+                template <typename T>
+                inline typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() && !Traits::IsMap<T>() &&
+                            !std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                        void
+                    >::type
+                Write(Writer &writer, T const &object)
+                {
+                    writer.WriteArrayHeader(static_cast<std::size_t>(std::distance(std::begin(object), std::end(object))));
+                    for (auto const &i : object)
+                        Write(writer, i);
+                }
+
+                template <typename T>
+                inline typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() &&
+                            std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                        void
+                    >::type
+                Write(Writer &writer, T const &object)
+                {
+                    writer.WriteBinHeader(static_cast<std::size_t>(std::distance(std::begin(object), std::end(object))));
+                    writer.WriteRange(std::begin(object), std::end(object));
+                }
+
+                template <typename T>
+                inline typename std::enable_if<Traits::IsMap<T>(), void>::type
+                Write(Writer &writer, T const &object)
+                {
+                    writer.WriteMapHeader(object.size());
+                    for (auto const &i : object)
+                    {
+                        Write(writer, i.first);
+                        Write(writer, i.second);
+                    }
+                }
+
+                template <typename T, std::size_t N>
+                inline void Write(Writer &writer, std::array<T, N> const &object)
+                {
+                    writer.WriteArrayHeader(N);
+                    WriteItems<0, N>(writer, object);
+                }
+
+                template <typename TFirst, typename TSecond>
+                inline void Write(Writer &writer, std::pair<TFirst, TSecond> const &object)
+                {
+                    writer.WriteArrayHeader(2);
+                    Write(writer, object.first);
+                    Write(writer, object.second);
+                }
+
+                template <typename ... T>
+                inline void Write(Writer &writer, std::tuple<T ... > const &object)
+                {
+                    writer.WriteArrayHeader(sizeof ... (T));
+                    WriteItems<0, sizeof ... (T)>(writer, object);
+                }
+
+                template <typename TBases, std::size_t I, typename T>
+                inline typename std::enable_if<I != std::tuple_size<TBases>::value, void>::type
+                WriteBase(Writer &writer, T const &object)
+                {
+                    using Base = typename std::tuple_element<I, TBases>::type;
+                    using Name = typename Reflection::Reflect<Base>::Name;
+                    writer.WriteString(Name::Value, std::strlen(Name::Value));
+                    Write(writer, static_cast<Base const &>(object));
+                    WriteBase<TBases, I + 1>(writer, object);
+                }
+
+                template <typename TBases, std::size_t I, typename T>
+                inline typename std::enable_if<I == std::tuple_size<TBases>::value, void>::type
+                WriteBase(Writer &writer, T const &object)
+                {
+                    Common::Unused(writer, object);
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I != N, void>::type
+                WriteFields(Writer &writer, T const &object)
+                {
+                    using Field = typename Reflection::Reflect<T>::Fields::template Field<I>;
+                    writer.WriteString(Field::Name::Value, std::strlen(Field::Name::Value));
+                    Write(writer, object.*Field::Access());
+                    WriteFields<I + 1, N>(writer, object);
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I == N, void>::type
+                WriteFields(Writer &writer, T const &object)
+                {
+                    Common::Unused(writer, object);
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I != N, void>::type
+                WriteItems(Writer &writer, T const &object)
+                {
+                    Write(writer, std::get<I>(object));
+                    WriteItems<I + 1, N>(writer, object);
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I == N, void>::type
+                WriteItems(Writer &writer, T const &object)
+                {
+                    Common::Unused(writer, object);
+                }
+
+                //--------------------------------------------------------------------------------------------------------------------------
+
+                template <typename T>
+                inline typename std::enable_if<std::is_pointer<T>::value, void>::type
+                Read(Reader &, T &)
+                {
+                    static_assert(!std::is_pointer<T>::value, "[Mif::Serialization::MsgPack::Detail] You can't deserialize the raw pointers.");
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_same<T, bool>::value, void>::type
+                Read(Reader &reader, T &object)
+                {
+                    object = reader.ReadBool();
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, void>::type
+                Read(Reader &reader, T &object)
+                {
+                    object = ReadIntegerValue<T>(reader);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_floating_point<T>::value, void>::type
+                Read(Reader &reader, T &object)
+                {
+                    object = static_cast<T>(reader.ReadDouble());
+                }
+
+                inline void Read(Reader &reader, std::string &object)
+                {
+                    char const *data = nullptr;
+                    auto const size = reader.ReadString(data);
+                    object.assign(data, size);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<!Reflection::IsReflectable<T>() && std::is_enum<T>::value, void>::type
+                Read(Reader &reader, T &object)
+                {
+                    object = static_cast<T>(ReadIntegerValue<typename std::underlying_type<T>::type>(reader));
+                }
+
+                // The reflected enums are taken as the numbers too.
+                template <typename T>
+                inline typename std::enable_if<Reflection::IsReflectable<T>() && std::is_enum<T>::value, void>::type
+                Read(Reader &reader, T &object)
+                {
+                    if (reader.IsInteger())
+                    {
+                        object = static_cast<T>(ReadIntegerValue<typename std::underlying_type<T>::type>(reader));
+                        return;
+                    }
+
+                    char const *data = nullptr;
+                    auto const size = reader.ReadString(data);
+                    object = Reflection::FromString<T>(data, size);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<Reflection::IsReflectable<T>() && !std::is_enum<T>::value, void>::type
+                Read(Reader &reader, T &object)
+                {
+                    using Meta = Reflection::Reflect<T>;
+                    for (auto count = reader.ReadMapHeader() ; count ; --count)
+                    {
+                        if (!reader.IsString())
+                        {
+                            reader.Skip();
+                            reader.Skip();
+                            continue;
+                        }
+
+                        char const *key = nullptr;
+                        auto const size = reader.ReadString(key);
+                        if (!ReadBase<typename Meta::Base, 0>(reader, object, key, size) &&
+                                !ReadField(reader, object, key, size))
+                        {
+                            reader.Skip();
+                        }
+                    }
+                }
+
+                template <typename T>
+                inline typename std::enable_if<Traits::IsSmartPointer<T>(), void>::type
+                Read(Reader &reader, T &object)
+                {
+                    if (reader.TryNil())
+                    {
+                        object.reset();
+                        return;
+                    }
+
+                    using ObjectType = typename T::element_type;
+                    object.reset(new ObjectType{});
+                    Read(reader, *object);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<Traits::IsOptional<T>(), void>::type
+                Read(Reader &reader, T &object)
+                {
+                    if (reader.TryNil())
+                    {
+                        object.reset();
+                        return;
+                    }
+
+                    typename T::value_type value{};
+                    Read(reader, value);
+                    object = std::move(value);
+                }
+
+                template <typename T>
+                inline typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() && !Traits::IsMap<T>() &&
+                            !std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                        void
+                    >::type
+                Read(Reader &reader, T &object)
+                {
+                    {
+                        T tmp;
+                        std::swap(tmp, object);
+                    }
+
+                    auto inserter = std::inserter(object, std::end(object));
+                    for (auto count = reader.ReadArrayHeader() ; count ; --count)
+                    {
+                        typename MutableValue<typename T::value_type>::Type data{};
+                        Read(reader, data);
+                        *inserter = std::move(data);
+                    }
+                }
+
+                template <typename T>
+                inline typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() &&
+                            std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                        void
+                    >::type
+                Read(Reader &reader, T &object)
+                {
+                    char const *data = nullptr;
+                    auto const size = reader.ReadBin(data);
+                    object = T(data, data + size);
+                }
+
+                template <typename T>
+                inline typename std::enable_if<Traits::IsMap<T>(), void>::type
+                Read(Reader &reader, T &object)
+                {
+                    {
+                        T tmp;
+                        std::swap(tmp, object);
+                    }
+
+                    auto inserter = std::inserter(object, std::end(object));
+                    for (auto count = reader.ReadMapHeader() ; count ; --count)
+                    {
+                        typename MutableValue<typename T::value_type>::Type data{};
+                        Read(reader, data.first);
+                        Read(reader, data.second);
+                        *inserter = std::move(data);
+                    }
+                }
+
+                template <typename T, std::size_t N>
+                inline void Read(Reader &reader, std::array<T, N> &object)
+                {
+                    if (reader.ReadArrayHeader() != N)
+                        reader.Fail("Bad size of array.");
+                    ReadItems<0, N>(reader, object);
+                }
+
+                template <typename TFirst, typename TSecond>
+                inline void Read(Reader &reader, std::pair<TFirst, TSecond> &object)
+                {
+                    if (reader.ReadArrayHeader() != 2)
+                        reader.Fail("Bad size of pair.");
+                    Read(reader, const_cast<typename std::remove_const<TFirst>::type &>(object.first));
+                    Read(reader, object.second);
+                }
+
+                template <typename ... T>
+                inline void Read(Reader &reader, std::tuple<T ... > &object)
+                {
+                    if (reader.ReadArrayHeader() != sizeof ... (T))
+                        reader.Fail("Bad size of tuple.");
+                    ReadItems<0, sizeof ... (T)>(reader, object);
+                }
+
+                template <typename TBases, std::size_t I, typename T>
+                inline typename std::enable_if<I != std::tuple_size<TBases>::value, bool>::type
+                ReadBase(Reader &reader, T &object, char const *key, std::size_t size)
+                {
+                    using Base = typename std::tuple_element<I, TBases>::type;
+                    if (!IsKey(Reflection::Reflect<Base>::Name::Value, key, size))
+                        return ReadBase<TBases, I + 1>(reader, object, key, size);
+                    Read(reader, static_cast<Base &>(object));
+                    return true;
+                }
+
+                template <typename TBases, std::size_t I, typename T>
+                inline typename std::enable_if<I == std::tuple_size<TBases>::value, bool>::type
+                ReadBase(Reader &reader, T &object, char const *key, std::size_t size)
+                {
+                    Common::Unused(reader, object, key, size);
+                    return false;
+                }
+
+                struct FieldReader final
+                {
+                    Reader &reader;
+
+                    template <typename TValue>
+                    void operator () (char const *, TValue &value) const
+                    {
+                        Read(reader, value);
+                    }
+                };
+
+                template <typename T>
+                inline bool ReadField(Reader &reader, T &object, char const *key, std::size_t size)
+                {
+                    return Reflection::FieldTable<T>::Get().Visit(object, key, size, FieldReader{reader});
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I != N, void>::type
+                ReadItems(Reader &reader, T &object)
+                {
+                    Read(reader, std::get<I>(object));
+                    ReadItems<I + 1, N>(reader, object);
+                }
+
+                template <std::size_t I, std::size_t N, typename T>
+                inline typename std::enable_if<I == N, void>::type
+                ReadItems(Reader &reader, T &object)
+                {
+                    Common::Unused(reader, object);
+                }
+
+            }   // namespace Detail
+
+            template <typename T>
+            inline void Serialize(T const &object, Common::Buffer &buffer)
+            {
+                Serialization::Reserve<Estimate::MsgPack>(buffer, object);
+                Detail::Writer writer{buffer};
+                Detail::Write(writer, object);
+            }
+
+            template <typename T>
+            inline Common::Buffer Serialize(T const &object)
+            {
+                Common::Buffer buffer;
+                Serialize(object, buffer);
+                return buffer;
+            }
+
+            template <typename T>
+            inline T Deserialize(char const *data, std::size_t size)
+            {
+                Detail::Reader reader{data, data + size};
+                T object{};
+                Detail::Read(reader, object);
+                if (!reader.IsEnd())
+                    throw std::invalid_argument{"[Mif::Serialization::MsgPack::Deserialize] Unexpected data after the object."};
+                return object;
+            }
+
+            template <typename T>
+            inline T Deserialize(Common::Buffer const &buffer)
+            {
+                return Deserialize<T>(buffer.data(), buffer.size());
+            }
+
+        }   // namespace MsgPack
+    }   // namespace Serialization
+}   // namespace Mif
+
+#endif  // !__MIF_SERIALIZATION_MSGPACK_H__
@@ -0,0 +1,466 @@
+//-------------------------------------------------------------------
+//  MetaInfo Framework (MIF)
+//  https://github.com/tdv/mif
+//  Created:     10.2026
+//  Copyright (C) 2016-2024 tdv
+//-------------------------------------------------------------------
+
+#ifndef __MIF_SERIALIZATION_PATCH_H__
+#define __MIF_SERIALIZATION_PATCH_H__
+
+// STD
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+// MIF
+#include "mif/common/types.h"
+#include "mif/common/unused.h"
+#include "mif/reflection/field_table.h"
+#include "mif/reflection/hash.h"
+#include "mif/reflection/reflection.h"
+#include "mif/serialization/binary.h"
+#include "mif/serialization/json_reader.h"
+#include "mif/serialization/json_writer.h"
+#include "mif/serialization/traits.h"
+
+// The patch has only the fields which differ in two objects of the same reflected type.
+// The nested structures (the fields and the bases) are compared field by field, all other
+// values (containers, pointers and so on) are put in the patch as a whole if they differ.
+//  - The binary patch is a sequence of the entries terminated by zero. Each entry is the
+//    varint index + 1 of the base or the field (the bases go first) and either the nested
+//    patch of the structure or the value in the compact binary format.
+//  - The json patch is a json merge patch (RFC 7386) of the json made by Json::Serialize.
+//    The pointers are reset by null.
+
+namespace Mif
+{
+    namespace Serialization
+    {
+        namespace Patch
+        {
+            namespace Detail
+            {
+
+                using Reflection::Detail::Compare::IsEqual;
+                using Reflection::Detail::Compare::IsStruct;
+
+                //--------------------------------------------------------------------------------------------------------------------------
+
+                namespace Binary
+                {
+
+                    using Serialization::Binary::Detail::Reader;
+                    using Serialization::Binary::Detail::Writer;
+
+                    template <typename T>
+                    void MakeObject(Common::Buffer &buffer, T const &from, T const &to);
+
+                    template <typename T>
+                    typename std::enable_if<IsStruct<T>(), void>::type
+                    MakeValue(Common::Buffer &buffer, std::size_t index, T const &from, T const &to);
+
+                    template <typename T>
+                    typename std::enable_if<!IsStruct<T>(), void>::type
+                    MakeValue(Common::Buffer &buffer, std::size_t index, T const &from, T const &to);
+
+                    template <typename T>
+                    void ApplyObject(Reader &reader, T &object);
+
+                    template <typename T>
+                    typename std::enable_if<IsStruct<T>(), void>::type
+                    ApplyValue(Reader &reader, T &object);
+
+                    template <typename T>
+                    typename std::enable_if<!IsStruct<T>(), void>::type
+                    ApplyValue(Reader &reader, T &object);
+
+                    template <typename TBases, std::size_t I, typename T>
+                    inline typename std::enable_if<I == std::tuple_size<TBases>::value, void>::type
+                    MakeBases(Common::Buffer &buffer, T const &from, T const &to)
+                    {
+                        Common::Unused(buffer, from, to);
+                    }
+
+                    template <typename TBases, std::size_t I, typename T>
+                    inline typename std::enable_if<I != std::tuple_size<TBases>::value, void>::type
+                    MakeBases(Common::Buffer &buffer, T const &from, T const &to)
+                    {
+                        using Base = typename std::tuple_element<I, TBases>::type;
+                        MakeValue(buffer, I, static_cast<Base const &>(from), static_cast<Base const &>(to));
+                        MakeBases<TBases, I + 1>(buffer, from, to);
+                    }
+
+                    template <std::size_t I, std::size_t N, typename T>
+                    inline typename std::enable_if<I == N, void>::type
+                    MakeFields(Common::Buffer &buffer, std::size_t offset, T const &from, T const &to)
+                    {
+                        Common::Unused(buffer, offset, from, to);
+                    }
+
+                    template <std::size_t I, std::size_t N, typename T>
+                    inline typename std::enable_if<I != N, void>::type
+                    MakeFields(Common::Buffer &buffer, std::size_t offset, T const &from, T const &to)
+                    {
+                        using Field = typename Reflection::Reflect<T>::Fields::template Field<I>;
+                        MakeValue(buffer, offset + I, from.*Field::Access(), to.*Field::Access());
+                        MakeFields<I + 1, N>(buffer, offset, from, to);
+                    }
+
+                    template <typename T>
+                    inline void MakeObject(Common::Buffer &buffer, T const &from, T const &to)
+                    {
+                        using Meta = Reflection::Reflect<T>;
+                        using Bases = typename Meta::Base;
+                        MakeBases<Bases, 0>(buffer, from, to);
+                        MakeFields<0, Meta::Fields::Count>(buffer, std::tuple_size<Bases>::value, from, to);
+                        Writer{buffer}.WriteVarint(0);
+                    }
+
+                    // The entry of the nested structure is dropped if its patch is empty.
+                    template <typename T>
+                    inline typename std::enable_if<IsStruct<T>(), void>::type
+                    MakeValue(Common::Buffer &buffer, std::size_t index, T const &from, T const &to)
+                    {
+                        auto const offset = buffer.size();
+                        Writer{buffer}.WriteVarint(index + 1);
+                        auto const begin = buffer.size();
+                        MakeObject(buffer, from, to);
+                        if (buffer.size() - begin == 1)
+                            buffer.resize(offset);
+                    }
+
+                    template <typename T>
+                    inline typename std::enable_if<!IsStruct<T>(), void>::type
+                    MakeValue(Common::Buffer &buffer, std::size_t index, T const &from, T const &to)
+                    {
+                        if (IsEqual(from, to))
+                            return;
+                        Writer writer{buffer};
+                        writer.WriteVarint(index + 1);
+                        Serialization::Binary::Detail::Write(writer, to);
+                    }
+
+                    template <typename TBases, std::size_t I, typename T>
+                    inline typename std::enable_if<I == std::tuple_size<TBases>::value, void>::type
+                    ApplyBase(Reader &reader, T &object, std::size_t index)
+                    {
+                        Common::Unused(reader, object, index);
+                    }
+
+                    template <typename TBases, std::size_t I, typename T>
+                    inline typename std::enable_if<I != std::tuple_size<TBases>::value, void>::type
+                    ApplyBase(Reader &reader, T &object, std::size_t index)
+                    {
+                        using Base = typename std::tuple_element<I, TBases>::type;
+                        if (index == I)
+                            ApplyObject(reader, static_cast<Base &>(object));
+                        else
+                            ApplyBase<TBases, I + 1>(reader, object, index);
+                    }
+
+                    struct FieldApplier final
+                    {
+                        Reader &reader;
+
+                        template <typename TValue>
+                        void operator () (char const *, TValue &value) const
+                        {
+                            ApplyValue(reader, value);
+                        }
+                    };
+
+                    template <typename T>
+                    inline void ApplyObject(Reader &reader, T &object)
+                    {
+                        using Meta = Reflection::Reflect<T>;
+                        using Table = Reflection::FieldTable<T>;
+                        constexpr std::size_t basesCount = std::tuple_size<typename Meta::Base>::value;
+
+                        while (auto const entry = reader.ReadVarint())
+                        {
+                            auto const index = static_cast<std::size_t>(entry - 1);
+                            if (entry - 1 >= basesCount + Meta::Fields::Count)
+                                throw std::invalid_argument{"[Mif::Serialization::Patch::ApplyBinary] Bad field index."};
+                            if (index < basesCount)
+                                ApplyBase<typename Meta::Base, 0>(reader, object, index);
+                            else
+                                Table::Visit(object, index - basesCount, FieldApplier{reader});
+                        }
+                    }
+
+                    template <typename T>
+                    inline typename std::enable_if<IsStruct<T>(), void>::type
+                    ApplyValue(Reader &reader, T &object)
+                    {
+                        ApplyObject(reader, object);
+                    }
+
+                    template <typename T>
+                    inline typename std::enable_if<!IsStruct<T>(), void>::type
+                    ApplyValue(Reader &reader, T &object)
+                    {
+                        Serialization::Binary::Detail::Read(reader, object);
+                    }
+
+                }   // namespace Binary
+
+                //--------------------------------------------------------------------------------------------------------------------------
+
+                namespace Json
+                {
+
+                    using Serialization::Json::Detail::StreamReader;
+                    using Serialization::Json::Detail::StreamWriter;
+                    using Serialization::Json::Detail::StreamKey;
+
+                    template <typename T>
+                    void MakeObject(Common::Buffer &buffer, T const &from, T const &to);
+
+                    template <typename TName, typename T>
+                    typename std::enable_if<IsStruct<T>(), void>::type
+                    MakeValue(Common::Buffer &buffer, bool &first, T const &from, T const &to);
+
+                    template <typename TName, typename T>
+                    typename std::enable_if<!IsStruct<T>(), void>::type
+                    MakeValue(Common::Buffer &buffer, bool &first, T const &from, T const &to);
+
+                    template <typename T>
+                    void ApplyObject(StreamReader &reader, T &object);
+
+                    template <typename T>
+                    typename std::enable_if<IsStruct<T>(), void>::type
+                    ApplyValue(StreamReader &reader, T &object);
+
+                    template <typename T>
+                    typename std::enable_if<Traits::IsSmartPointer<T>() || Traits::IsOptional<T>(), void>::type
+                    ApplyValue(StreamReader &reader, T &object);
+
+                    template <typename T>
+                    typename std::enable_if<!IsStruct<T>() && !Traits::IsSmartPointer<T>() && !Traits::IsOptional<T>(), void>::type
+                    ApplyValue(StreamReader &reader, T &object);
+
+                    inline void WriteKey(Common::Buffer &buffer, bool &first, std::string const &key)
+                    {
+                        StreamWriter writer{buffer};
+                        if (!first)
+                            writer.WriteChar(',');
+                        first = false;
+                        writer.WriteRaw(key);
+                    }
+
+                    template <typename TBases, std::size_t I, typename T>
+                    inline typename std::enable_if<I == std::tuple_size<TBases>::value, void>::type
+                    MakeBases(Common::Buffer &buffer, bool &first, T const &from, T const &to)
+                    {
+                        Common::Unused(buffer, first, from, to);
+                    }
+
+                    template <typename TBases, std::size_t I, typename T>
+                    inline typename std::enable_if<I != std::tuple_size<TBases>::value, void>::type
+                    MakeBases(Common::Buffer &buffer, bool &first, T const &from, T const &to)
+                    {
+                        using Base = typename std::tuple_element<I, TBases>::type;
+                        MakeValue<typename Reflection::Reflect<Base>::Name>(buffer, first,
+                                static_cast<Base const &>(from), static_cast<Base const &>(to));
+                        MakeBases<TBases, I + 1>(buffer, first, from, to);
+                    }
+
+                    template <std::size_t I, std::size_t N, typename T>
+                    inline typename std::enable_if<I == N, void>::type
+                    MakeFields(Common::Buffer &buffer, bool &first, T const &from, T const &to)
+                    {
+                        Common::Unused(buffer, first, from, to);
+                    }
+
+                    template <std::size_t I, std::size_t N, typename T>
+                    inline typename std::enable_if<I != N, void>::type
+                    MakeFields(Common::Buffer &buffer, bool &first, T const &from, T const &to)
+                    {
+                        using Field = typename Reflection::Reflect<T>::Fields::template Field<I>;
+                        MakeValue<typename Field::Name>(buffer, first, from.*Field::Access(), to.*Field::Access());
+                        MakeFields<I + 1, N>(buffer, first, from, to);
+                    }
+
+                    template <typename T>
+                    inline void MakeObject(Common::Buffer &buffer, T const &from, T const &to)
+                    {
+                        using Meta = Reflection::Reflect<T>;
+                        bool first = true;
+                        buffer.push_back('{');
+                        MakeBases<typename Meta::Base, 0>(buffer, first, from, to);
+                        MakeFields<0, Meta::Fields::Count>(buffer, first, from, to);
+                        buffer.push_back('}');
+                    }
+
+                    // The member of the nested structure is dropped if its patch is empty.
+                    template <typename TName, typename T>
+                    inline typename std::enable_if<IsStruct<T>(), void>::type
+                    MakeValue(Common::Buffer &buffer, bool &first, T const &from, T const &to)
+                    {
+                        auto const offset = buffer.size();
+                        auto const wasFirst = first;
+                        WriteKey(buffer, first, StreamKey<TName>::Get());
+                        auto const begin = buffer.size();
+                        MakeObject(buffer, from, to);
+                        if (buffer.size() - begin == 2)
+                        {
+                            buffer.resize(offset);
+                            first = wasFirst;
+                        }
+                    }
+
+                    template <typename TName, typename T>
+                    inline typename std::enable_if<!IsStruct<T>(), void>::type
+                    MakeValue(Common::Buffer &buffer, bool &first, T const &from, T const &to)
+                    {
+                        if (IsEqual(from, to))
+                            return;
+                        WriteKey(buffer, first, StreamKey<TName>::Get());
+                        StreamWriter writer{buffer};
+                        Serialization::Json::Detail::WriteValue(writer, to);
+                    }
+
+                    template <typename TBases, std::size_t I, typename T>
+                    inline typename std::enable_if<I == std::tuple_size<TBases>::value, bool>::type
+                    ApplyBase(StreamReader &reader, T &object, char const *key, std::size_t size)
+                    {
+                        Common::Unused(reader, object, key, size);
+                        return false;
+                    }
+
+                    template <typename TBases, std::size_t I, typename T>
+                    inline typename std::enable_if<I != std::tuple_size<TBases>::value, bool>::type
+                    ApplyBase(StreamReader &reader, T &object, char const *key, std::size_t size)
+                    {
+                        using Base = typename std::tuple_element<I, TBases>::type;
+                        if (!Serialization::Json::Detail::IsKey(Reflection::Reflect<Base>::Name::Value, key, size))
+                            return ApplyBase<TBases, I + 1>(reader, object, key, size);
+                        ApplyValue(reader, static_cast<Base &>(object));
+                        return true;
+                    }
+
+                    struct FieldApplier final
+                    {
+                        StreamReader &reader;
+
+                        template <typename TValue>
+                        void operator () (char const *, TValue &value) const
+                        {
+                            ApplyValue(reader, value);
+                        }
+                    };
+
+                    template <typename T>
+                    inline void ApplyObject(StreamReader &reader, T &object)
+                    {
+                        if (reader.Peek() != '{')
+                            reader.Fail("Failed to apply patch. Json element is not an object.");
+
+                        auto const &table = Reflection::FieldTable<T>::Get();
+
+                        reader.Expect('{');
+                        if (reader.TryTake('}'))
+                            return;
+
+                        do
+                        {
+                            char const *key = nullptr;
+                            std::size_t size = 0;
+                            reader.ReadString(key, size);
+                            reader.Expect(':');
+                            if (!ApplyBase<typename Reflection::Reflect<T>::Base, 0>(reader, object, key, size) &&
+                                    !table.Visit(object, key, size, FieldApplier{reader}))
+                            {
+                                reader.SkipValue();
+                            }
+                        }
+                        while (reader.TryTake(','));
+
+                        reader.Expect('}');
+                    }
+
+                    template <typename T>
+                    inline typename std::enable_if<IsStruct<T>(), void>::type
+                    ApplyValue(StreamReader &reader, T &object)
+                    {
+                        ApplyObject(reader, object);
+                    }
+
+                    template <typename T>
+                    inline typename std::enable_if<Traits::IsSmartPointer<T>() || Traits::IsOptional<T>(), void>::type
+                    ApplyValue(StreamReader &reader, T &object)
+                    {
+                        if (reader.TryNull())
+                            object = T{};
+                        else
+                            Serialization::Json::Detail::ReadValue(reader, object);
+                    }
+
+                    template <typename T>
+                    inline typename std::enable_if<!IsStruct<T>() && !Traits::IsSmartPointer<T>() && !Traits::IsOptional<T>(), void>::type
+                    ApplyValue(StreamReader &reader, T &object)
+                    {
+                        Serialization::Json::Detail::ReadValue(reader, object);
+                    }
+
+                }   // namespace Json
+
+            }   // namespace Detail
+
+            template <typename T>
+            inline Common::Buffer MakeBinary(T const &from, T const &to)
+            {
+                static_assert(Detail::IsStruct<T>(), "[Mif::Serialization::Patch::MakeBinary] Type must be reflectable struct.");
+                Common::Buffer buffer;
+                Detail::Binary::MakeObject(buffer, from, to);
+                return buffer;
+            }
+
+            template <typename T>
+            inline void ApplyBinary(T &object, char const *data, std::size_t size)
+            {
+                static_assert(Detail::IsStruct<T>(), "[Mif::Serialization::Patch::ApplyBinary] Type must be reflectable struct.");
+                Serialization::Binary::Detail::Reader reader{data, data + size};
+                Detail::Binary::ApplyObject(reader, object);
+                if (!reader.IsEnd())
+                    throw std::invalid_argument{"[Mif::Serialization::Patch::ApplyBinary] Unexpected data after the patch."};
+            }
+
+            template <typename T>
+            inline void ApplyBinary(T &object, Common::Buffer const &patch)
+            {
+                ApplyBinary(object, patch.data(), patch.size());
+            }
+
+            template <typename T>
+            inline Common::Buffer MakeJson(T const &from, T const &to)
+            {
+                static_assert(Detail::IsStruct<T>(), "[Mif::Serialization::Patch::MakeJson] Type must be reflectable struct.");
+                Common::Buffer buffer;
+                Detail::Json::MakeObject(buffer, from, to);
+                return buffer;
+            }
+
+            template <typename T>
+            inline void ApplyJson(T &object, char const *data, std::size_t size)
+            {
+                static_assert(Detail::IsStruct<T>(), "[Mif::Serialization::Patch::ApplyJson] Type must be reflectable struct.");
+                Serialization::Json::Detail::StreamReader reader{data, data + size};
+                Detail::Json::ApplyObject(reader, object);
+                if (!reader.IsEnd())
+                    reader.Fail("Unexpected data after the patch.");
+            }
+
+            template <typename T>
+            inline void ApplyJson(T &object, Common::Buffer const &patch)
+            {
+                ApplyJson(object, patch.data(), patch.size());
+            }
+
+        }   // namespace Patch
+    }   // namespace Serialization
+}   // namespace Mif
+
+#endif  // !__MIF_SERIALIZATION_PATCH_H__
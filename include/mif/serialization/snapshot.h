@@ -0,0 +1,733 @@
+//-------------------------------------------------------------------
+//  MetaInfo Framework (MIF)
+//  https://github.com/tdv/mif
+//  Created:     10.2026
+//  Copyright (C) 2016-2024 tdv
+//-------------------------------------------------------------------
+
+#ifndef __MIF_SERIALIZATION_SNAPSHOT_H__
+#define __MIF_SERIALIZATION_SNAPSHOT_H__
+
+// STD
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// BOOST
+#include <boost/iostreams/device/mapped_file.hpp>
+
+// MIF
+#include "mif/common/types.h"
+#include "mif/common/unused.h"
+#include "mif/reflection/hash.h"
+#include "mif/reflection/reflection.h"
+#include "mif/serialization/traits.h"
+
+// The snapshot is a flat read-only image of a vector of the reflected structures. It is written
+// once and then read in place (from memory or from the mapped file) through the typed views
+// without deserialization.
+//  - The header has the magic "MIFS", the version, the fingerprint of the layout of the type
+//    and the reference to the array of the root items.
+//  - Each structure is a fixed-size slot with its bases and then its fields placed by their
+//    alignment. The numbers and the enums are placed in the slot as is, in the host byte order.
+//  - The strings and the containers are the references {offset, size} to the data at the end
+//    of the snapshot, the pointers and the optionals are the offsets of the values or 0.
+// The maps and other types are not supported.
+
+namespace Mif
+{
+    namespace Serialization
+    {
+        namespace Snapshot
+        {
+
+            template <typename T>
+            class View;
+
+            template <typename T>
+            class Array;
+
+            template <typename T>
+            class Pointer;
+
+            class String final
+            {
+            public:
+                String(char const *data, std::size_t size)
+                    : m_data{data}
+                    , m_size{size}
+                {
+                }
+
+                char const* Data() const
+                {
+                    return m_data;
+                }
+
+                std::size_t Size() const
+                {
+                    return m_size;
+                }
+
+                bool Empty() const
+                {
+                    return !m_size;
+                }
+
+                std::string ToString() const
+                {
+                    return {m_data, m_size};
+                }
+
+                bool operator == (std::string const &value) const
+                {
+                    return m_size == value.size() && !std::memcmp(m_data, value.data(), m_size);
+                }
+
+                bool operator != (std::string const &value) const
+                {
+                    return !(*this == value);
+                }
+
+            private:
+                char const *m_data;
+                std::size_t m_size;
+            };
+
+            namespace Detail
+            {
+
+                constexpr std::uint32_t Version = 1;
+                constexpr std::size_t RefSize = 2 * sizeof(std::uint64_t);
+                constexpr std::size_t HeaderSize = 16 + RefSize;
+
+                inline constexpr std::size_t AlignUp(std::size_t value, std::size_t align)
+                {
+                    return (value + align - 1) / align * align;
+                }
+
+                struct Range final
+                {
+                    char const *begin;
+                    char const *end;
+                };
+
+                inline std::size_t Alloc(Common::Buffer &buffer, std::size_t size, std::size_t align)
+                {
+                    auto const offset = AlignUp(buffer.size(), align);
+                    buffer.resize(offset + size);
+                    return offset;
+                }
+
+                inline void WriteUInt64(Common::Buffer &buffer, std::size_t offset, std::uint64_t value)
+                {
+                    std::memcpy(buffer.data() + offset, &value, sizeof(value));
+                }
+
+                inline std::uint64_t ReadUInt64(char const *slot)
+                {
+                    std::uint64_t value = 0;
+                    std::memcpy(&value, slot, sizeof(value));
+                    return value;
+                }
+
+                // Returns the pointer to the data of count items of the size at the offset.
+                inline char const* CheckRange(Range const &range, std::uint64_t offset, std::uint64_t count, std::size_t size)
+                {
+                    auto const total = static_cast<std::uint64_t>(range.end - range.begin);
+                    if (offset > total || (size && count > (total - offset) / size))
+                        throw std::out_of_range{"[Mif::Serialization::Snapshot] Bad reference."};
+                    return range.begin + offset;
+                }
+
+                enum class Kind : std::uint64_t
+                {
+                    Number = 1,
+                    Enum,
+                    String,
+                    Struct,
+                    Array,
+                    Pointer
+                };
+
+                template <typename T>
+                inline constexpr bool IsStruct()
+                {
+                    return Reflection::IsReflectable<T>() && !std::is_enum<T>::value;
+                }
+
+                template <typename T>
+                inline constexpr bool IsArray()
+                {
+                    return Traits::IsIterable<T>() && !Traits::IsMap<T>();
+                }
+
+                template <typename T>
+                inline constexpr bool IsPointer()
+                {
+                    return Traits::IsSmartPointer<T>() || Traits::IsOptional<T>();
+                }
+
+                template <typename T, typename = void>
+                struct Slot
+                {
+                    static_assert(!std::is_same<T, T>::value, "[Mif::Serialization::Snapshot] Type is not supported.");
+                };
+
+                //--------------------------------------------------------------------------------------------------------------------------
+
+                template <typename T>
+                using BasesOf = typename Reflection::Reflect<T>::Base;
+
+                template <typename T>
+                inline constexpr std::size_t ElementsCount()
+                {
+                    return std::tuple_size<BasesOf<T>>::value + Reflection::Reflect<T>::Fields::Count;
+                }
+
+                // The bases go first, then the fields.
+                template <typename T, std::size_t J, bool = (J < std::tuple_size<BasesOf<T>>::value)>
+                struct Element
+                {
+                    using Type = typename std::tuple_element<J, BasesOf<T>>::type;
+                };
+
+                template <typename T, std::size_t J>
+                struct Element<T, J, false>
+                {
+                    using Field = typename Reflection::Reflect<T>::Fields::template Field<J - std::tuple_size<BasesOf<T>>::value>;
+                    using Type = typename Field::Type;
+                };
+
+                template <typename T, std::size_t J>
+                struct ElementOffset
+                {
+                    static constexpr std::size_t Value = AlignUp(
+                            ElementOffset<T, J - 1>::Value + Slot<typename Element<T, J - 1>::Type>::Size,
+                            Slot<typename Element<T, J>::Type>::Align
+                        );
+                };
+
+                template <typename T>
+                struct ElementOffset<T, 0>
+                {
+                    static constexpr std::size_t Value = 0;
+                };
+
+                // The end of the last element. The struct without fields and bases has no data.
+                template <typename T, std::size_t Count = ElementsCount<T>()>
+                struct ElementsSize
+                {
+                    static constexpr std::size_t Value = ElementOffset<T, Count - 1>::Value +
+                            Slot<typename Element<T, Count - 1>::Type>::Size;
+                };
+
+                template <typename T>
+                struct ElementsSize<T, 0>
+                {
+                    static constexpr std::size_t Value = 0;
+                };
+
+                template <typename T, std::size_t J>
+                inline typename std::enable_if<(J < std::tuple_size<BasesOf<T>>::value), typename Element<T, J>::Type const &>::type
+                GetElement(T const &object)
+                {
+                    return static_cast<typename Element<T, J>::Type const &>(object);
+                }
+
+                template <typename T, std::size_t J>
+                inline typename std::enable_if<(J >= std::tuple_size<BasesOf<T>>::value), typename Element<T, J>::Type const &>::type
+                GetElement(T const &object)
+                {
+                    return object.*Element<T, J>::Field::Access();
+                }
+
+                template <typename T, std::size_t J>
+                inline typename std::enable_if<(J < std::tuple_size<BasesOf<T>>::value), std::uint64_t>::type
+                ElementFingerprint(std::uint64_t seed)
+                {
+                    return Slot<typename Element<T, J>::Type>::Fingerprint(seed);
+                }
+
+                template <typename T, std::size_t J>
+                inline typename std::enable_if<(J >= std::tuple_size<BasesOf<T>>::value), std::uint64_t>::type
+                ElementFingerprint(std::uint64_t seed)
+                {
+                    using Field = typename Element<T, J>::Field;
+                    auto const *name = Field::Name::Value;
+                    seed = Reflection::Detail::Compare::HashBytes(seed, name, std::strlen(name));
+                    return Slot<typename Element<T, J>::Type>::Fingerprint(seed);
+                }
+
+                template <typename T, std::size_t J, std::size_t N>
+                inline typename std::enable_if<J == N, void>::type
+                WriteElements(Common::Buffer &buffer, std::size_t offset, T const &object)
+                {
+                    Common::Unused(buffer, offset, object);
+                }
+
+                template <typename T, std::size_t J, std::size_t N>
+                inline typename std::enable_if<J != N, void>::type
+                WriteElements(Common::Buffer &buffer, std::size_t offset, T const &object)
+                {
+                    Slot<typename Element<T, J>::Type>::Write(buffer, offset + ElementOffset<T, J>::Value,
+                            GetElement<T, J>(object));
+                    WriteElements<T, J + 1, N>(buffer, offset, object);
+                }
+
+                template <typename T, std::size_t J, std::size_t N>
+                inline typename std::enable_if<J == N, std::uint64_t>::type
+                FingerprintElements(std::uint64_t seed)
+                {
+                    return seed;
+                }
+
+                template <typename T, std::size_t J, std::size_t N>
+                inline typename std::enable_if<J != N, std::uint64_t>::type
+                FingerprintElements(std::uint64_t seed)
+                {
+                    return FingerprintElements<T, J + 1, N>(ElementFingerprint<T, J>(seed));
+                }
+
+                //--------------------------------------------------------------------------------------------------------------------------
+
+                template <typename T>
+                struct Slot<T, typename std::enable_if<std::is_arithmetic<T>::value>::type>
+                {
+                    using ViewType = T;
+
+                    static constexpr std::size_t Size = sizeof(T);
+                    static constexpr std::size_t Align = alignof(T);
+
+                    static std::uint64_t Fingerprint(std::uint64_t seed)
+                    {
+                        return Reflection::Detail::Compare::Combine(seed, (static_cast<std::uint64_t>(Kind::Number) << 16) |
+                                (std::is_floating_point<T>::value ? 0x200 : 0) | (std::is_signed<T>::value ? 0x100 : 0) | sizeof(T));
+                    }
+
+                    static void Write(Common::Buffer &buffer, std::size_t offset, T const &value)
+                    {
+                        std::memcpy(buffer.data() + offset, &value, sizeof(T));
+                    }
+
+                    static ViewType Read(Range const &, char const *slot)
+                    {
+                        T value;
+                        std::memcpy(&value, slot, sizeof(T));
+                        return value;
+                    }
+                };
+
+                template <typename T>
+                struct Slot<T, typename std::enable_if<std::is_enum<T>::value>::type>
+                {
+                    using ViewType = T;
+                    using Underlying = typename std::underlying_type<T>::type;
+
+                    static constexpr std::size_t Size = sizeof(Underlying);
+                    static constexpr std::size_t Align = alignof(Underlying);
+
+                    static std::uint64_t Fingerprint(std::uint64_t seed)
+                    {
+                        return Reflection::Detail::Compare::Combine(seed,
+                                (static_cast<std::uint64_t>(Kind::Enum) << 16) | sizeof(Underlying));
+                    }
+
+                    static void Write(Common::Buffer &buffer, std::size_t offset, T const &value)
+                    {
+                        Slot<Underlying>::Write(buffer, offset, static_cast<Underlying>(value));
+                    }
+
+                    static ViewType Read(Range const &range, char const *slot)
+                    {
+                        return static_cast<T>(Slot<Underlying>::Read(range, slot));
+                    }
+                };
+
+                template <>
+                struct Slot<std::string, void>
+                {
+                    using ViewType = String;
+
+                    static constexpr std::size_t Size = RefSize;
+                    static constexpr std::size_t Align = alignof(std::uint64_t);
+
+                    static std::uint64_t Fingerprint(std::uint64_t seed)
+                    {
+                        return Reflection::Detail::Compare::Combine(seed, static_cast<std::uint64_t>(Kind::String) << 16);
+                    }
+
+                    static void Write(Common::Buffer &buffer, std::size_t offset, std::string const &value)
+                    {
+                        auto const data = Alloc(buffer, value.size(), 1);
+                        if (!value.empty())
+                            std::memcpy(buffer.data() + data, value.data(), value.size());
+                        WriteUInt64(buffer, offset, data);
+                        WriteUInt64(buffer, offset + sizeof(std::uint64_t), value.size());
+                    }
+
+                    static ViewType Read(Range const &range, char const *slot)
+                    {
+                        auto const size = ReadUInt64(slot + sizeof(std::uint64_t));
+                        return {CheckRange(range, ReadUInt64(slot), size, 1), static_cast<std::size_t>(size)};
+                    }
+                };
+
+                template <typename T>
+                struct Slot<T, typename std::enable_if<IsStruct<T>()>::type>
+                {
+                    using ViewType = View<T>;
+
+                    static constexpr std::size_t Count = ElementsCount<T>();
+                    static constexpr std::size_t Align = alignof(std::uint64_t);
+                    static constexpr std::size_t Size = AlignUp(ElementsSize<T>::Value, Align);
+
+                    static std::uint64_t Fingerprint(std::uint64_t seed)
+                    {
+                        seed = Reflection::Detail::Compare::Combine(seed, (static_cast<std::uint64_t>(Kind::Struct) << 16) | Count);
+                        return FingerprintElements<T, 0, Count>(seed);
+                    }
+
+                    static void Write(Common::Buffer &buffer, std::size_t offset, T const &value)
+                    {
+                        WriteElements<T, 0, Count>(buffer, offset, value);
+                    }
+
+                    static ViewType Read(Range const &range, char const *slot)
+                    {
+                        return {range, slot};
+                    }
+                };
+
+                template <typename T>
+                struct Slot<T, typename std::enable_if<IsArray<T>()>::type>
+                {
+                    using Item = typename std::decay<typename T::value_type>::type;
+                    using ViewType = Array<Item>;
+
+                    static constexpr std::size_t Size = RefSize;
+                    static constexpr std::size_t Align = alignof(std::uint64_t);
+
+                    static std::uint64_t Fingerprint(std::uint64_t seed)
+                    {
+                        seed = Reflection::Detail::Compare::Combine(seed, static_cast<std::uint64_t>(Kind::Array) << 16);
+                        return Slot<Item>::Fingerprint(seed);
+                    }
+
+                    static void Write(Common::Buffer &buffer, std::size_t offset, T const &value)
+                    {
+                        auto const count = static_cast<std::size_t>(std::distance(std::begin(value), std::end(value)));
+                        auto const data = Alloc(buffer, count * Slot<Item>::Size, Slot<Item>::Align);
+                        auto item = data;
+                        for (auto const &i : value)
+                        {
+                            Slot<Item>::Write(buffer, item, i);
+                            item += Slot<Item>::Size;
+                        }
+                        WriteUInt64(buffer, offset, data);
+                        WriteUInt64(buffer, offset + sizeof(std::uint64_t), count);
+                    }
+
+                    static ViewType Read(Range const &range, char const *slot)
+                    {
+                        auto const count = ReadUInt64(slot + sizeof(std::uint64_t));
+                        return {range, CheckRange(range, ReadUInt64(slot), count, Slot<Item>::Size),
+                                static_cast<std::size_t>(count)};
+                    }
+                };
+
+                template <typename T>
+                struct Slot<T, typename std::enable_if<IsPointer<T>()>::type>
+                {
+                    using Item = typename std::decay<decltype(*std::declval<T const &>())>::type;
+                    using ViewType = Pointer<Item>;
+
+                    static constexpr std::size_t Size = sizeof(std::uint64_t);
+                    static constexpr std::size_t Align = alignof(std::uint64_t);
+
+                    static std::uint64_t Fingerprint(std::uint64_t seed)
+                    {
+                        seed = Reflection::Detail::Compare::Combine(seed, static_cast<std::uint64_t>(Kind::Pointer) << 16);
+                        return Slot<Item>::Fingerprint(seed);
+                    }
+
+                    static void Write(Common::Buffer &buffer, std::size_t offset, T const &value)
+                    {
+                        if (!value)
+                            return;
+                        auto const data = Alloc(buffer, Slot<Item>::Size, Slot<Item>::Align);
+                        Slot<Item>::Write(buffer, data, *value);
+                        WriteUInt64(buffer, offset, data);
+                    }
+
+                    static ViewType Read(Range const &range, char const *slot)
+                    {
+                        auto const offset = ReadUInt64(slot);
+                        return {range, offset ? CheckRange(range, offset, 1, Slot<Item>::Size) : nullptr};
+                    }
+                };
+
+                template <typename T>
+                inline std::uint64_t GetFingerprint()
+                {
+                    static auto const fingerprint = Slot<T>::Fingerprint(Reflection::Detail::Compare::Seed);
+                    return fingerprint;
+                }
+
+            }   // namespace Detail
+
+            // The view of a structure in the snapshot. Get<I> gives the field with the index I
+            // of Reflect<T>::Fields, GetBase<I> gives the view of the base with the index I.
+            //  - the numbers and the enums are returned by value;
+            //  - the strings are returned as String;
+            //  - the nested structures are returned as View;
+            //  - the containers are returned as Array;
+            //  - the pointers and the optionals are returned as Pointer.
+            template <typename T>
+            class View final
+            {
+            public:
+                template <std::size_t I>
+                using FieldType = typename Reflection::Reflect<T>::Fields::template Field<I>::Type;
+
+                template <std::size_t I>
+                using BaseType = typename std::tuple_element<I, Detail::BasesOf<T>>::type;
+
+                View(Detail::Range const &range, char const *slot)
+                    : m_range(range)
+                    , m_slot{slot}
+                {
+                }
+
+                template <std::size_t I>
+                typename Detail::Slot<FieldType<I>>::ViewType Get() const
+                {
+                    constexpr auto index = std::tuple_size<Detail::BasesOf<T>>::value + I;
+                    return Detail::Slot<FieldType<I>>::Read(m_range, m_slot + Detail::ElementOffset<T, index>::Value);
+                }
+
+                template <std::size_t I>
+                View<BaseType<I>> GetBase() const
+                {
+                    return {m_range, m_slot + Detail::ElementOffset<T, I>::Value};
+                }
+
+            private:
+                Detail::Range m_range;
+                char const *m_slot;
+            };
+
+            template <typename T>
+            class Array final
+            {
+            public:
+                using ViewType = typename Detail::Slot<T>::ViewType;
+
+                Array(Detail::Range const &range, char const *data, std::size_t size)
+                    : m_range(range)
+                    , m_data{data}
+                    , m_size{size}
+                {
+                }
+
+                std::size_t Size() const
+                {
+                    return m_size;
+                }
+
+                bool Empty() const
+                {
+                    return !m_size;
+                }
+
+                ViewType operator [] (std::size_t index) const
+                {
+                    return Detail::Slot<T>::Read(m_range, m_data + index * Detail::Slot<T>::Size);
+                }
+
+                ViewType At(std::size_t index) const
+                {
+                    if (index >= m_size)
+                        throw std::out_of_range{"[Mif::Serialization::Snapshot::Array::At] Bad index."};
+                    return (*this)[index];
+                }
+
+            private:
+                Detail::Range m_range;
+                char const *m_data;
+                std::size_t m_size;
+            };
+
+            template <typename T>
+            class Pointer final
+            {
+            public:
+                using ViewType = typename Detail::Slot<T>::ViewType;
+
+                Pointer(Detail::Range const &range, char const *slot)
+                    : m_range(range)
+                    , m_slot{slot}
+                {
+                }
+
+                explicit operator bool () const
+                {
+                    return !!m_slot;
+                }
+
+                ViewType Get() const
+                {
+                    if (!m_slot)
+                        throw std::logic_error{"[Mif::Serialization::Snapshot::Pointer::Get] Empty pointer."};
+                    return Detail::Slot<T>::Read(m_range, m_slot);
+                }
+
+                ViewType operator * () const
+                {
+                    return Get();
+                }
+
+            private:
+                Detail::Range m_range;
+                char const *m_slot;
+            };
+
+            // The snapshot of the items in memory. The data must live while the document and
+            // its views are used.
+            template <typename T>
+            class Document final
+            {
+            public:
+                static_assert(Detail::IsStruct<T>(), "[Mif::Serialization::Snapshot::Document] Type must be reflectable struct.");
+
+                using ViewType = View<T>;
+
+                Document(char const *data, std::size_t size)
+                    : m_items{Open(data, size)}
+                {
+                }
+
+                std::size_t Size() const
+                {
+                    return m_items.Size();
+                }
+
+                bool Empty() const
+                {
+                    return m_items.Empty();
+                }
+
+                ViewType operator [] (std::size_t index) const
+                {
+                    return m_items[index];
+                }
+
+                ViewType At(std::size_t index) const
+                {
+                    return m_items.At(index);
+                }
+
+                Array<T> const& GetItems() const
+                {
+                    return m_items;
+                }
+
+            private:
+                Array<T> m_items;
+
+                static Array<T> Open(char const *data, std::size_t size)
+                {
+                    if (size < Detail::HeaderSize || std::memcmp(data, "MIFS", 4))
+                        throw std::invalid_argument{"[Mif::Serialization::Snapshot::Document] Bad snapshot header."};
+
+                    std::uint32_t version = 0;
+                    std::memcpy(&version, data + 4, sizeof(version));
+                    if (version != Detail::Version)
+                        throw std::invalid_argument{"[Mif::Serialization::Snapshot::Document] Unsupported snapshot version."};
+
+                    if (Detail::ReadUInt64(data + 8) != Detail::GetFingerprint<T>())
+                        throw std::invalid_argument{"[Mif::Serialization::Snapshot::Document] The snapshot has the other type layout."};
+
+                    return Detail::Slot<std::vector<T>>::Read({data, data + size}, data + 16);
+                }
+            };
+
+            // The snapshot in the mapped file. The pages of the file are shared by all the processes
+            // which map it.
+            template <typename T>
+            class MappedFile final
+            {
+            public:
+                using ViewType = View<T>;
+
+                explicit MappedFile(std::string const &fileName)
+                    : m_file{fileName}
+                    , m_document{m_file.data(), m_file.size()}
+                {
+                }
+
+                std::size_t Size() const
+                {
+                    return m_document.Size();
+                }
+
+                bool Empty() const
+                {
+                    return m_document.Empty();
+                }
+
+                ViewType operator [] (std::size_t index) const
+                {
+                    return m_document[index];
+                }
+
+                ViewType At(std::size_t index) const
+                {
+                    return m_document.At(index);
+                }
+
+                Document<T> const& GetDocument() const
+                {
+                    return m_document;
+                }
+
+            private:
+                boost::iostreams::mapped_file_source m_file;
+                Document<T> m_document;
+            };
+
+            template <typename T>
+            inline Common::Buffer Serialize(std::vector<T> const &items)
+            {
+                static_assert(Detail::IsStruct<T>(), "[Mif::Serialization::Snapshot::Serialize] Type must be reflectable struct.");
+
+                Common::Buffer buffer(Detail::HeaderSize, 0);
+                std::memcpy(buffer.data(), "MIFS", 4);
+                auto const version = Detail::Version;
+                std::memcpy(buffer.data() + 4, &version, sizeof(version));
+                Detail::WriteUInt64(buffer, 8, Detail::GetFingerprint<T>());
+                Detail::Slot<std::vector<T>>::Write(buffer, 16, items);
+                return buffer;
+            }
+
+            template <typename T>
+            inline void Save(std::string const &fileName, std::vector<T> const &items)
+            {
+                auto const buffer = Serialize(items);
+                std::ofstream file{fileName, std::ios::binary | std::ios::trunc};
+                if (!file.write(buffer.data(), static_cast<std::streamsize>(buffer.size())) || !file.flush())
+                    throw std::runtime_error{"[Mif::Serialization::Snapshot::Save] Failed to write file \"" + fileName + "\"."};
+            }
+
+        }   // namespace Snapshot
+    }   // namespace Serialization
+}   // namespace Mif
+
+#endif  // !__MIF_SERIALIZATION_SNAPSHOT_H__
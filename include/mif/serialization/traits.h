@@ -16,6 +16,17 @@ namespace Mif
 {
     namespace Serialization
     {
+
+        // The byte container (the container of chars) is written in json and xml as the base64 text
+        // if it is true. Specialize it with std::true_type for your types. Otherwise the bytes are
+        // written as the string of hex pairs in json and as an item per byte in xml. Both forms are
+        // read regardless of it.
+        template <typename T>
+        struct BlobAsBase64
+            : public std::false_type
+        {
+        };
+
         namespace Traits
         {
             namespace Detail
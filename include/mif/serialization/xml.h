@@ -12,31 +12,30 @@
 #include <array>
 #include <stdexcept>
 #include <cstdint>
+#include <cstring>
 #include <iterator>
 #include <istream>
+#include <limits>
 #include <ostream>
-#include <sstream>
 #include <string>
 #include <tuple>
 #include <type_traits>
 #include <utility>
 
-// BOOST
-#include <boost/iostreams/device/back_inserter.hpp>
-#include <boost/iostreams/device/array.hpp>
-#include <boost/iostreams/filtering_stream.hpp>
-#include <boost/iostreams/stream.hpp>
-#include <boost/property_tree/ptree.hpp>
-#include <boost/property_tree/xml_parser.hpp>
-
+// PUGIXML
+#include <pugixml.hpp>
 
 // MIF
+#include "mif/common/base64.h"
+#include "mif/common/number.h"
 #include "mif/common/types.h"
 #include "mif/common/static_string.h"
 #include "mif/common/unused.h"
 #include "mif/reflection/reflection.h"
 #include "mif/serialization/traits.h"
 
+// Specialize BlobAsBase64 in order to write the byte containers as base64 text instead of an item per byte
+
 namespace Mif
 {
     namespace Serialization
@@ -54,13 +53,173 @@ namespace Mif
 
                 }   // namespace Tag
 
-                using NodeType = boost::property_tree::ptree;
+                using NodeType = pugi::xml_node;
+
+                class BufferWriter final
+                    : public pugi::xml_writer
+                {
+                public:
+                    BufferWriter(Common::Buffer &buffer)
+                        : m_buffer{buffer}
+                    {
+                    }
+
+                    virtual void write(void const *data, std::size_t size) override final
+                    {
+                        auto const *chars = static_cast<char const *>(data);
+                        m_buffer.insert(std::end(m_buffer), chars, chars + size);
+                    }
+
+                private:
+                    Common::Buffer &m_buffer;
+                };
+
+                inline NodeType AddNode(NodeType &node, std::string const &name)
+                {
+                    return node.append_child(name.c_str());
+                }
+
+                inline void AddNode(NodeType &node, std::string const &name, char const *value)
+                {
+                    auto item = AddNode(node, name);
+                    if (*value)
+                        item.append_child(pugi::node_pcdata).set_value(value);
+                }
+
+                // The empty name is the node itself (the items of the containers).
+                inline NodeType GetNode(NodeType const &node, std::string const &name)
+                {
+                    return name.empty() ? node : node.child(name.c_str());
+                }
+
+                inline void CheckParseResult(pugi::xml_parse_result const &result)
+                {
+                    if (!result)
+                    {
+                        throw std::invalid_argument{"[Mif::Serialization::Xml::Detail::Deserialize] "
+                                "Failed to parse xml. " + std::string{result.description()} +
+                                ". Position: " + std::to_string(result.offset) + "."};
+                    }
+                }
+
+                // The whitespace-only text is kept, it is the value of the string.
+                inline unsigned int GetParseOptions()
+                {
+                    return pugi::parse_default | pugi::parse_ws_pcdata_single;
+                }
+
+                inline bool IsSpace(char ch)
+                {
+                    return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r';
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_same<T, bool>::value, bool>::type
+                ParseScalar(char const *begin, char const *end, T &value)
+                {
+                    auto const size = static_cast<std::size_t>(end - begin);
+                    if ((size == 1 && *begin == '1') || (size == 4 && !std::strncmp(begin, "true", 4)))
+                        value = true;
+                    else if ((size == 1 && *begin == '0') || (size == 5 && !std::strncmp(begin, "false", 5)))
+                        value = false;
+                    else
+                        return false;
+                    return true;
+                }
+
+                template <typename T>
+                inline typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, bool>::type
+                ParseScalar(char const *begin, char const *end, T &value)
+                {
+                    bool isNegative = false;
+                    if (begin != end && (*begin == '-' || *begin == '+'))
+                        isNegative = *begin++ == '-';
+                    if (begin == end)
+                        return false;
+
+                    std::uint64_t result = 0;
+                    for ( ; begin != end ; ++begin)
+                    {
+                        if (*begin < '0' || *begin > '9')
+                            return false;
+                        auto const digit = static_cast<std::uint64_t>(*begin - '0');
+                        if (result > (std::numeric_limits<std::uint64_t>::max() - digit) / 10)
+                            return false;
+                        result = result * 10 + digit;
+                    }
+
+                    if (!isNegative || !result)
+                    {
+                        if (result > static_cast<std::uint64_t>(std::numeric_limits<T>::max()))
+                            return false;
+                        value = static_cast<T>(result);
+                        return true;
+                    }
+
+                    if (!std::is_signed<T>::value ||
+                            result - 1 > static_cast<std::uint64_t>(-(static_cast<std::int64_t>(std::numeric_limits<T>::min()) + 1)))
+                    {
+                        return false;
+                    }
+                    value = static_cast<T>(-static_cast<std::int64_t>(result - 1) - 1);
+                    return true;
+                }
+
+                // The special values are taken in the form of std::to_string.
+                template <typename T>
+                inline typename std::enable_if<std::is_floating_point<T>::value, bool>::type
+                ParseScalar(char const *begin, char const *end, T &value)
+                {
+                    auto const *pos = begin;
+                    bool const isNegative = pos != end && *pos == '-';
+                    if (pos != end && (*pos == '-' || *pos == '+'))
+                        ++pos;
+                    auto const size = static_cast<std::size_t>(end - pos);
+                    if (size == 3 && !std::strncmp(pos, "inf", 3))
+                    {
+                        value = isNegative ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity();
+                        return true;
+                    }
+                    if (size == 3 && !std::strncmp(pos, "nan", 3))
+                    {
+                        value = std::numeric_limits<T>::quiet_NaN();
+                        return true;
+                    }
+
+                    double result = 0;
+                    if (Common::Number::ParseDouble(begin, end, result) != end || begin == end)
+                        return false;
+                    value = static_cast<T>(result);
+                    return true;
+                }
+
+                // The scalars are parsed straight from the node text in the classic locale. The spaces
+                // around the value are skipped.
+                template <typename T>
+                inline void ParseValue(char const *text, T &value, std::string const &name)
+                {
+                    auto const *begin = text;
+                    auto const *end = text + std::strlen(text);
+                    while (begin != end && IsSpace(*begin))
+                        ++begin;
+                    while (end != begin && IsSpace(end[-1]))
+                        --end;
+
+                    if (!ParseScalar(begin, end, value))
+                    {
+                        throw std::invalid_argument{"[Mif::Serialization::Xml::Detail::Deserialize] "
+                                "Failed to parse value \"" + std::string{text} + "\" of node \"" + name + "\"."};
+                    }
+                }
 
                 //--------------------------------------------------------------------------------------------------------------------------
 
                 template <typename T>
                 void Serialize(std::ostream &stream, T const &object, std::string const &root = {});
 
+                template <typename T>
+                void Serialize(Common::Buffer &buffer, T const &object, std::string const &root = {});
+
                 template <typename TBases, std::size_t I, typename T>
                 typename std::enable_if<I != std::tuple_size<TBases>::value, void>::type
                 SerializeBase(NodeType &node, T const &object);
@@ -82,7 +241,21 @@ namespace Mif
                 Serialize(NodeType &node, T const &object, std::string const &name);
 
                 template <typename T>
-                typename std::enable_if<Traits::IsIterable<T>(), void>::type
+                typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() &&
+                            !std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                        void
+                    >::type
+                Serialize(NodeType &node, T const &object, std::string const &name);
+
+                template <typename T>
+                typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() &&
+                            std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                        void
+                    >::type
                 Serialize(NodeType &node, T const &object, std::string const &name);
 
                 template <typename T>
@@ -124,6 +297,15 @@ namespace Mif
                 template <typename T>
                 void Deserialize(std::istream &stream, T &object, std::string const &root = {});
 
+                template <typename T>
+                void Deserialize(char const *data, std::size_t size, T &object, std::string const &root = {});
+
+                template <typename T>
+                void DeserializeInPlace(char *data, std::size_t size, T &object, std::string const &root = {});
+
+                template <typename T>
+                void Deserialize(pugi::xml_document const &doc, T &object, std::string const &root);
+
                 template <typename TBases, std::size_t I, typename T>
                 typename std::enable_if<I != std::tuple_size<TBases>::value, void>::type
                 DeserializeBase(NodeType const &node, T &object);
@@ -153,7 +335,21 @@ namespace Mif
                 Deserialize(NodeType const &node, T &object);
 
                 template <typename T>
-                typename std::enable_if<Traits::IsIterable<T>(), void>::type
+                typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() &&
+                            !std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                        void
+                    >::type
+                Deserialize(NodeType const &node, T &object, std::string const &name);
+
+                template <typename T>
+                typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() &&
+                            std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                        void
+                    >::type
                 Deserialize(NodeType const &node, T &object, std::string const &name);
 
                 template <typename T>
@@ -173,11 +369,11 @@ namespace Mif
 
                 template <std::size_t I, std::size_t N, typename T>
                 typename std::enable_if<I != N, void>::type
-                Deserialize(NodeType &node, T &object);
+                DeserializeItems(NodeType const &item, T &object);
 
                 template <std::size_t I, std::size_t N, typename T>
                 typename std::enable_if<I == N, void>::type
-                Deserialize(NodeType &node, T &object);
+                DeserializeItems(NodeType const &item, T &object);
 
                 template <typename ... T>
                 void Deserialize(NodeType const &node, std::tuple<T ... > &object, std::string const &name);
@@ -185,21 +381,25 @@ namespace Mif
                 template <typename T, std::size_t N>
                 void Deserialize(NodeType const &node, std::array<T, N> &object, std::string const &name);
 
+
                 //--------------------------------------------------------------------------------------------------------------------------
 
                 template <typename T>
                 inline void Serialize(std::ostream &stream, T const &object, std::string const &root)
                 {
-                    NodeType doc;
-
+                    pugi::xml_document doc;
                     Serialize(doc, object, root);
-
-                    auto const settings = boost::property_tree::xml_writer_make_settings<std::string>(
-                            '\t', 1, "utf-8");
-
-                    boost::property_tree::write_xml(stream, doc, settings);
+                    doc.save(stream, "\t", pugi::format_default, pugi::encoding_utf8);
                 }
 
+                template <typename T>
+                inline void Serialize(Common::Buffer &buffer, T const &object, std::string const &root)
+                {
+                    pugi::xml_document doc;
+                    Serialize(doc, object, root);
+                    BufferWriter writer{buffer};
+                    doc.save(writer, "\t", pugi::format_default, pugi::encoding_utf8);
+                }
 
                 template <typename TBases, std::size_t I, typename T>
                 inline typename std::enable_if<I != std::tuple_size<TBases>::value, void>::type
@@ -225,8 +425,7 @@ namespace Mif
                 {
                     using Meta = Reflection::Reflect<T>;
                     using Bases = typename Meta::Base;
-                    auto const itemName = !name.empty() ? name : Meta::Name::Value;
-                    auto &item = node.add(itemName, "");
+                    auto item = AddNode(node, !name.empty() ? name : Meta::Name::Value);
                     SerializeBase<Bases, 0>(item, object);
                     Serialize<0, Meta::Fields::Count>(item, object);
                 }
@@ -235,7 +434,7 @@ namespace Mif
                 inline typename std::enable_if<Reflection::IsReflectable<T>() && std::is_enum<T>::value, void>::type
                 Serialize(NodeType &node, T const &object, std::string const &name)
                 {
-                    node.add(name, Reflection::ToString(object));
+                    AddNode(node, name, Reflection::ToString(object).c_str());
                 }
 
                 template <typename T>
@@ -243,36 +442,63 @@ namespace Mif
                 Serialize(NodeType &node, T const &object, std::string const &name)
                 {
                     using Type = typename std::underlying_type<T>::type;
-                    node.add(name, std::to_string(static_cast<Type>(object)));
+                    AddNode(node, name, std::to_string(static_cast<Type>(object)).c_str());
                 }
 
                 template <typename T>
-                inline typename std::enable_if<Traits::IsIterable<T>(), void>::type
+                inline typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() &&
+                            !std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                        void
+                    >::type
                 Serialize(NodeType &node, T const &object, std::string const &name)
                 {
-                    auto &item = node.add(name, "");
+                    auto item = AddNode(node, name);
                     for (auto const &i : object)
                         Serialize(item, i, Tag::Item::Value);
                 }
 
+                template <typename T>
+                inline typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() &&
+                            std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                        void
+                    >::type
+                Serialize(NodeType &node, T const &object, std::string const &name)
+                {
+                    if (BlobAsBase64<T>::value)
+                    {
+                        std::string data;
+                        Common::Base64::Encode(std::begin(object), std::end(object), data);
+                        AddNode(node, name, data.c_str());
+                        return;
+                    }
+
+                    auto item = AddNode(node, name);
+                    for (auto const &i : object)
+                        Serialize(item, static_cast<int>(i), Tag::Item::Value);
+                }
+
                 template <typename T>
                 inline typename std::enable_if<Traits::IsSimple<T>() && !std::is_enum<T>::value && !std::is_same<T, std::string>::value, void>::type
                 Serialize(NodeType &node, T const &object, std::string const &name)
                 {
-                    node.add(name, std::to_string(object));
+                    AddNode(node, name, std::to_string(object).c_str());
                 }
 
                 template <typename T>
                 inline typename std::enable_if<Traits::IsSimple<T>() && std::is_same<T, std::string>::value, void>::type
                 Serialize(NodeType &node, T const &object, std::string const &name)
                 {
-                    node.add(name, object);
+                    AddNode(node, name, object.c_str());
                 }
 
                 template <typename TFirst, typename TSecond>
                 inline void Serialize(NodeType &node, std::pair<TFirst, TSecond> const &object, std::string const &name)
                 {
-                    auto &item = node.add(name, "");
+                    auto item = AddNode(node, name);
                     Serialize(item, object.first, Tag::Id::Value);
                     Serialize(item, object.second, Tag::Value::Value);
                 }
@@ -284,13 +510,13 @@ namespace Mif
                     if (object)
                         Serialize(node, *object, name);
                     else
-                        node.add(name, "");
+                        AddNode(node, name);
                 }
 
                 template <typename ... T>
                 inline void Serialize(NodeType &node, std::tuple<T ... > const &object, std::string const &name)
                 {
-                    auto item = node.add(name, "");
+                    auto item = AddNode(node, name);
                     Serialize<0, sizeof ... (T)>(item, object);
                 }
 
@@ -329,18 +555,38 @@ namespace Mif
 
                 template <typename T>
                 inline void Deserialize(std::istream &stream, T &object, std::string const &root)
+                {
+                    pugi::xml_document doc;
+                    CheckParseResult(doc.load(stream, GetParseOptions()));
+                    Deserialize(doc, object, root);
+                }
+
+                template <typename T>
+                inline void Deserialize(char const *data, std::size_t size, T &object, std::string const &root)
+                {
+                    pugi::xml_document doc;
+                    CheckParseResult(doc.load_buffer(data, size, GetParseOptions()));
+                    Deserialize(doc, object, root);
+                }
+
+                // The data is parsed in place and can't be used after.
+                template <typename T>
+                inline void DeserializeInPlace(char *data, std::size_t size, T &object, std::string const &root)
+                {
+                    pugi::xml_document doc;
+                    CheckParseResult(doc.load_buffer_inplace(data, size, GetParseOptions()));
+                    Deserialize(doc, object, root);
+                }
+
+                template <typename T>
+                inline void Deserialize(pugi::xml_document const &doc, T &object, std::string const &root)
                 {
                     {
                         T tmp;
                         std::swap(tmp, object);
                     }
 
-                    NodeType doc;
-
-                    boost::property_tree::ptree tree;
-                    boost::property_tree::xml_parser::read_xml(stream, doc);
-
-                    Deserialize(doc, object, root);
+                    Deserialize(static_cast<NodeType const &>(doc), object, root);
                 }
 
                 template <typename TBases, std::size_t I, typename T>
@@ -367,41 +613,48 @@ namespace Mif
                 {
                     using Meta = Reflection::Reflect<T>;
                     using Bases = typename Meta::Base;
-                    if (auto const item = node.get_child_optional(Meta::Name::Value))
-                    {
-                        DeserializeBase<Bases, 0>(item.get(), object);
-                        Deserialize<0, Meta::Fields::Count>(item.get(), object);
-                    }
-                    else
+                    auto item = node.child(Meta::Name::Value);
+                    if (!item)
+                        item = GetNode(node, name);
+                    if (!item)
                     {
-                        auto const itemObj = node.get_child(name);
-                        DeserializeBase<Bases, 0>(itemObj, object);
-                        Deserialize<0, Meta::Fields::Count>(itemObj, object);
+                        throw std::invalid_argument{"[Mif::Serialization::Xml::Detail::Deserialize] "
+                                "Failed to parse object. No node \"" + name + "\"."};
                     }
+                    DeserializeBase<Bases, 0>(item, object);
+                    Deserialize<0, Meta::Fields::Count>(item, object);
                 }
 
                 template <typename T>
                 inline typename std::enable_if<Reflection::IsReflectable<T>() && std::is_enum<T>::value, void>::type
                 Deserialize(NodeType const &node, T &object, std::string const &name)
                 {
-                    if (auto const value = node.get_optional<std::string>(name))
+                    if (auto const item = GetNode(node, name))
                     {
-                            object = Reflection::FromString<T>(value.get());
-                        }
-                        else
-                        {
-                            throw std::invalid_argument{"[Mif::Serialization::Xml::Detail::Deserialize] "
-                                    "Failed to parse enum value. No node \"" + name + "\"."};
-                        }
+                        object = Reflection::FromString<T>(item.child_value());
+                    }
+                    else
+                    {
+                        throw std::invalid_argument{"[Mif::Serialization::Xml::Detail::Deserialize] "
+                                "Failed to parse enum value. No node \"" + name + "\"."};
+                    }
                 }
 
                 template <typename T>
                 inline typename std::enable_if<!Reflection::IsReflectable<T>() && std::is_enum<T>::value, void>::type
                 Deserialize(NodeType const &node, T &object, std::string const &name)
                 {
-                    if (auto const value = node.get_optional<T>(name))
+                    if (auto const item = GetNode(node, name))
                     {
-                        object = value.get();
+                        using Type = typename std::conditional
+                            <
+                                std::is_signed<typename std::underlying_type<T>::type>::value,
+                                std::int64_t,
+                                std::uint64_t
+                            >::type;
+                        Type value = 0;
+                        ParseValue(item.child_value(), value, name);
+                        object = static_cast<T>(value);
                     }
                     else
                     {
@@ -429,21 +682,26 @@ namespace Mif
                 }
 
                 template <typename T>
-                inline typename std::enable_if<Traits::IsIterable<T>(), void>::type
+                inline typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() &&
+                            !std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                        void
+                    >::type
                 Deserialize(NodeType const &node, T &object, std::string const &name)
                 {
                     {
                         T tmp;
                         std::swap(tmp, object);
                     }
-                    if (auto const items = node.get_child_optional(name))
+                    if (auto const items = GetNode(node, name))
                     {
                         auto inserter = std::inserter(object, std::end(object));
-                        for (auto const &i : items.get())
+                        for (auto const &i : items.children(Tag::Item::Value))
                         {
                             using Type = typename T::value_type;
                             Type data;
-                            Deserialize(i.second, data, "");
+                            Deserialize(i, data, "");
                             *inserter = std::move(data);
                         }
                     }
@@ -454,13 +712,50 @@ namespace Mif
                     }
                 }
 
+                // An item per byte or the base64 text.
+                template <typename T>
+                inline typename std::enable_if
+                    <
+                        Traits::IsIterable<T>() &&
+                            std::is_same<typename std::decay<typename T::value_type>::type, char>::value,
+                        void
+                    >::type
+                Deserialize(NodeType const &node, T &object, std::string const &name)
+                {
+                    {
+                        T tmp;
+                        std::swap(tmp, object);
+                    }
+                    if (auto const items = GetNode(node, name))
+                    {
+                        auto inserter = std::inserter(object, std::end(object));
+                        if (!items.child(Tag::Item::Value))
+                        {
+                            auto const *data = items.child_value();
+                            Common::Base64::Decode<typename T::value_type>(data, std::strlen(data), inserter);
+                            return;
+                        }
+                        for (auto const &i : items.children(Tag::Item::Value))
+                        {
+                            int data = 0;
+                            Deserialize(i, data, "");
+                            *inserter = static_cast<typename T::value_type>(data);
+                        }
+                    }
+                    else
+                    {
+                        throw std::invalid_argument{"[Mif::Serialization::Xml::Detail::Deserialize] "
+                                "Failed to parse container. No node \"" + name + "\"."};
+                    }
+                }
+
                 template <typename T>
                 inline typename std::enable_if<Traits::IsSimple<T>() && !std::is_enum<T>::value && !std::is_same<T, std::string>::value, void>::type
                 Deserialize(NodeType const &node, T &object, std::string const &name)
                 {
-                    if (auto const item = node.get_optional<std::string>(name))
+                    if (auto const item = GetNode(node, name))
                     {
-                        std::stringstream{item.get()} >> object;
+                        ParseValue(item.child_value(), object, name);
                     }
                     else
                     {
@@ -473,9 +768,9 @@ namespace Mif
                 inline typename std::enable_if<Traits::IsSimple<T>() && std::is_same<T, std::string>::value, void>::type
                 Deserialize(NodeType const &node, T &object, std::string const &name)
                 {
-                    if (auto const item = node.get_optional<std::string>(name))
+                    if (auto const item = GetNode(node, name))
                     {
-                        object = item.get();
+                        object = item.child_value();
                     }
                     else
                     {
@@ -487,8 +782,16 @@ namespace Mif
                 template <typename TFirst, typename TSecond>
                 inline void Deserialize(NodeType const &node, std::pair<TFirst, TSecond> &object, std::string const &name)
                 {
-                    Deserialize(node, const_cast<typename std::remove_const<TFirst>::type &>(object.first), Tag::Id::Value);
-                    Deserialize(node, object.second, Tag::Value::Value);
+                    if (auto const item = GetNode(node, name))
+                    {
+                        Deserialize(item, const_cast<typename std::remove_const<TFirst>::type &>(object.first), Tag::Id::Value);
+                        Deserialize(item, object.second, Tag::Value::Value);
+                    }
+                    else
+                    {
+                        throw std::invalid_argument{"[Mif::Serialization::Xml::Detail::Deserialize] "
+                                "Failed to parse pair. No node \"" + name + "\"."};
+                    }
                 }
 
                 template <typename T>
@@ -502,25 +805,30 @@ namespace Mif
 
                 template <std::size_t I, std::size_t N, typename T>
                 inline typename std::enable_if<I != N, void>::type
-                Deserialize(NodeType &node, T &object)
+                DeserializeItems(NodeType const &item, T &object)
                 {
-                    Deserialize(node, std::get<I>(object), Tag::Item::Value);
-                    Deserialize<I + 1, N>(node, object);
+                    if (!item)
+                    {
+                        throw std::invalid_argument{"[Mif::Serialization::Xml::Detail::DeserializeItems] "
+                                "Failed to parse item " + std::to_string(I) + ". No node."};
+                    }
+                    Deserialize(item, std::get<I>(object), "");
+                    DeserializeItems<I + 1, N>(item.next_sibling(Tag::Item::Value), object);
                 }
 
                 template <std::size_t I, std::size_t N, typename T>
                 inline typename std::enable_if<I == N, void>::type
-                Deserialize(NodeType &node, T &object)
+                DeserializeItems(NodeType const &item, T &object)
                 {
-                    Common::Unused(node, object);
+                    Common::Unused(item, object);
                 }
 
                 template <typename ... T>
                 inline void Deserialize(NodeType const &node, std::tuple<T ... > &object, std::string const &name)
                 {
-                    if (auto item = node.get_child_optional(name))
+                    if (auto const item = GetNode(node, name))
                     {
-                        Deserialize<0, sizeof ... (T)>(item.get(), object);
+                        DeserializeItems<0, sizeof ... (T)>(item.child(Tag::Item::Value), object);
                     }
                     else
                     {
@@ -532,9 +840,9 @@ namespace Mif
                 template <typename T, std::size_t N>
                 inline void Deserialize(NodeType const &node, std::array<T, N> &object, std::string const &name)
                 {
-                    if (auto item = node.get_child_optional(name))
+                    if (auto const item = GetNode(node, name))
                     {
-                        Deserialize<0, N>(item.get(), object);
+                        DeserializeItems<0, N>(item.child(Tag::Item::Value), object);
                     }
                     else
                     {
@@ -555,13 +863,7 @@ namespace Mif
             inline Common::Buffer Serialize(T const &object, std::string const &root = {})
             {
                 Common::Buffer buffer;
-
-                {
-                    boost::iostreams::filtering_ostream stream{boost::iostreams::back_inserter(buffer)};
-                    Serialize(object, stream, root);
-                    stream.flush();
-                }
-
+                Detail::Serialize(buffer, object, root);
                 return buffer;
             }
 
@@ -576,11 +878,18 @@ namespace Mif
             template <typename T>
             inline T Deserialize(Common::Buffer const &buffer, std::string const &root = {})
             {
-                using SourceType = boost::iostreams::basic_array_source<char>;
-                SourceType source{!buffer.empty() ? buffer.data() : nullptr, buffer.size()};
-                boost::iostreams::stream<SourceType> stream{source};
+                T object;
+                Detail::Deserialize(buffer.data(), buffer.size(), object, root);
+                return object;
+            }
 
-                return Deserialize<T>(stream, root);
+            // The buffer is parsed in place without a copy.
+            template <typename T>
+            inline T Deserialize(Common::Buffer &&buffer, std::string const &root = {})
+            {
+                T object;
+                Detail::DeserializeInPlace(buffer.data(), buffer.size(), object, root);
+                return object;
             }
 
         }   // namespace Xml
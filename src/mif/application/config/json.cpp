@@ -94,7 +94,8 @@ namespace Mif
                                 std::back_inserter(buffer));
 
                         m_holder = std::make_shared<boost::json::value>(
-                                boost::json::parse({buffer.data(), buffer.size()}));
+                                boost::json::parse({buffer.data(), buffer.size()},
+                                        boost::json::make_shared_resource<boost::json::monotonic_resource>()));
 
                         m_root = m_holder.get();
                     }
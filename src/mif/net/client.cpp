@@ -38,9 +38,7 @@ namespace Mif
 
         void Client::OnClose()
         {
-            bool needToClose = m_makredAsClosed;
-            m_makredAsClosed = true;
-            if (needToClose)
+            if (!m_makredAsClosed.exchange(true))
                 Close();
         }
 
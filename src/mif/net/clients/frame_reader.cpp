@@ -32,29 +32,33 @@ namespace Mif
                         m_buffer.swap(buffer);
                     else
                         std::copy(std::begin(buffer), std::end(buffer), std::back_inserter(m_buffer));
-                    std::int32_t frameBytes = 0;
-                    if (m_buffer.size() < sizeof(frameBytes))
-                        return;
-                    frameBytes = *reinterpret_cast<decltype(frameBytes) const *>(m_buffer.data());
-                    boost::endian::big_to_native_inplace(frameBytes);
-                    if (m_buffer.size() < frameBytes + sizeof(frameBytes))
-                        return;
-                    Common::Buffer{}.swap(buffer);
-                    auto begin = std::begin(m_buffer);
-                    std::advance(begin, sizeof(frameBytes));
-                    auto end = begin;
-                    std::advance(end, frameBytes);
-                    buffer.assign(begin, end);
-                    if (end == std::end(m_buffer))
+                    // A single read may contain several frames.
+                    for (;;)
                     {
-                        Common::Buffer{}.swap(m_buffer);
+                        std::int32_t frameBytes = 0;
+                        if (m_buffer.size() < sizeof(frameBytes))
+                            return;
+                        frameBytes = *reinterpret_cast<decltype(frameBytes) const *>(m_buffer.data());
+                        boost::endian::big_to_native_inplace(frameBytes);
+                        if (m_buffer.size() < frameBytes + sizeof(frameBytes))
+                            return;
+                        Common::Buffer{}.swap(buffer);
+                        auto begin = std::begin(m_buffer);
+                        std::advance(begin, sizeof(frameBytes));
+                        auto end = begin;
+                        std::advance(end, frameBytes);
+                        buffer.assign(begin, end);
+                        if (end == std::end(m_buffer))
+                        {
+                            Common::Buffer{}.swap(m_buffer);
+                        }
+                        else
+                        {
+                            Common::Buffer newBuffer{end, std::end(m_buffer)};
+                            m_buffer.swap(newBuffer);
+                        }
+                        owner.Post(std::move(buffer));
                     }
-                    else
-                    {
-                        Common::Buffer newBuffer{end, std::end(m_buffer)};
-                        m_buffer.swap(newBuffer);
-                    }
-                    owner.Post(std::move(buffer));
                 }
 
             private:
@@ -6,10 +6,14 @@
 //-------------------------------------------------------------------
 
 // STD
+#include <algorithm>
 #include <cstdlib>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <thread>
 #include <utility>
+#include <vector>
 
 // BOOST
 #include <boost/asio.hpp>
@@ -65,6 +69,11 @@ namespace Mif
                 ~Impl()
                 try
                 {
+                    // The clients can outlive the sessions (e.g. while a call is made on another
+                    // thread), so they are closed before the stop in order to finish their work
+                    // while the io_service is alive.
+                    CloseSessions();
+
                     m_ioService.post([this] ()
                             {
                                 try
@@ -98,7 +107,10 @@ namespace Mif
                         boost::asio::ip::tcp::socket socket{m_ioService};
                         boost::asio::ip::tcp::resolver resolver{m_ioService};
                         boost::asio::connect(socket, resolver.resolve({host, port}));
-                        return std::make_shared<Detail::Session>(std::move(socket), *m_factory)->Start();
+                        auto session = std::make_shared<Detail::Session>(std::move(socket), *m_factory);
+                        auto client = session->Start();
+                        AddSession(session);
+                        return client;
                     }
                     catch (std::exception const &e)
                     {
@@ -108,10 +120,44 @@ namespace Mif
                 }
 
             private:
+                using LockType = std::mutex;
+                using LockGuard = std::lock_guard<LockType>;
+
+                using SessionPtr = std::weak_ptr<Detail::Session>;
+                using Sessions = std::vector<SessionPtr>;
+
+                LockType m_lock;
+                Sessions m_sessions;
+
                 std::shared_ptr<IClientFactory> m_factory;
                 boost::asio::io_service m_ioService;
                 std::unique_ptr<std::thread> m_thread;
                 boost::asio::io_service::work m_work;
+
+                void AddSession(SessionPtr session)
+                {
+                    LockGuard lock{m_lock};
+                    m_sessions.erase(std::remove_if(std::begin(m_sessions), std::end(m_sessions),
+                            [] (SessionPtr const &i) { return i.expired(); }),
+                            std::end(m_sessions));
+                    m_sessions.push_back(std::move(session));
+                }
+
+                void CloseSessions()
+                {
+                    Sessions sessions;
+
+                    {
+                        LockGuard lock{m_lock};
+                        sessions.swap(m_sessions);
+                    }
+
+                    for (auto const &i : sessions)
+                    {
+                        if (auto session = i.lock())
+                            static_cast<IControl &>(*session).CloseMe();
+                    }
+                }
             };
 
 